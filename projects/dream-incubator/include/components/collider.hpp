@@ -0,0 +1,89 @@
+/**
+@file    collider.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the Collider component.
+
+*//*__________________________________________________________________________*/
+
+#ifndef COLLIDER_COMP_HPP
+#define COLLIDER_COMP_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <string>
+#include <math.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+// order decides which half of the narrow phase table is specialized, see narrowphase.hpp
+enum SHAPE_TYPE : int
+{
+	SHAPE_POINT,
+	SHAPE_RAY,
+	SHAPE_PLANE,
+	SHAPE_TRIANGLE,
+	SHAPE_SPHERE,
+	SHAPE_AABB,
+	SHAPE_MESH,
+	SHAPE_TYPE_TOTAL
+};
+
+/**
+ * @struct Collider
+ * @brief This struct holds the shape type of an entity's mesh and its world
+ * space data, refreshed by the Collision system once per frame so pair tests
+ * do not touch the transform.
+ */
+struct Collider
+{
+	SHAPE_TYPE type{ SHAPE_AABB };
+	vec3 center{ vec3(0) }; ///< point position, ray start, sphere and aabb center
+	vec3 dir{ vec3(0) }; ///< ray direction, plane normal
+	float d{ 0.f }; ///< plane distance from origin
+	float radius{ 0.f }; ///< sphere
+	vec3 halfExtents{ vec3(0) }; ///< aabb, also world aabb of mesh
+	vec3 tri[3]; ///< triangle vertices
+	bool isContinuous{ false }; ///< sweep motion between frames so fast movers cannot tunnel, shown in inspector
+	bool hasHistory{ false }; ///< center of last frame is valid
+	vec3 motion{ vec3(0) }; ///< displacement of center since last frame, only tracked if continuous
+	float toi{ -1.f }; ///< earliest time of impact this frame in [0, 1], -1 if none
+	vec3 boundsMin{ vec3(0) }; ///< world aabb swept over motion, for broad phase, unused by ray and plane
+	vec3 boundsMax{ vec3(0) };
+
+	vec3 GetMin() const { return center - halfExtents; };
+	vec3 GetMax() const { return center + halfExtents; };
+};
+
+/**
+ * @brief shape type of a mesh type name
+ */
+static SHAPE_TYPE ToShapeType(std::string const& _mesh)
+{
+	if (_mesh.find(".obj") != std::string::npos) { return SHAPE_MESH; }
+	if (_mesh == "Point3D")		{ return SHAPE_POINT; }
+	if (_mesh == "Ray")			{ return SHAPE_RAY; }
+	if (_mesh == "Plane")		{ return SHAPE_PLANE; }
+	if (_mesh == "Triangle")	{ return SHAPE_TRIANGLE; }
+	if (_mesh == "Sphere")		{ return SHAPE_SPHERE; }
+	return SHAPE_AABB;
+}
+
+static std::string to_string(SHAPE_TYPE _type)
+{
+	switch (_type)
+	{
+	case SHAPE_POINT:		return "Point";
+	case SHAPE_RAY:			return "Ray";
+	case SHAPE_PLANE:		return "Plane";
+	case SHAPE_TRIANGLE:	return "Triangle";
+	case SHAPE_SPHERE:		return "Sphere";
+	case SHAPE_AABB:		return "AABB";
+	case SHAPE_MESH:		return "Mesh";
+	default: break;
+	}
+	return "";
+}
+
+#endif /* COLLIDER_COMP_HPP */
@@ -15,6 +15,7 @@ for generating core primitive geometries and loading models using assimp.
 
 #include <memory>
 #include <graphics/buffer.hpp>
+#include <cs350/meshoptimize.hpp>
     #include <assimp/Importer.hpp> // TODO: remove after load obj class 
     #include <assimp/scene.h>          
     #include <assimp/postprocess.h> 
@@ -34,24 +35,28 @@ public:
      * @brief ctor, initialize the renderable object (shaders, buffers, etc.).
      * @param _meshType - mesh type to be rendered
      */
-    Renderable(std::string _meshType = "AABB") : m_IsHidden(false), m_IsWireframe(false), m_MeshType(_meshType) { };
+    Renderable(std::string _meshType = "AABB") : m_IsHidden(false), m_IsWireframe(false), m_IsOccluder(false), m_MeshType(_meshType) { };
     ~Renderable() { };
 
     void SetMeshType(std::string _meshType) { m_MeshType = _meshType; }
     std::string GetMeshType() { return m_MeshType; }
     bool& GetIsWireframe() { return m_IsWireframe; }
     bool& GetIsHidden() { return m_IsHidden; }
+    bool& GetIsOccluder() { return m_IsOccluder; }
 
     static std::unordered_map<std::string, std::vector<std::unique_ptr<Buffer>>>& GetBuffers() { return s_Buffers; }
+    static std::unordered_map<std::string, uint64_t>& GetContentKeys() { return s_ContentKeys; }
     static uint32_t& GetShaderPgm() { return s_ProgramID; }
 
 private:
 
     bool m_IsHidden; ///< should mesh render 
     bool m_IsWireframe; ///< should mesh render in wireframe
+    bool m_IsOccluder; ///< should mesh be rasterized into the occlusion buffer
     std::string m_MeshType; ///< if mesh is from .obj file
     static uint32_t s_ProgramID; ///< ID of the compiled shader program
     static std::unordered_map<std::string, std::vector<std::unique_ptr<Buffer>>> s_Buffers; ///< buffer objects of different meshes
+    static std::unordered_map<std::string, uint64_t> s_ContentKeys; ///< key of the file each imported mesh was loaded from
 };
 
 
@@ -217,7 +222,19 @@ GenerateAABB_8vtxGeometry(vec4 _clr)
   * Helper functions to load meshes 
   */
 
-static void ProcessNode(aiNode* _node, aiScene const* _scene)
+/**
+ * @struct ImportedMesh
+ * @brief This struct holds a mesh read from a model before it is uploaded
+ */
+struct ImportedMesh
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    bool isTriangles; ///< every face has 3 indices, only these are optimised
+    MeshOptimizeStats stats;
+};
+
+static void ProcessNode(aiNode* _node, aiScene const* _scene, std::vector<ImportedMesh>& _meshes)
 {
     for (unsigned i = 0; i < _node->mNumMeshes; ++i)
     {
@@ -254,11 +271,12 @@ static void ProcessNode(aiNode* _node, aiScene const* _scene)
                 idx.push_back(face.mIndices[j]);
             }
         }
-        Renderable::GetBuffers()[_scene->mRootNode->mName.C_Str()].push_back(std::make_unique<Buffer>(vtx, static_cast<Buffer::PRIMITIVE_TYPE>(Buffer::PRIMITIVE_TYPE::TRIANGLES/*mesh->mPrimitiveTypes*/), true, &idx));
+        // faces are in source order, Render::Init() optimises them before upload
+        _meshes.push_back({ std::move(vtx), std::move(idx), mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE, {} });
     }
 
     for (unsigned i = 0; i < _node->mNumChildren; ++i) 
-    { ProcessNode(_node->mChildren[i], _scene); }
+    { ProcessNode(_node->mChildren[i], _scene, _meshes); }
 }
 
 /**
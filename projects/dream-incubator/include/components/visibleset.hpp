@@ -0,0 +1,51 @@
+/**
+@file    visibleset.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the VisibleSet component.
+
+*//*__________________________________________________________________________*/
+
+#ifndef VISIBLE_SET_COMP_HPP
+#define VISIBLE_SET_COMP_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <ecs.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+struct BoundingVolume;
+
+/**
+ * @struct VisibleSet
+ * @brief This struct holds what a camera can see this frame. It is written by
+ * the Culling system and Render draws from it instead of every entity.
+ */
+struct VisibleSet
+{
+    std::vector<entt::entity> meshes; ///< entities with a shown mesh not outside the frustum or occluded, in view order
+    std::vector<float> screenSizes; ///< projected bounding sphere diameter in pixels of each mesh, parallel to meshes
+    std::vector<uint32_t> proxies; ///< index into Hlod::GetProxies() of each proxy drawn in place of its meshes
+    std::vector<std::pair<entt::entity, BoundingVolume*>> bvs; ///< active bounding volumes not outside the frustum
+    unsigned numFrustumTests{ 0 }; ///< bounding volumes classified against all planes this frame
+    unsigned numPlaneCacheHits{ 0 }; ///< bounding volumes still outside the plane that rejected them last frame
+    unsigned numInProxies{ 0 }; ///< shown meshes drawn by a proxy
+    unsigned numOutside{ 0 }; ///< shown meshes outside the frustum
+    unsigned numTooSmall{ 0 }; ///< meshes inside the frustum under the contribution threshold
+    unsigned numDemoted{ 0 }; ///< meshes drawn as their bounds, under the detail threshold
+    unsigned numTested{ 0 }; ///< meshes left after frustum and contribution culling tested against occluders
+    unsigned numOccluded{ 0 }; ///< meshes of those hidden behind occluders
+    unsigned numOccluderTriangles{ 0 }; ///< triangles rasterized into the occlusion buffer
+    unsigned numTriangles{ 0 }; ///< triangles drawn for meshes, written by Render
+    unsigned numFullTriangles{ 0 }; ///< triangles the same meshes have at lod 0, written by Render
+    unsigned numProxyTriangles{ 0 }; ///< triangles drawn for proxies, written by Render
+    unsigned numDrawCalls{ 0 }; ///< draw calls this viewport, written by Render
+    unsigned numStateChanges{ 0 }; ///< polygon mode, program and vao changes this viewport, written by Render
+
+    float GetOccludedFraction() const { return numTested ? static_cast<float>(numOccluded) / numTested : 0.f; }
+};
+
+#endif /* VISIBLE_SET_COMP_HPP */
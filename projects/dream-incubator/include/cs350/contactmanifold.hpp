@@ -0,0 +1,138 @@
+/**
+@file    contactmanifold.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of contact manifolds and the contact
+generation functions of primitive pairs.
+
+*//*__________________________________________________________________________*/
+
+#ifndef CONTACT_MANIFOLD_HPP
+#define CONTACT_MANIFOLD_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <cstdint>
+#include <math.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+constexpr int MAX_MANIFOLD_POINTS = 4;
+constexpr float CONTACT_MATCH_DISTANCE = 0.05f; // points closer than this across frames are the same contact
+
+/**
+ * @struct ContactPoint
+ * @brief This struct holds one point of contact between 2 shapes
+ */
+struct ContactPoint
+{
+	vec3 position{ vec3(0) }; // in world, halfway between both surfaces
+	float depth{ 0.f }; // penetration along manifold normal, 0 if touching
+	uint32_t age{ 0 }; // frames this point has been matched to a point of last frame
+};
+
+/**
+ * @struct ContactManifold
+ * @brief This struct holds the contact points of an intersecting pair, all
+ * sharing one normal. Moving B along the normal by a point's depth separates
+ * the shapes at that point.
+ */
+struct ContactManifold
+{
+	vec3 normal{ vec3(0) }; // unit, from A towards B
+	ContactPoint points[MAX_MANIFOLD_POINTS];
+	int count{ 0 };
+
+	/**
+	  * @brief appends a point, ignored if manifold is full
+	  */
+	void AddPoint(vec3 const& _position, float _depth);
+	/**
+	  * @brief swaps A and B
+	  */
+	void Flip() { normal = -normal; }
+	float GetMaxDepth() const;
+};
+
+/**
+ * @brief carries over ages of points that match a point of last frame's
+ * manifold, points match if they are within CONTACT_MATCH_DISTANCE
+ * @param _old - manifold of last frame
+ * @param _new - manifold of this frame, updated
+ */
+void MatchContacts(ContactManifold const& _old, ContactManifold& _new);
+
+/**
+ * @brief contact of sphere A and sphere B
+ * @param _c1 - center of sphere A
+ * @param _r1 - radius of sphere A
+ * @param _c2 - center of sphere B
+ * @param _r2 - radius of sphere B
+ * @param _manifold - 1 point, cleared first
+ * @return true if spheres are intersecting
+ */
+bool ContactSphereSphere(vec3 const& _c1, float _r1, vec3 const& _c2, float _r2, ContactManifold& _manifold);
+/**
+ * @brief contact of sphere A and AABB B
+ * @param _c - center of sphere
+ * @param _r - radius of sphere
+ * @param _min - min of AABB
+ * @param _max - max of AABB
+ * @param _manifold - 1 point, cleared first
+ * @return true if sphere and AABB are intersecting
+ */
+bool ContactSphereAabb(vec3 const& _c, float _r, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold);
+/**
+ * @brief contact of AABB A and AABB B, normal is the axis of least overlap and
+ * points are the corners of the overlap on the other 2 axes
+ * @param _min1 - min of AABB A
+ * @param _max1 - max of AABB A
+ * @param _min2 - min of AABB B
+ * @param _max2 - max of AABB B
+ * @param _manifold - up to 4 points, cleared first
+ * @return true if AABBs are intersecting
+ */
+bool ContactAabbAabb(vec3 const& _min1, vec3 const& _max1, vec3 const& _min2, vec3 const& _max2, ContactManifold& _manifold);
+/**
+ * @brief contact of point A and sphere B
+ * @param _p - position of point
+ * @param _c - center of sphere
+ * @param _r - radius of sphere
+ * @param _manifold - 1 point, cleared first
+ * @return true if point is in sphere
+ */
+bool ContactPointSphere(vec3 const& _p, vec3 const& _c, float _r, ContactManifold& _manifold);
+/**
+ * @brief contact of point A and AABB B, the point leaves through the nearest face
+ * @param _p - position of point
+ * @param _min - min of AABB
+ * @param _max - max of AABB
+ * @param _manifold - 1 point, cleared first
+ * @return true if point is in AABB
+ */
+bool ContactPointAabb(vec3 const& _p, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold);
+/**
+ * @brief contact of plane A and sphere B, plane is 2 sided so normal is
+ * towards the side the sphere center is on
+ * @param _n - normal of plane
+ * @param _d - distance of plane from origin
+ * @param _c - center of sphere
+ * @param _r - radius of sphere
+ * @param _manifold - 1 point, cleared first
+ * @return true if plane and sphere are intersecting
+ */
+bool ContactPlaneSphere(vec3 const& _n, float _d, vec3 const& _c, float _r, ContactManifold& _manifold);
+/**
+ * @brief contact of plane A and AABB B, points are the deepest corners on the
+ * far side of the plane from the AABB center
+ * @param _n - normal of plane
+ * @param _d - distance of plane from origin
+ * @param _min - min of AABB
+ * @param _max - max of AABB
+ * @param _manifold - up to 4 points, cleared first
+ * @return true if plane and AABB are intersecting
+ */
+bool ContactPlaneAabb(vec3 const& _n, float _d, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold);
+
+#endif /* CONTACT_MANIFOLD_HPP */
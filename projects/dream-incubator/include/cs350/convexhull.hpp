@@ -0,0 +1,57 @@
+/**
+@file    convexhull.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the ConvexHull struct and Quickhull.
+
+*//*__________________________________________________________________________*/
+
+#ifndef CONVEX_HULL_HPP
+#define CONVEX_HULL_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <math.hpp>
+#include <graphics/buffer.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct ConvexHull
+ * @brief This struct holds the convex hull of a mesh in model space
+ */
+struct ConvexHull
+{
+	std::vector<vec3> vertices;
+	std::vector<unsigned> indices; // triangles, counter clockwise seen from outside
+
+	/**
+	  * @brief hulls of loaded meshes, generated once at load
+	  */
+	static std::unordered_map<std::string, ConvexHull>& GetHulls() { return s_Hulls; }
+
+private:
+
+	static std::unordered_map<std::string, ConvexHull> s_Hulls;
+};
+
+/**
+ * @brief builds convex hull of points with Quickhull. Degenerate (flat, 
+ * collinear) input returns its extreme points without faces, which is still
+ * enough for support function queries.
+ * @param _points - points to build hull of
+ * @return convex hull
+ */
+ConvexHull CreateConvexHullQuickhull(std::vector<vec3> const& _points);
+/**
+ * @brief builds convex hull of vertex positions with Quickhull
+ * @param _vertices - vertices of mesh
+ * @return convex hull
+ */
+ConvexHull CreateConvexHullQuickhull(std::vector<Vertex> const& _vertices);
+
+#endif /* CONVEX_HULL_HPP */
@@ -0,0 +1,144 @@
+/**
+@file    gjk.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of convex shapes, GJK distance/overlap
+queries and EPA penetration depth.
+
+*//*__________________________________________________________________________*/
+
+#ifndef GJK_HPP
+#define GJK_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <math.hpp>
+#include <cs350/convexhull.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+enum CONVEX_SHAPE_TYPE
+{
+	CONVEX_POINT,
+	CONVEX_SPHERE,
+	CONVEX_OBB,
+	CONVEX_HULL,
+	CONVEX_SHAPE_TYPE_TOTAL
+};
+
+/**
+ * @struct ConvexShape
+ * @brief This struct describes a convex shape in world space by its support
+ * function. Only the fields of its type are used.
+ */
+struct ConvexShape
+{
+	CONVEX_SHAPE_TYPE type{ CONVEX_POINT };
+	vec3 center{ vec3(0) }; // point, sphere and obb
+	float radius{ 0.f }; // sphere
+	vec3 halfExtents{ vec3(0) }; // obb
+	vec3 axes[3]{ vec3(1,0,0), vec3(0,1,0), vec3(0,0,1) }; // obb
+	ConvexHull const* hull{ nullptr }; // hull, in model space
+	mat4 modelMtx{ mat4(1.f) }; // hull, model to world
+};
+
+/**
+ * @struct GjkCache
+ * @brief This struct holds the search directions of the last simplex of a pair.
+ * Passing the same cache next frame seeds GJK with supports along them, so a
+ * pair that barely moved converges in one or two iterations.
+ */
+struct GjkCache
+{
+	vec3 dirs[4];
+	int count{ 0 };
+};
+
+/**
+ * @struct GjkResult
+ * @brief This struct holds the result of a GJK distance query
+ */
+struct GjkResult
+{
+	bool isOverlapping{ false };
+	float distance{ 0.f }; // 0 if overlapping
+	vec3 pointA{ vec3(0) }; // closest point on A, deepest point if EPA ran
+	vec3 pointB{ vec3(0) }; // closest point on B, deepest point if EPA ran
+	vec3 normal{ vec3(0) }; // unit, from A towards B
+	float depth{ 0.f }; // penetration depth, only set by EPA
+	int iterations{ 0 }; // GJK iterations, for profiling warm starting
+};
+
+/**
+ * @brief makes point shape
+ * @param _p - position in world
+ */
+ConvexShape MakeConvexPoint(vec3 const& _p);
+/**
+ * @brief makes sphere shape
+ * @param _c - center in world
+ * @param _r - radius
+ */
+ConvexShape MakeConvexSphere(vec3 const& _c, float _r);
+/**
+ * @brief makes obb shape
+ * @param _c - center in world
+ * @param _halfExtents - half extents along each axis
+ * @param _axes - unit axes in world
+ */
+ConvexShape MakeConvexObb(vec3 const& _c, vec3 const& _halfExtents, vec3 const _axes[3]);
+/**
+ * @brief makes hull shape, hull is referenced and must outlive the shape
+ * @param _hull - hull in model space
+ * @param _modelMtx - model to world, may be non uniformly scaled
+ */
+ConvexShape MakeConvexHull(ConvexHull const& _hull, mat4 const& _modelMtx);
+/**
+ * @brief returns shape moved by offset
+ * @param _shape - shape
+ * @param _offset - translation in world
+ */
+ConvexShape TranslateConvex(ConvexShape const& _shape, vec3 const& _offset);
+/**
+ * @brief support function, furthest point of shape along direction
+ * @param _shape - shape
+ * @param _dir - direction, need not be normalized
+ * @return point in world
+ */
+vec3 ConvexSupport(ConvexShape const& _shape, vec3 const& _dir);
+
+/**
+ * @brief GJK distance between 2 convex shapes, optionally with EPA
+ * penetration depth when they overlap
+ * @param _a - shape A
+ * @param _b - shape B
+ * @param _cache - simplex of last query of this pair, updated, may be null
+ * @param _computePenetration - runs EPA if overlapping
+ * @return distance, closest points and normal, or depth if EPA ran
+ */
+GjkResult GjkDistance(ConvexShape const& _a, ConvexShape const& _b, GjkCache* _cache = nullptr, bool _computePenetration = false);
+/**
+ * @brief GJK boolean overlap test, stops as soon as a separating axis is found
+ * @param _a - shape A
+ * @param _b - shape B
+ * @param _cache - simplex of last query of this pair, updated, may be null
+ * @return true if shapes are intersecting
+ */
+bool GjkOverlap(ConvexShape const& _a, ConvexShape const& _b, GjkCache* _cache = nullptr);
+
+/**
+ * @brief time of impact of 2 translating convex shapes by conservative
+ * advancement, each step moves forward by the GJK distance over the closing
+ * speed along the separating normal so the shapes can never pass through
+ * each other between steps
+ * @param _a - shape A at start of motion
+ * @param _motionA - displacement of A over the frame
+ * @param _b - shape B at start of motion
+ * @param _motionB - displacement of B over the frame
+ * @param _tolerance - distance treated as contact
+ * @return time of impact in [0, 1], 0 if overlapping at start, -1 if no contact
+ */
+float GjkTimeOfImpact(ConvexShape const& _a, vec3 const& _motionA, ConvexShape const& _b, vec3 const& _motionB, float _tolerance = 1e-3f);
+
+#endif /* GJK_HPP */
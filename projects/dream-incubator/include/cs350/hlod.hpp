@@ -0,0 +1,109 @@
+/**
+@file    hlod.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the Hlod class, merged and simplified
+proxy meshes of octree cells drawn in place of the meshes in them.
+
+*//*__________________________________________________________________________*/
+
+#ifndef HLOD_HPP
+#define HLOD_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <ecs.hpp>
+#include <graphics/buffer.hpp>
+#include <cs350/octree.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static float constexpr HLOD_MIN_CELL_FRACTION = 0.125f; // cells smaller than this fraction of the root get no proxy
+static size_t constexpr HLOD_MIN_MESHES = 2; // cells with fewer meshes get no proxy, mesh lods cover them
+static uint32_t constexpr HLOD_MAX_TRIANGLES = 16384; // per proxy
+static float constexpr HLOD_MIN_PART_FRACTION = 1.f / 32.f; // meshes smaller than this fraction of the cell are left out
+static float constexpr HLOD_MAX_ERROR_FRACTION = 0.1f; // simplification stops at this fraction of the cell
+static char constexpr HLOD_CACHE_DIR[] = "../hlodcache/";
+
+/**
+ * @struct HlodNode
+ * @brief This struct holds an octree cell that may have a proxy, its children
+ * are the cells under it that may have one too
+ */
+struct HlodNode
+{
+	vec3 min, max; // bounds of proxy, or of cell if it has none
+	int32_t proxy{ -1 }; // index into Hlod::GetProxies()
+	std::vector<uint32_t> children; // index into Hlod::GetNodes()
+};
+
+/**
+ * @struct HlodProxy
+ * @brief This struct holds the merged mesh of every mesh in a cell, in world
+ * space, drawn with the average material of those meshes
+ */
+struct HlodProxy
+{
+	std::shared_ptr<Buffer> buffer;
+	float error; // max distance to the meshes it replaces in world space
+	vec3 center; // of bounds
+	std::vector<entity> entities; // meshes it replaces
+	vec3 kAmbient, kDiffuse, kSpecular;
+	float shininess;
+	bool isValid{ true }; // false once one of its meshes moved
+};
+
+/**
+ * @class Hlod
+ * @brief This class builds hierarchical lod proxies over the cells of an
+ * octree. Cells are built deepest first, in parallel within a level, and each
+ * parent is merged from the proxies of its children so no proxy simplifies
+ * more than a few children. Proxies are cached in memory across rebuilds and
+ * on disk across runs, keyed by the meshes and transforms in the cell.
+ */
+class Hlod
+{
+
+public:
+
+	/**
+	  * @brief builds proxies for every cell large enough, replaces the ones
+	  * built before
+	  * @param _root - root of octree
+	  * @param _isGenerating - cells not cached in memory or on disk are
+	  * simplified, else they are left without a proxy
+	  */
+	static void Build(OctTreeNode const& _root, bool _isGenerating);
+	static void Clear() { s_Nodes.clear(); s_Proxies.clear(); s_EntityProxies.clear(); }
+	static void Release() { Clear(); s_Cache.clear(); } // frees every proxy mesh, cached ones too
+	/**
+	  * @brief marks every proxy with a mesh that moved as invalid
+	  */
+	static void InvalidateProxies(entity _ent);
+
+	static std::vector<HlodNode> const& GetNodes() { return s_Nodes; } // node 0 is root, empty if nothing built
+	static std::vector<HlodProxy> const& GetProxies() { return s_Proxies; }
+
+private:
+
+	/**
+	 * @struct CacheEntry
+	 * @brief This struct holds a proxy mesh uploaded by an earlier build
+	 */
+	struct CacheEntry
+	{
+		std::shared_ptr<Buffer> buffer;
+		float error;
+	};
+
+	static std::vector<HlodNode> s_Nodes;
+	static std::vector<HlodProxy> s_Proxies;
+	static std::vector<std::vector<uint32_t>> s_EntityProxies; // by entity index, proxies a mesh is in
+	static std::unordered_map<uint64_t, CacheEntry> s_Cache; // by key of cell
+};
+
+#endif /* HLOD_HPP */
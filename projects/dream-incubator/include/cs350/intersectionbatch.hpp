@@ -0,0 +1,242 @@
+/**
+@file    intersectionbatch.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration for batch intersection test functions, which
+test one ray/sphere/AABB/plane against N primitives stored as structure of arrays.
+The fastest instruction set supported by the CPU (AVX2, SSE4.1 or scalar) is 
+picked at runtime, all of them give bit identical results.
+
+*//*__________________________________________________________________________*/
+
+#ifndef INTERSECTION_BATCH_HPP
+#define INTERSECTION_BATCH_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <math.hpp>
+#include <cs350/intersectiontests.hpp>
+#include <cs350/intersectionbatchkernels.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+enum BATCH_ISA
+{
+	BATCH_ISA_SCALAR,
+	BATCH_ISA_SSE4,
+	BATCH_ISA_AVX2,
+	BATCH_ISA_TOTAL,
+};
+
+/**
+ * @struct AabbSoA
+ * @brief This struct holds AABBs as structure of arrays for batch tests
+ */
+struct AabbSoA
+{
+	std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+	void Clear() { minX.clear(); minY.clear(); minZ.clear(); maxX.clear(); maxY.clear(); maxZ.clear(); }
+	void Reserve(size_t _n) { minX.reserve(_n); minY.reserve(_n); minZ.reserve(_n); maxX.reserve(_n); maxY.reserve(_n); maxZ.reserve(_n); }
+	void PushBack(vec3 const& _min, vec3 const& _max)
+	{
+		minX.push_back(_min.x); minY.push_back(_min.y); minZ.push_back(_min.z);
+		maxX.push_back(_max.x); maxY.push_back(_max.y); maxZ.push_back(_max.z);
+	}
+	unsigned Size() const { return static_cast<unsigned>(minX.size()); }
+	AabbSoAView View() const { return { minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(), Size() }; }
+};
+
+/**
+ * @struct SphereSoA
+ * @brief This struct holds spheres as structure of arrays for batch tests
+ */
+struct SphereSoA
+{
+	std::vector<float> x, y, z, r;
+
+	void Clear() { x.clear(); y.clear(); z.clear(); r.clear(); }
+	void Reserve(size_t _n) { x.reserve(_n); y.reserve(_n); z.reserve(_n); r.reserve(_n); }
+	void PushBack(vec3 const& _c, float _r) { x.push_back(_c.x); y.push_back(_c.y); z.push_back(_c.z); r.push_back(_r); }
+	unsigned Size() const { return static_cast<unsigned>(x.size()); }
+	SphereSoAView View() const { return { x.data(), y.data(), z.data(), r.data(), Size() }; }
+};
+
+/**
+ * @struct TriangleSoA
+ * @brief This struct holds triangles as structure of arrays for batch tests
+ */
+struct TriangleSoA
+{
+	std::vector<float> ax, ay, az, bx, by, bz, cx, cy, cz;
+
+	void Clear() { for (auto* v : { &ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz }) { v->clear(); } }
+	void Reserve(size_t _n) { for (auto* v : { &ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz }) { v->reserve(_n); } }
+	void PushBack(vec3 const& _A, vec3 const& _B, vec3 const& _C)
+	{
+		ax.push_back(_A.x); ay.push_back(_A.y); az.push_back(_A.z);
+		bx.push_back(_B.x); by.push_back(_B.y); bz.push_back(_B.z);
+		cx.push_back(_C.x); cy.push_back(_C.y); cz.push_back(_C.z);
+	}
+	unsigned Size() const { return static_cast<unsigned>(ax.size()); }
+	TriangleSoAView View() const { return { ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), cx.data(), cy.data(), cz.data(), Size() }; }
+};
+
+/**
+ * @struct ObbSoA
+ * @brief This struct holds OBBs as structure of arrays for batch tests
+ */
+struct ObbSoA
+{
+	std::vector<float> c[3], e[3], u[3][3]; // center, half extents, axes u[axis][component]
+
+	void Clear() { for (int i = 0; i < 3; ++i) { c[i].clear(); e[i].clear(); for (auto& v : u[i]) { v.clear(); } } }
+	void Reserve(size_t _n) { for (int i = 0; i < 3; ++i) { c[i].reserve(_n); e[i].reserve(_n); for (auto& v : u[i]) { v.reserve(_n); } } }
+	void PushBack(vec3 const& _c, vec3 const& _e, vec3 const* _u)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			c[i].push_back(_c[i]); e[i].push_back(_e[i]);
+			for (int j = 0; j < 3; ++j) { u[i][j].push_back(_u[i][j]); }
+		}
+	}
+	unsigned Size() const { return static_cast<unsigned>(c[0].size()); }
+	ObbSoAView View() const
+	{
+		ObbSoAView view{};
+		for (int i = 0; i < 3; ++i)
+		{
+			view.c[i] = c[i].data(); view.e[i] = e[i].data();
+			for (int j = 0; j < 3; ++j) { view.u[i][j] = u[i][j].data(); }
+		}
+		view.count = Size();
+		return view;
+	}
+};
+
+/**
+ * Unlike the single tests in intersectiontests.hpp, batch tests do not check for
+ * NaN, NaN inputs are reported as no intersection / OUTSIDE. Plane normals must 
+ * be normalized by the caller. Output buffers must hold one result per primitive.
+ */
+
+/**
+ * @brief Checks Ray vs N AABBs intersection
+ * @param _s - start position of ray
+ * @param _dir - direction of ray
+ * @param _aabbs - AABBs to test
+ * @param _outT - per AABB: -1 if missed, 0 if ray starts inside, else entry time
+ */
+void IntersectionTimeRayAabbBatch(vec3 const& _s, vec3 const& _dir, AabbSoA const& _aabbs, float* _outT);
+/**
+ * @brief Checks Ray vs N spheres intersection
+ * @param _s - start position of ray
+ * @param _dir - direction of ray
+ * @param _spheres - spheres to test
+ * @param _outT - per sphere: -1 if missed, 0 if ray starts inside, else entry time
+ */
+void IntersectionTimeRaySphereBatch(vec3 const& _s, vec3 const& _dir, SphereSoA const& _spheres, float* _outT);
+/**
+ * @brief Checks Ray vs N triangles intersection (Moller-Trumbore), use 
+ * IntersectionTimeRayTriangle() on the chosen hit for barycentric coordinates
+ * @param _s - start position of ray
+ * @param _dir - direction of ray
+ * @param _tris - triangles to test
+ * @param _outT - per triangle: -1 if missed, else hit time
+ */
+void IntersectionTimeRayTriangleBatch(vec3 const& _s, vec3 const& _dir, TriangleSoA const& _tris, float* _outT);
+/**
+ * @brief Checks Sphere vs N AABBs intersection
+ * @param _c - center of sphere
+ * @param _r - radius of sphere
+ * @param _aabbs - AABBs to test
+ * @param _out - per AABB: 1 if intersecting else 0
+ */
+void OverlapSphereAabbBatch(vec3 const& _c, float _r, AabbSoA const& _aabbs, uint8_t* _out);
+/**
+ * @brief Checks Sphere vs N spheres intersection
+ * @param _c - center of sphere
+ * @param _r - radius of sphere
+ * @param _spheres - spheres to test
+ * @param _out - per sphere: 1 if intersecting else 0
+ */
+void OverlapSphereSphereBatch(vec3 const& _c, float _r, SphereSoA const& _spheres, uint8_t* _out);
+/**
+ * @brief Checks AABB vs N AABBs intersection
+ * @param _min - min of AABB
+ * @param _max - max of AABB
+ * @param _aabbs - AABBs to test
+ * @param _out - per AABB: 1 if intersecting else 0
+ */
+void OverlapAabbAabbBatch(vec3 const& _min, vec3 const& _max, AabbSoA const& _aabbs, uint8_t* _out);
+/**
+ * @brief Checks Plane vs N AABBs
+ * @param _n - normalized normal of plane
+ * @param _d - d of plane eqn
+ * @param _aabbs - AABBs to test
+ * @param _out - per AABB: SIDE_RESULT
+ */
+void ClassifyPlaneAabbBatch(vec3 const& _n, float _d, AabbSoA const& _aabbs, int8_t* _out);
+/**
+ * @brief Checks Plane vs N spheres
+ * @param _n - normalized normal of plane
+ * @param _d - d of plane eqn
+ * @param _spheres - spheres to test
+ * @param _out - per sphere: SIDE_RESULT
+ */
+void ClassifyPlaneSphereBatch(vec3 const& _n, float _d, SphereSoA const& _spheres, int8_t* _out);
+
+/**
+ * @brief Classifies N AABBs against a frustum, 8 (SSE4) or 16 (AVX2) per iteration
+ * @param _frustum - frustum from MakeBatchFrustum()
+ * @param _aabbs - AABBs to test
+ * @param _out - per AABB: INSIDE all planes, OUTSIDE any plane, else OVERLAPPING
+ */
+void ClassifyFrustumAabbBatch(BatchFrustum const& _frustum, AabbSoA const& _aabbs, int8_t* _out);
+/**
+ * @brief Classifies N spheres against a frustum, 8 (SSE4) or 16 (AVX2) per iteration
+ * @param _frustum - frustum from MakeBatchFrustum()
+ * @param _spheres - spheres to test
+ * @param _out - per sphere: INSIDE all planes, OUTSIDE any plane, else OVERLAPPING
+ */
+void ClassifyFrustumSphereBatch(BatchFrustum const& _frustum, SphereSoA const& _spheres, int8_t* _out);
+/**
+ * @brief Classifies N OBBs against a frustum, 8 (SSE4) or 16 (AVX2) per iteration
+ * @param _frustum - frustum from MakeBatchFrustum()
+ * @param _obbs - OBBs to test
+ * @param _out - per OBB: INSIDE all planes, OUTSIDE any plane, else OVERLAPPING
+ */
+void ClassifyFrustumObbBatch(BatchFrustum const& _frustum, ObbSoA const& _obbs, int8_t* _out);
+
+/**
+ * @brief instruction set used by batch tests, defaults to best supported
+ */
+BATCH_ISA GetBatchIsa();
+/**
+ * @brief highest instruction set supported by CPU and build
+ */
+BATCH_ISA GetBatchIsaSupported();
+/**
+ * @brief forces instruction set used by batch tests, clamped to supported
+ * (e.g. to compare against scalar results)
+ */
+void SetBatchIsa(BATCH_ISA _isa);
+/**
+ * @brief kernel table of current instruction set
+ */
+BatchKernels const& GetBatchKernels();
+/**
+ * @brief packs ray for kernels
+ */
+BatchRay MakeBatchRay(vec3 const& _s, vec3 const& _dir);
+/**
+ * @brief extracts the 6 world space frustum planes (l r b t n f) of a camera 
+ * and normalizes them once for the frustum batch tests
+ * @param _vp - proj * view of camera
+ */
+BatchFrustum MakeBatchFrustum(mat4 const& _vp);
+
+#endif /* INTERSECTION_BATCH_HPP */
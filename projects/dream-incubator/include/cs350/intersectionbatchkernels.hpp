@@ -0,0 +1,484 @@
+/**
+@file    intersectionbatchkernels.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the batch intersection kernels shared by the scalar, SSE4 and
+AVX2 translation units. Kernels are written once against a lane type L that wraps
+either a float or a SIMD register, so every instruction set runs the same
+sequence of IEEE operations and gives bit identical results. The occlusion
+buffer's depth tile rasterizer shares the same lanes.
+
+Only plain floats are used here (no glm) since this header is compiled with
+different instruction set flags per translation unit.
+
+*//*__________________________________________________________________________*/
+
+#ifndef INTERSECTION_BATCH_KERNELS_HPP
+#define INTERSECTION_BATCH_KERNELS_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <cstdint>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+constexpr float cBatchEpsilon = 1e-5f; // same as cEpsilon in intersectiontests.hpp
+constexpr unsigned cRasterTileSize = 8; // pixels per side of a depth tile, a multiple of every lane width
+
+/**
+ * @brief views into SoA arrays of primitives, see intersectionbatch.hpp
+ */
+struct AabbSoAView { float const* minX, * minY, * minZ, * maxX, * maxY, * maxZ; unsigned count; };
+struct SphereSoAView { float const* x, * y, * z, * r; unsigned count; };
+struct TriangleSoAView { float const* ax, * ay, * az, * bx, * by, * bz, * cx, * cy, * cz; unsigned count; };
+struct ObbSoAView { float const* c[3]; float const* e[3]; float const* u[3][3]; unsigned count; }; // u[axis][component]
+
+/**
+ * @brief query primitives, derived values are precomputed once per batch
+ */
+struct BatchRay { float s[3]; float dir[3]; float invDir[3]; float dirLen2; float invDirLen2; };
+struct BatchSphere { float c[3]; float r; };
+struct BatchAabb { float min[3]; float max[3]; };
+struct BatchPlane { float n[3]; float absN[3]; float d; };
+struct BatchFrustum { BatchPlane planes[6]; }; // normalized, normals point out of frustum
+struct BatchRasterTriangle { float edge[3][3]; float depth[3]; int minX, minY, maxX, maxY; }; // a*x + b*y + c in pixels, edges >= 0 inside
+
+/**
+ * @brief each kernel processes objects from _first in steps of the lane width
+ * and returns the index of the first object it did not process
+ */
+struct BatchKernels
+{
+	unsigned (*rayAabb)(BatchRay const&, AabbSoAView const&, unsigned, float*);
+	unsigned (*raySphere)(BatchRay const&, SphereSoAView const&, unsigned, float*);
+	unsigned (*rayTriangle)(BatchRay const&, TriangleSoAView const&, unsigned, float*);
+	unsigned (*sphereAabb)(BatchSphere const&, AabbSoAView const&, unsigned, uint8_t*);
+	unsigned (*sphereSphere)(BatchSphere const&, SphereSoAView const&, unsigned, uint8_t*);
+	unsigned (*aabbAabb)(BatchAabb const&, AabbSoAView const&, unsigned, uint8_t*);
+	unsigned (*planeAabb)(BatchPlane const&, AabbSoAView const&, unsigned, int8_t*);
+	unsigned (*planeSphere)(BatchPlane const&, SphereSoAView const&, unsigned, int8_t*);
+	unsigned (*frustumAabb)(BatchFrustum const&, AabbSoAView const&, unsigned, int8_t*);
+	unsigned (*frustumSphere)(BatchFrustum const&, SphereSoAView const&, unsigned, int8_t*);
+	unsigned (*frustumObb)(BatchFrustum const&, ObbSoAView const&, unsigned, int8_t*);
+	void (*rasterTile)(BatchRasterTriangle const&, unsigned, unsigned, float*);
+};
+
+/**
+ * @brief kernel tables of each instruction set, nullptr if not compiled in
+ */
+BatchKernels const* GetBatchKernelsScalar();
+BatchKernels const* GetBatchKernelsSse4();
+BatchKernels const* GetBatchKernelsAvx2();
+
+/**
+ * Kernels
+ */
+
+/**
+ * @brief writes lane results of a mask as 0/1 bytes
+ */
+template <typename L>
+static void StoreMask(uint8_t* _out, typename L::M _m)
+{
+	unsigned bits = L::MoveMask(_m);
+	for (unsigned k = 0; k < L::Width; ++k) { _out[k] = static_cast<uint8_t>((bits >> k) & 1u); }
+}
+
+/**
+ * @brief writes lane results of outside/inside masks as SIDE_RESULT values
+ */
+template <typename L>
+static void StoreSide(int8_t* _out, typename L::M _outside, typename L::M _inside)
+{
+	unsigned outBits = L::MoveMask(_outside); unsigned inBits = L::MoveMask(_inside);
+	for (unsigned k = 0; k < L::Width; ++k)
+	{ _out[k] = static_cast<int8_t>((outBits >> k) & 1u ? 1 : ((inBits >> k) & 1u ? -1 : 0)); }
+}
+
+/**
+ * @brief branchless slab test, -1 if missed, 0 if ray starts inside, else entry time
+ */
+template <typename L>
+static unsigned RayAabbKernel(BatchRay const& _ray, AabbSoAView const& _aabbs, unsigned _first, float* _outT)
+{
+	using F = typename L::F; using M = typename L::M;
+	F const sx = L::Set(_ray.s[0]), sy = L::Set(_ray.s[1]), sz = L::Set(_ray.s[2]);
+	F const ix = L::Set(_ray.invDir[0]), iy = L::Set(_ray.invDir[1]), iz = L::Set(_ray.invDir[2]);
+	F const zero = L::Set(0.f), miss = L::Set(-1.f);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _aabbs.count; i += L::Width)
+	{
+		F t1 = L::Mul(L::Sub(L::Load(_aabbs.minX + i), sx), ix);
+		F t2 = L::Mul(L::Sub(L::Load(_aabbs.maxX + i), sx), ix);
+		F tEnter = L::Min(t1, t2); F tExit = L::Max(t1, t2);
+
+		t1 = L::Mul(L::Sub(L::Load(_aabbs.minY + i), sy), iy);
+		t2 = L::Mul(L::Sub(L::Load(_aabbs.maxY + i), sy), iy);
+		tEnter = L::Max(tEnter, L::Min(t1, t2)); tExit = L::Min(tExit, L::Max(t1, t2));
+
+		t1 = L::Mul(L::Sub(L::Load(_aabbs.minZ + i), sz), iz);
+		t2 = L::Mul(L::Sub(L::Load(_aabbs.maxZ + i), sz), iz);
+		tEnter = L::Max(tEnter, L::Min(t1, t2)); tExit = L::Min(tExit, L::Max(t1, t2));
+
+		M hit = L::And(L::Le(tEnter, tExit), L::Gt(tExit, zero));
+		L::Store(_outT + i, L::Select(hit, L::Max(tEnter, zero), miss));
+	}
+	return i;
+}
+
+/**
+ * @brief ray vs sphere, -1 if missed, 0 if ray starts inside, else entry time
+ */
+template <typename L>
+static unsigned RaySphereKernel(BatchRay const& _ray, SphereSoAView const& _spheres, unsigned _first, float* _outT)
+{
+	using F = typename L::F; using M = typename L::M;
+	F const sx = L::Set(_ray.s[0]), sy = L::Set(_ray.s[1]), sz = L::Set(_ray.s[2]);
+	F const dx = L::Set(_ray.dir[0]), dy = L::Set(_ray.dir[1]), dz = L::Set(_ray.dir[2]);
+	F const a = L::Set(_ray.dirLen2), invA = L::Set(_ray.invDirLen2);
+	F const zero = L::Set(0.f), miss = L::Set(-1.f);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _spheres.count; i += L::Width)
+	{
+		F lx = L::Sub(sx, L::Load(_spheres.x + i));
+		F ly = L::Sub(sy, L::Load(_spheres.y + i));
+		F lz = L::Sub(sz, L::Load(_spheres.z + i));
+		F r = L::Load(_spheres.r + i);
+
+		F b = L::Add(L::Add(L::Mul(lx, dx), L::Mul(ly, dy)), L::Mul(lz, dz));
+		F c = L::Sub(L::Add(L::Add(L::Mul(lx, lx), L::Mul(ly, ly)), L::Mul(lz, lz)), L::Mul(r, r));
+		F discr = L::Sub(L::Mul(b, b), L::Mul(a, c));
+		F sq = L::Sqrt(L::Max(discr, zero));
+		F tNear = L::Mul(L::Sub(L::Sub(zero, b), sq), invA);
+		F tFar = L::Mul(L::Sub(sq, b), invA);
+
+		M hit = L::And(L::Ge(discr, zero), L::Ge(tFar, zero));
+		L::Store(_outT + i, L::Select(hit, L::Max(tNear, zero), miss));
+	}
+	return i;
+}
+
+/**
+ * @brief Moller-Trumbore ray vs triangle, -1 if missed else hit time
+ */
+template <typename L>
+static unsigned RayTriangleKernel(BatchRay const& _ray, TriangleSoAView const& _tris, unsigned _first, float* _outT)
+{
+	using F = typename L::F; using M = typename L::M;
+	F const sx = L::Set(_ray.s[0]), sy = L::Set(_ray.s[1]), sz = L::Set(_ray.s[2]);
+	F const dx = L::Set(_ray.dir[0]), dy = L::Set(_ray.dir[1]), dz = L::Set(_ray.dir[2]);
+	F const zero = L::Set(0.f), one = L::Set(1.f), miss = L::Set(-1.f);
+	F const eps = L::Set(cBatchEpsilon), negEps = L::Set(-cBatchEpsilon);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _tris.count; i += L::Width)
+	{
+		F ax = L::Load(_tris.ax + i), ay = L::Load(_tris.ay + i), az = L::Load(_tris.az + i);
+		// edge vectors of tri
+		F e1x = L::Sub(L::Load(_tris.bx + i), ax), e1y = L::Sub(L::Load(_tris.by + i), ay), e1z = L::Sub(L::Load(_tris.bz + i), az);
+		F e2x = L::Sub(L::Load(_tris.cx + i), ax), e2y = L::Sub(L::Load(_tris.cy + i), ay), e2z = L::Sub(L::Load(_tris.cz + i), az);
+
+		// p = dir x e2
+		F px = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+		F py = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+		F pz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+		F det = L::Add(L::Add(L::Mul(e1x, px), L::Mul(e1y, py)), L::Mul(e1z, pz));
+		F invDet = L::Div(one, det);
+
+		F tx = L::Sub(sx, ax), ty = L::Sub(sy, ay), tz = L::Sub(sz, az);
+		F u = L::Mul(L::Add(L::Add(L::Mul(tx, px), L::Mul(ty, py)), L::Mul(tz, pz)), invDet);
+
+		// q = (s - a) x e1
+		F qx = L::Sub(L::Mul(ty, e1z), L::Mul(tz, e1y));
+		F qy = L::Sub(L::Mul(tz, e1x), L::Mul(tx, e1z));
+		F qz = L::Sub(L::Mul(tx, e1y), L::Mul(ty, e1x));
+		F v = L::Mul(L::Add(L::Add(L::Mul(dx, qx), L::Mul(dy, qy)), L::Mul(dz, qz)), invDet);
+		F t = L::Mul(L::Add(L::Add(L::Mul(e2x, qx), L::Mul(e2y, qy)), L::Mul(e2z, qz)), invDet);
+
+		// not parallel, inside tri and in front of ray
+		M hit = L::Or(L::Le(det, negEps), L::Ge(det, eps));
+		hit = L::And(hit, L::And(L::Ge(u, zero), L::Ge(v, zero)));
+		hit = L::And(hit, L::And(L::Le(L::Add(u, v), one), L::Ge(t, zero)));
+		L::Store(_outT + i, L::Select(hit, t, miss));
+	}
+	return i;
+}
+
+template <typename L>
+static unsigned SphereAabbKernel(BatchSphere const& _sphere, AabbSoAView const& _aabbs, unsigned _first, uint8_t* _out)
+{
+	using F = typename L::F;
+	F const cx = L::Set(_sphere.c[0]), cy = L::Set(_sphere.c[1]), cz = L::Set(_sphere.c[2]);
+	F const r2 = L::Set(_sphere.r * _sphere.r), zero = L::Set(0.f);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _aabbs.count; i += L::Width)
+	{
+		// distance from center to box along each axis, 0 if within slab
+		F dx = L::Max(L::Max(L::Sub(L::Load(_aabbs.minX + i), cx), L::Sub(cx, L::Load(_aabbs.maxX + i))), zero);
+		F dy = L::Max(L::Max(L::Sub(L::Load(_aabbs.minY + i), cy), L::Sub(cy, L::Load(_aabbs.maxY + i))), zero);
+		F dz = L::Max(L::Max(L::Sub(L::Load(_aabbs.minZ + i), cz), L::Sub(cz, L::Load(_aabbs.maxZ + i))), zero);
+		F d2 = L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz));
+		StoreMask<L>(_out + i, L::Le(d2, r2));
+	}
+	return i;
+}
+
+template <typename L>
+static unsigned SphereSphereKernel(BatchSphere const& _sphere, SphereSoAView const& _spheres, unsigned _first, uint8_t* _out)
+{
+	using F = typename L::F;
+	F const cx = L::Set(_sphere.c[0]), cy = L::Set(_sphere.c[1]), cz = L::Set(_sphere.c[2]);
+	F const r = L::Set(_sphere.r);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _spheres.count; i += L::Width)
+	{
+		F dx = L::Sub(L::Load(_spheres.x + i), cx);
+		F dy = L::Sub(L::Load(_spheres.y + i), cy);
+		F dz = L::Sub(L::Load(_spheres.z + i), cz);
+		F rr = L::Add(L::Load(_spheres.r + i), r);
+		F d2 = L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz));
+		StoreMask<L>(_out + i, L::Le(d2, L::Mul(rr, rr)));
+	}
+	return i;
+}
+
+template <typename L>
+static unsigned AabbAabbKernel(BatchAabb const& _aabb, AabbSoAView const& _aabbs, unsigned _first, uint8_t* _out)
+{
+	using F = typename L::F; using M = typename L::M;
+	F const minX = L::Set(_aabb.min[0]), minY = L::Set(_aabb.min[1]), minZ = L::Set(_aabb.min[2]);
+	F const maxX = L::Set(_aabb.max[0]), maxY = L::Set(_aabb.max[1]), maxZ = L::Set(_aabb.max[2]);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _aabbs.count; i += L::Width)
+	{
+		M x = L::And(L::Ge(maxX, L::Load(_aabbs.minX + i)), L::Le(minX, L::Load(_aabbs.maxX + i)));
+		M y = L::And(L::Ge(maxY, L::Load(_aabbs.minY + i)), L::Le(minY, L::Load(_aabbs.maxY + i)));
+		M z = L::And(L::Ge(maxZ, L::Load(_aabbs.minZ + i)), L::Le(minZ, L::Load(_aabbs.maxZ + i)));
+		StoreMask<L>(_out + i, L::And(x, L::And(y, z)));
+	}
+	return i;
+}
+
+template <typename L>
+static unsigned PlaneAabbKernel(BatchPlane const& _plane, AabbSoAView const& _aabbs, unsigned _first, int8_t* _out)
+{
+	using F = typename L::F;
+	F const nx = L::Set(_plane.n[0]), ny = L::Set(_plane.n[1]), nz = L::Set(_plane.n[2]);
+	F const ax = L::Set(_plane.absN[0]), ay = L::Set(_plane.absN[1]), az = L::Set(_plane.absN[2]);
+	F const d = L::Set(_plane.d), half = L::Set(0.5f), zero = L::Set(0.f);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _aabbs.count; i += L::Width)
+	{
+		F maxX = L::Load(_aabbs.maxX + i), maxY = L::Load(_aabbs.maxY + i), maxZ = L::Load(_aabbs.maxZ + i);
+		F cx = L::Mul(L::Add(maxX, L::Load(_aabbs.minX + i)), half);
+		F cy = L::Mul(L::Add(maxY, L::Load(_aabbs.minY + i)), half);
+		F cz = L::Mul(L::Add(maxZ, L::Load(_aabbs.minZ + i)), half);
+		// projected radius of box onto plane normal
+		F radius = L::Add(L::Add(L::Mul(L::Sub(maxX, cx), ax), L::Mul(L::Sub(maxY, cy), ay)), L::Mul(L::Sub(maxZ, cz), az));
+		F dist = L::Sub(L::Add(L::Add(L::Mul(nx, cx), L::Mul(ny, cy)), L::Mul(nz, cz)), d);
+		StoreSide<L>(_out + i, L::Gt(dist, radius), L::Lt(dist, L::Sub(zero, radius)));
+	}
+	return i;
+}
+
+template <typename L>
+static unsigned PlaneSphereKernel(BatchPlane const& _plane, SphereSoAView const& _spheres, unsigned _first, int8_t* _out)
+{
+	using F = typename L::F;
+	F const nx = L::Set(_plane.n[0]), ny = L::Set(_plane.n[1]), nz = L::Set(_plane.n[2]);
+	F const d = L::Set(_plane.d), zero = L::Set(0.f);
+
+	unsigned i = _first;
+	for (; i + L::Width <= _spheres.count; i += L::Width)
+	{
+		F r = L::Load(_spheres.r + i);
+		F dist = L::Sub(L::Add(L::Add(L::Mul(nx, L::Load(_spheres.x + i)), L::Mul(ny, L::Load(_spheres.y + i))), 
+			L::Mul(nz, L::Load(_spheres.z + i))), d);
+		StoreSide<L>(_out + i, L::Gt(dist, r), L::Lt(dist, L::Sub(zero, r)));
+	}
+	return i;
+}
+
+/**
+ * @brief frustum planes broadcast to lanes once per batch
+ */
+template <typename L>
+struct FrustumLanes
+{
+	typename L::F n[6][3], absN[6][3], d[6];
+
+	FrustumLanes(BatchFrustum const& _frustum)
+	{
+		for (int p = 0; p < 6; ++p)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				n[p][j] = L::Set(_frustum.planes[p].n[j]);
+				absN[p][j] = L::Set(_frustum.planes[p].absN[j]);
+			}
+			d[p] = L::Set(_frustum.planes[p].d);
+		}
+	}
+};
+
+/**
+ * @brief classifies one lane width of objects, given signed distance and 
+ * projected radius per plane. Outside if outside any plane, inside if inside all.
+ */
+template <typename L, typename DistRadius>
+static void ClassifyFrustumLanes(int8_t* _out, DistRadius&& _distRadius)
+{
+	using F = typename L::F; using M = typename L::M;
+	F const zero = L::Set(0.f);
+	F dist, radius;
+	_distRadius(0, dist, radius);
+	M outside = L::Gt(dist, radius);
+	M inside = L::Lt(dist, L::Sub(zero, radius));
+	for (int p = 1; p < 6; ++p)
+	{
+		_distRadius(p, dist, radius);
+		outside = L::Or(outside, L::Gt(dist, radius));
+		inside = L::And(inside, L::Lt(dist, L::Sub(zero, radius)));
+	}
+	StoreSide<L>(_out, outside, inside);
+}
+
+/**
+ * @brief frustum kernels handle 2 lane widths per iteration (8 objects for SSE, 
+ * 16 for AVX2) to hide latency, then single lane widths
+ */
+template <typename L, typename Block>
+static unsigned FrustumLoop(unsigned _first, unsigned _count, Block&& _block)
+{
+	unsigned i = _first;
+	for (; i + 2 * L::Width <= _count; i += 2 * L::Width) { _block(i); _block(i + L::Width); }
+	for (; i + L::Width <= _count; i += L::Width) { _block(i); }
+	return i;
+}
+
+template <typename L>
+static unsigned FrustumAabbKernel(BatchFrustum const& _frustum, AabbSoAView const& _aabbs, unsigned _first, int8_t* _out)
+{
+	using F = typename L::F;
+	FrustumLanes<L> const f(_frustum);
+	F const half = L::Set(0.5f);
+	return FrustumLoop<L>(_first, _aabbs.count, [&](unsigned _i)
+		{
+			F maxX = L::Load(_aabbs.maxX + _i), maxY = L::Load(_aabbs.maxY + _i), maxZ = L::Load(_aabbs.maxZ + _i);
+			F cx = L::Mul(L::Add(maxX, L::Load(_aabbs.minX + _i)), half);
+			F cy = L::Mul(L::Add(maxY, L::Load(_aabbs.minY + _i)), half);
+			F cz = L::Mul(L::Add(maxZ, L::Load(_aabbs.minZ + _i)), half);
+			F ex = L::Sub(maxX, cx), ey = L::Sub(maxY, cy), ez = L::Sub(maxZ, cz);
+			ClassifyFrustumLanes<L>(_out + _i, [&](int _p, F& _dist, F& _radius)
+				{
+					_radius = L::Add(L::Add(L::Mul(ex, f.absN[_p][0]), L::Mul(ey, f.absN[_p][1])), L::Mul(ez, f.absN[_p][2]));
+					_dist = L::Sub(L::Add(L::Add(L::Mul(f.n[_p][0], cx), L::Mul(f.n[_p][1], cy)), L::Mul(f.n[_p][2], cz)), f.d[_p]);
+				});
+		});
+}
+
+template <typename L>
+static unsigned FrustumSphereKernel(BatchFrustum const& _frustum, SphereSoAView const& _spheres, unsigned _first, int8_t* _out)
+{
+	using F = typename L::F;
+	FrustumLanes<L> const f(_frustum);
+	return FrustumLoop<L>(_first, _spheres.count, [&](unsigned _i)
+		{
+			F cx = L::Load(_spheres.x + _i), cy = L::Load(_spheres.y + _i), cz = L::Load(_spheres.z + _i);
+			F r = L::Load(_spheres.r + _i);
+			ClassifyFrustumLanes<L>(_out + _i, [&](int _p, F& _dist, F& _radius)
+				{
+					_radius = r;
+					_dist = L::Sub(L::Add(L::Add(L::Mul(f.n[_p][0], cx), L::Mul(f.n[_p][1], cy)), L::Mul(f.n[_p][2], cz)), f.d[_p]);
+				});
+		});
+}
+
+template <typename L>
+static unsigned FrustumObbKernel(BatchFrustum const& _frustum, ObbSoAView const& _obbs, unsigned _first, int8_t* _out)
+{
+	using F = typename L::F;
+	FrustumLanes<L> const f(_frustum);
+	return FrustumLoop<L>(_first, _obbs.count, [&](unsigned _i)
+		{
+			F c[3], e[3], u[3][3];
+			for (int j = 0; j < 3; ++j)
+			{
+				c[j] = L::Load(_obbs.c[j] + _i); e[j] = L::Load(_obbs.e[j] + _i);
+				for (int k = 0; k < 3; ++k) { u[j][k] = L::Load(_obbs.u[j][k] + _i); }
+			}
+			ClassifyFrustumLanes<L>(_out + _i, [&](int _p, F& _dist, F& _radius)
+				{
+					F const* n = f.n[_p];
+					// projected radius, extents along box axes projected onto plane normal
+					F p0 = L::Abs(L::Add(L::Add(L::Mul(n[0], u[0][0]), L::Mul(n[1], u[0][1])), L::Mul(n[2], u[0][2])));
+					F p1 = L::Abs(L::Add(L::Add(L::Mul(n[0], u[1][0]), L::Mul(n[1], u[1][1])), L::Mul(n[2], u[1][2])));
+					F p2 = L::Abs(L::Add(L::Add(L::Mul(n[0], u[2][0]), L::Mul(n[1], u[2][1])), L::Mul(n[2], u[2][2])));
+					_radius = L::Add(L::Add(L::Mul(e[0], p0), L::Mul(e[1], p1)), L::Mul(e[2], p2));
+					_dist = L::Sub(L::Add(L::Add(L::Mul(n[0], c[0]), L::Mul(n[1], c[1])), L::Mul(n[2], c[2])), f.d[_p]);
+				});
+		});
+}
+
+/**
+ * @brief rasterizes a triangle into one tile of depth, row major, keeping the
+ * nearest depth of every covered pixel center. Rows are whole lane widths.
+ */
+template <typename L>
+static void RasterTileKernel(BatchRasterTriangle const& _tri, unsigned _tileX, unsigned _tileY, float* _tile)
+{
+	using F = typename L::F; using M = typename L::M;
+	static float const s_Centers[cRasterTileSize] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+	int const x0 = static_cast<int>(_tileX * cRasterTileSize), y0 = static_cast<int>(_tileY * cRasterTileSize);
+	int const rowBegin = _tri.minY > y0 ? _tri.minY - y0 : 0;
+	int const rowEnd = _tri.maxY - y0 + 1 < static_cast<int>(cRasterTileSize) ? _tri.maxY - y0 + 1 : static_cast<int>(cRasterTileSize);
+	F const a0 = L::Set(_tri.edge[0][0]), a1 = L::Set(_tri.edge[1][0]), a2 = L::Set(_tri.edge[2][0]);
+	F const za = L::Set(_tri.depth[0]), zero = L::Set(0.f), centers = L::Load(s_Centers);
+
+	for (int y = rowBegin; y < rowEnd; ++y)
+	{
+		// terms constant along the row
+		float const py = static_cast<float>(y0 + y) + 0.5f;
+		F const c0 = L::Set(_tri.edge[0][1] * py + _tri.edge[0][2]);
+		F const c1 = L::Set(_tri.edge[1][1] * py + _tri.edge[1][2]);
+		F const c2 = L::Set(_tri.edge[2][1] * py + _tri.edge[2][2]);
+		F const zc = L::Set(_tri.depth[1] * py + _tri.depth[2]);
+		float* row = _tile + y * cRasterTileSize;
+		for (unsigned k = 0; k < cRasterTileSize; k += L::Width)
+		{
+			int const x = x0 + static_cast<int>(k);
+			if (x + static_cast<int>(L::Width) <= _tri.minX || x > _tri.maxX) { continue; }
+			F px = L::Add(L::Set(static_cast<float>(x)), centers);
+			M inside = L::And(L::Ge(L::Add(L::Mul(a0, px), c0), zero), 
+				L::And(L::Ge(L::Add(L::Mul(a1, px), c1), zero), L::Ge(L::Add(L::Mul(a2, px), c2), zero)));
+			F z = L::Add(L::Mul(za, px), zc);
+			F d = L::Load(row + k);
+			L::Store(row + k, L::Select(inside, L::Min(z, d), d));
+		}
+	}
+}
+
+/**
+ * @brief kernel table for lane type L
+ */
+template <typename L>
+static BatchKernels MakeBatchKernels()
+{
+	return BatchKernels
+	{
+		&RayAabbKernel<L>, &RaySphereKernel<L>, &RayTriangleKernel<L>,
+		&SphereAabbKernel<L>, &SphereSphereKernel<L>, &AabbAabbKernel<L>,
+		&PlaneAabbKernel<L>, &PlaneSphereKernel<L>,
+		&FrustumAabbKernel<L>, &FrustumSphereKernel<L>, &FrustumObbKernel<L>,
+		&RasterTileKernel<L>,
+	};
+}
+
+#endif /* INTERSECTION_BATCH_KERNELS_HPP */
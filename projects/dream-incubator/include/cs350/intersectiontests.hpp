@@ -102,7 +102,7 @@ float IntersectionTimeRaySphere(vec3 const& _s, vec3 const& _dir, vec3 const& _c
  * @param _dir - direction of ray
  * @param _min - min of AABB
  * @param _max - max of AABB
- * @return exit time
+ * @return -1 if missed, 0 if ray starts inside, else entry time
  */
 float IntersectionTimeRayAabb(vec3 const& _s, vec3 const& _dir, vec3 const& _min, vec3 const& _max);
 float IntersectionTimeRayPlane(vec3 const& _s, vec3 const& _dir, vec3 const& _n, float _d);
@@ -145,12 +145,85 @@ SIDE_RESULT ClassifyPlaneAabb(vec3 const& _n, float _d, vec3 const& _min, vec3 c
  */
 SIDE_RESULT ClassifyPlaneObb(vec3 const& _n, float _d, vec3 const& _c, vec3 const& _e, vec3* const _u);
 
+/**
+ * Swept tests. Motion is the displacement over one frame, the returned time of
+ * impact is a fraction of it in [0, 1], 0 if already intersecting, -1 if missed.
+ * The second shape is treated as static, pass motion relative to it if both move.
+ */
+
+/**
+ * @brief Checks Ray vs Capsule intersection
+ * @param _s - start position of ray
+ * @param _dir - direction of ray
+ * @param _A - start of capsule segment
+ * @param _B - end of capsule segment
+ * @param _r - radius of capsule
+ * @return -1 if missed, 0 if ray starts inside, else entry time
+ */
+float IntersectionTimeRayCapsule(vec3 const& _s, vec3 const& _dir, vec3 const& _A, vec3 const& _B, float _r);
+/**
+ * @brief Checks moving Sphere vs Sphere intersection
+ * @param _c1 - center of sphere 1 at start of motion
+ * @param _r1 - radius of sphere 1
+ * @param _v - motion of sphere 1 relative to sphere 2
+ * @param _c2 - center of sphere 2
+ * @param _r2 - radius of sphere 2
+ * @return time of impact
+ */
+float IntersectionTimeMovingSphereSphere(vec3 const& _c1, float _r1, vec3 const& _v, vec3 const& _c2, float _r2);
+/**
+ * @brief Checks moving Sphere vs Plane intersection
+ * @param _c - center of sphere at start of motion
+ * @param _r - radius of sphere
+ * @param _v - motion of sphere relative to plane
+ * @param _n - normalized normal of plane
+ * @param _d - d of plane eqn
+ * @return time of impact
+ */
+float IntersectionTimeMovingSpherePlane(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _n, float _d);
+/**
+ * @brief Checks moving Sphere vs AABB intersection
+ * @param _c - center of sphere at start of motion
+ * @param _r - radius of sphere
+ * @param _v - motion of sphere relative to AABB
+ * @param _min - min of AABB
+ * @param _max - max of AABB
+ * @return time of impact
+ */
+float IntersectionTimeMovingSphereAabb(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _min, vec3 const& _max);
+/**
+ * @brief Checks moving Sphere vs Triangle intersection
+ * @param _c - center of sphere at start of motion
+ * @param _r - radius of sphere
+ * @param _v - motion of sphere relative to triangle
+ * @param _A - v0 of triangle
+ * @param _B - v1 of triangle
+ * @param _C - v2 of triangle
+ * @return time of impact
+ */
+float IntersectionTimeMovingSphereTriangle(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _A, vec3 const& _B, vec3 const& _C);
+/**
+ * @brief Checks moving AABB vs AABB intersection
+ * @param _min1 - min of AABB 1 at start of motion
+ * @param _max1 - max of AABB 1 at start of motion
+ * @param _v - motion of AABB 1 relative to AABB 2
+ * @param _min2 - min of AABB 2
+ * @param _max2 - max of AABB 2
+ * @return time of impact
+ */
+float IntersectionTimeMovingAabbAabb(vec3 const& _min1, vec3 const& _max1, vec3 const& _v, vec3 const& _min2, vec3 const& _max2);
+
 /**
  * Helper functions
  */
 
 bool CheckNaN(float _f);
 bool CheckNaN(vec3 _v);
+/**
+ * @brief 1 / _d for ray slab tests, directions within cEpsilon of 0 get +-FLT_MAX 
+ * instead of inf so (min - s) * invD stays NaN free when the ray is on a slab plane
+ */
+float SafeInvDir(float _d);
 
 
 #endif /* INTERSECTION_TESTS_HPP */
\ No newline at end of file
@@ -14,6 +14,7 @@ This file contains the declaration of the KdTree class.
 
 #include <vector>
 #include <memory>
+#include <array>
 #include <isingleton.hpp>
 #include <ecs.hpp>
 #include <components/boundingvolume.hpp>
@@ -21,6 +22,46 @@ This file contains the declaration of the KdTree class.
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
+enum KDTREE_TRAVERSAL_TYPE
+{
+	KD_TRAVERSAL_ROPES,
+	KD_TRAVERSAL_STACK,
+	KDTREE_TRAVERSAL_TYPE_TOTAL,
+};
+
+/**
+ * @struct KdRayHit
+ * @brief This struct holds the result of a ray query against the k-d tree
+ */
+struct KdRayHit
+{
+	entity ent{ null };
+	float t{ -1.f }; // -1 if nothing was hit
+	unsigned nodesVisited{ 0 };
+};
+
+/**
+ * @struct KdNode
+ * @brief This struct holds the data for a k-d tree node. Nodes live in a single
+ * pool, children of a node are found by index. Every node owns a contiguous range
+ * of the object index array. Leaves also store ropes to the neighbouring node on 
+ * each of their 6 faces (-x, +x, -y, +y, -z, +z) so rays can walk leaf to leaf 
+ * without a stack.
+ */
+struct KdNode
+{
+	vec3 min{ vec3(0) };
+	vec3 max{ vec3(0) };
+	int axis{ -1 }; // -1 if leaf
+	float split{ 0.f };
+	int children[2]{ -1, -1 };
+	unsigned first{ 0 }; // range of objects in index array owned by subtree
+	unsigned count{ 0 };
+	int ropes[6]{ -1, -1, -1, -1, -1, -1 }; // -1 if face is on the boundary of the tree
+	unsigned ropeFirst{ 0 }; // range of objects overlapping leaf, for ray traversal
+	unsigned ropeCount{ 0 };
+};
+
 /**
  * @class KdTree
  * @brief This class is responsible for construction, storing and management of 
@@ -32,25 +73,61 @@ class KdTree : public ISingleton<KdTree>
 public:
 
 	/**
-	  * @brief builds kd tree top down recursively
-	  * @param _depth - depth of the kd tree
-	  * @param _node - node to split recursively until termination conditions are met
+	  * @brief builds kd tree top down in place. Object AABBs and split keys are 
+	  * gathered once, each node then partitions its range of one shared index array 
+	  * with nth_element. Nodes come from a pool sized up front and subtrees near the 
+	  * root are built on separate threads.
 	  * @param _ents - entities in scene
 	  */
-	void BuildKDTree(int _depth, std::unique_ptr<TreeNode> const& _node, std::vector<entity>& _ents);
+	void BuildKDTree(std::vector<entity> const& _ents);
+	/**
+	  * @brief rebuilds the tree from the entities and AABBs gathered by the last
+	  * BuildKDTree() call, used when only the split strategy or leaf size changed
+	  */
+	void Rebuild();
+	/**
+	  * @brief stores every entity AABB in all the leaf cells it overlaps and links 
+	  * leaf faces with ropes for ray traversal
+	  */
+	void BuildRopes();
+	/**
+	  * @brief creates the AABBs of the cells for drawing, grouped by level, and
+	  * colors objects by leaf
+	  */
+	void BuildDebugVolumes();
+
+	/**
+	  * @brief finds closest entity AABB hit by ray
+	  * @param _s - start position of ray
+	  * @param _dir - direction of ray
+	  * @param _type - stackless rope traversal or stack based front to back traversal
+	  * @return hit entity, hit time and number of nodes visited
+	  */
+	KdRayHit RayCast(vec3 const& _s, vec3 const& _dir, KDTREE_TRAVERSAL_TYPE _type = KD_TRAVERSAL_ROPES);
+	/**
+	  * @brief checks if any entity AABB is hit by ray before _tMax, stops at first hit
+	  * @param _s - start position of ray
+	  * @param _dir - direction of ray
+	  * @param _tMax - max time along ray to check (e.g. distance to light)
+	  * @param _type - stackless rope traversal or stack based front to back traversal
+	  * @return hit entity, hit time and number of nodes visited
+	  */
+	KdRayHit ShadowRay(vec3 const& _s, vec3 const& _dir, float _tMax, KDTREE_TRAVERSAL_TYPE _type = KD_TRAVERSAL_ROPES);
 
 	BVH_STRATEGY_TYPE& GetSplitStrategy() { return m_SplitStrategy; };
 	int& GetNumObjPerNode() { return m_NumObjPerNode; };
 	entity GetKdTreeEnt() { return m_KdTreeEnt; };
-	std::unique_ptr<TreeNode> const& GetRoot() { return m_Root; };
+	std::vector<KdNode> const& GetNodes() { return m_Nodes; };
+	std::vector<unsigned> const& GetIndices() { return m_Indices; }; // index into GetEntities()
+	std::vector<entity> const& GetEntities() { return m_Ents; };
 	std::vector<std::vector<bool*>>& GetVisibilityFlags() { return m_VisibilityFlags; };
-	void ClearTree() { m_Root = std::make_unique<TreeNode>(); };
+	void ClearTree() { m_Nodes.clear(); m_Indices.clear(); m_RopeLeafObjs.clear(); };
 
 private:
 
 	friend class ISingleton<KdTree>;
 
-	KdTree() : m_SplitStrategy(TOP_DOWN_BV_CENTER_MEDIAN), m_NumObjPerNode(10), m_Root(std::make_unique<TreeNode>()),
+	KdTree() : m_SplitStrategy(TOP_DOWN_BV_CENTER_MEDIAN), m_NumObjPerNode(10),
 		m_KdTreeEnt(ECS.CreateDefaultEntity("KdTree")) { ECS.registry().emplace<BVList>(m_KdTreeEnt); };
 	~KdTree() {  };
 
@@ -59,23 +136,53 @@ private:
 	 */
 
 	/**
-	  * @brief splits the list of entities passed in from BuildTopDown(), very similar to 
-	  * BVHierarchy::PartitionObjects() except in kdtree there is implicit axis ordering (X -> Y -> Z)
-	  * instead of choosing the largest spread axis
-	  * @param _ents - list of entities to split
-	  * @param _axis - passed in from BuildTopDown(), axis changes every split based on tree depth % 3
-	  * @param _left - entities to be stored in left subtree
-	  * @param _split - split entity/coplanar entities to be stored in internal node
-	  * @param _right - entities to be stored in right subtree
+	  * @brief number of nodes in a subtree of _count objects, the tree shape only 
+	  * depends on object count so node indices can be assigned before building
+	  * @param _count - number of objects in subtree
+	  */
+	unsigned CountNodes(unsigned _count) const;
+	/**
+	  * @brief splits [_first, _first + _count) of the index array at its median along
+	  * axis depth % 3 (implicit axis ordering X -> Y -> Z), using the split key of 
+	  * the current strategy, and recurses
+	  * @param _node - index of node in pool
+	  * @param _first - first object of range
+	  * @param _count - number of objects in range
+	  * @param _depth - depth of node
+	  * @param _min - min of node cell
+	  * @param _max - max of node cell
+	  */
+	void BuildNode(int _node, unsigned _first, unsigned _count, int _depth, vec3 _min, vec3 _max);
+	/**
+	  * @brief pushes objects down into every leaf cell they overlap
+	  * @param _node - index of node in pool
+	  * @param _objs - indices of objects overlapping node
+	  */
+	void DistributeObjects(int _node, std::vector<unsigned> const& _objs);
+	/**
+	  * @brief passes ropes down the tree, the child on each side of a split gets
+	  * a rope to its sibling on the split face
+	  * @param _node - index of node in pool
+	  * @param _ropes - ropes of parent
 	  */
-	float PartitionObjects(std::vector<entity>& _ents, int _axis, std::vector<entity>& _left, std::vector<entity>& _split, std::vector<entity>& _right);
+	void LinkRopes(int _node, std::array<int, 6> _ropes);
+	KdRayHit TraverseRopes(vec3 const& _s, vec3 const& _dir, float _tMax, bool _isAnyHit);
+	KdRayHit TraverseStack(vec3 const& _s, vec3 const& _dir, float _tMax, bool _isAnyHit);
 
 
 	BVH_STRATEGY_TYPE m_SplitStrategy;
 	int m_NumObjPerNode;
-	std::unique_ptr<TreeNode> m_Root;
 	entity m_KdTreeEnt; // to hold all AABBs generated
 	std::vector<std::vector<bool*>> m_VisibilityFlags; // isActive flag for bv grouped by lvl
+	int m_ParallelDepth{ 0 }; // subtrees above this depth are built on their own thread
+
+	std::vector<KdNode> m_Nodes; // node pool, root at 0
+	std::vector<unsigned> m_Indices; // object indices, partitioned in place by build
+	std::vector<entity> m_Ents;
+	std::vector<vec3> m_ObjMin; // world AABB of objects
+	std::vector<vec3> m_ObjMax;
+	std::vector<vec3> m_Keys; // split key of objects, AABB center or min depending on strategy
+	std::vector<unsigned> m_RopeLeafObjs; // object indices referenced by leaf rope ranges
 };
 
 #define KDTREE KdTree::GetInstance() // macro for easy access
@@ -0,0 +1,86 @@
+/**
+@file    meshoptimize.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of mesh optimisation at import, reordering
+triangles for the post transform vertex cache and overdraw, and vertices for
+fetch.
+
+*//*__________________________________________________________________________*/
+
+#ifndef MESH_OPTIMIZE_HPP
+#define MESH_OPTIMIZE_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <graphics/mesharena.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint32_t constexpr MESH_VERTEX_CACHE_SIZE = 16; // fifo entries assumed when reordering and measuring
+static float constexpr MESH_OVERDRAW_THRESHOLD = 1.05f; // acmr may grow by this factor to reduce overdraw
+
+/**
+ * @struct MeshOptimizeStats
+ * @brief This struct holds the average cache miss ratio of a mesh, misses of
+ * a MESH_VERTEX_CACHE_SIZE fifo per triangle, 0.5 is the best a large regular
+ * mesh gets and 3 the worst
+ */
+struct MeshOptimizeStats
+{
+	float acmrBefore{ 0.f };
+	float acmrAfter{ 0.f };
+};
+
+/**
+ * @brief average cache miss ratio of a triangle list on a fifo cache
+ * @param _idx - triangle list
+ * @param _numVertices - vertices indexed
+ * @param _cacheSize - fifo entries
+ */
+float ComputeAcmr(std::vector<uint32_t> const& _idx, size_t _numVertices, uint32_t _cacheSize = MESH_VERTEX_CACHE_SIZE);
+
+/**
+ * @brief reorders triangles for a fifo vertex cache by Tipsify, fanning
+ * around a vertex and moving to the cached neighbour whose triangles still
+ * fit in the cache, linear in the number of triangles
+ * @param _idx - triangle list
+ * @param _numVertices - vertices indexed
+ * @param _clusters - if not null, set to the first triangle of each run the
+ * cache was flushed between, the places overdraw may reorder at for free
+ * @return triangle list with the same triangles
+ */
+std::vector<uint32_t> OptimizeVertexCache(std::vector<uint32_t> const& _idx, size_t _numVertices,
+	std::vector<uint32_t>* _clusters = nullptr);
+
+/**
+ * @brief reorders clusters of a cache optimised triangle list so those
+ * facing out from the centre of the mesh draw first, occluding the rest from
+ * most views. Clusters are split further where it costs the cache under
+ * _threshold, triangles in a cluster keep their order.
+ * @param _vtx - vertices of mesh
+ * @param _idx - triangle list from OptimizeVertexCache()
+ * @param _clusters - its clusters
+ * @param _threshold - factor acmr of a cluster may grow by
+ * @return triangle list with the same triangles
+ */
+std::vector<uint32_t> OptimizeOverdraw(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	std::vector<uint32_t> const& _clusters, float _threshold = MESH_OVERDRAW_THRESHOLD);
+
+/**
+ * @brief reorders vertices by first use so fetches walk the vertex buffer
+ * forward, unused vertices are dropped and indices remapped
+ */
+void OptimizeVertexFetch(std::vector<Vertex>& _vtx, std::vector<uint32_t>& _idx);
+
+/**
+ * @brief runs every optimisation on an indexed triangle mesh, in place.
+ * Thread safe.
+ * @return acmr before and after
+ */
+MeshOptimizeStats OptimizeMesh(std::vector<Vertex>& _vtx, std::vector<uint32_t>& _idx);
+
+#endif /* MESH_OPTIMIZE_HPP */
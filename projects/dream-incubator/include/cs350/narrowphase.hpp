@@ -0,0 +1,229 @@
+/**
+@file    narrowphase.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the narrow phase dispatch tables, one overlap test, one
+swept test and one contact generator per pair of shape types generated at
+compile time.
+
+*//*__________________________________________________________________________*/
+
+#ifndef NARROW_PHASE_HPP
+#define NARROW_PHASE_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <array>
+#include <utility>
+#include <tuple>
+#include <components/collider.hpp>
+#include <cs350/intersectiontests.hpp>
+#include <cs350/contactmanifold.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+using NarrowPhaseFn = bool(*)(Collider const&, Collider const&);
+
+/**
+ * @brief narrow phase test of shape A against shape B, only specialized for
+ * A <= B. Pairs without a specialization never collide (meshes are tested by
+ * GJK in the Collision system).
+ */
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+bool NarrowPhase(Collider const&, Collider const&) { return false; }
+
+template<> inline bool NarrowPhase<SHAPE_POINT, SHAPE_PLANE>(Collider const& _p, Collider const& _pl)
+{ return ClassifyPointPlane(_p.center, _pl.dir, _pl.d) == SIDE_RESULT::OVERLAPPING; }
+template<> inline bool NarrowPhase<SHAPE_POINT, SHAPE_TRIANGLE>(Collider const& _p, Collider const& _t)
+{ return OverlapPointTriangle(_p.center, _t.tri[0], _t.tri[1], _t.tri[2]); }
+template<> inline bool NarrowPhase<SHAPE_POINT, SHAPE_SPHERE>(Collider const& _p, Collider const& _s)
+{ return OverlapPointSphere(_p.center, _s.center, _s.radius); }
+template<> inline bool NarrowPhase<SHAPE_POINT, SHAPE_AABB>(Collider const& _p, Collider const& _b)
+{ return OverlapPointAabb(_p.center, _b.GetMin(), _b.GetMax()); }
+
+template<> inline bool NarrowPhase<SHAPE_RAY, SHAPE_PLANE>(Collider const& _r, Collider const& _pl)
+{ return IntersectionTimeRayPlane(_r.center, _r.dir, _pl.dir, _pl.d) > 0; }
+template<> inline bool NarrowPhase<SHAPE_RAY, SHAPE_TRIANGLE>(Collider const& _r, Collider const& _t)
+{ return std::get<0>(IntersectionTimeRayTriangle(_r.center, _r.dir, _t.tri[0], _t.tri[1], _t.tri[2])) > 0; }
+template<> inline bool NarrowPhase<SHAPE_RAY, SHAPE_SPHERE>(Collider const& _r, Collider const& _s)
+{ return IntersectionTimeRaySphere(_r.center, _r.dir, _s.center, _s.radius) > 0; }
+template<> inline bool NarrowPhase<SHAPE_RAY, SHAPE_AABB>(Collider const& _r, Collider const& _b)
+{ return IntersectionTimeRayAabb(_r.center, _r.dir, _b.GetMin(), _b.GetMax()) > 0; }
+
+template<> inline bool NarrowPhase<SHAPE_PLANE, SHAPE_SPHERE>(Collider const& _pl, Collider const& _s)
+{ return ClassifyPlaneSphere(_pl.dir, _pl.d, _s.center, _s.radius) == SIDE_RESULT::OVERLAPPING; }
+template<> inline bool NarrowPhase<SHAPE_PLANE, SHAPE_AABB>(Collider const& _pl, Collider const& _b)
+{ return ClassifyPlaneAabb(_pl.dir, _pl.d, _b.GetMin(), _b.GetMax()) == SIDE_RESULT::OVERLAPPING; }
+
+template<> inline bool NarrowPhase<SHAPE_SPHERE, SHAPE_SPHERE>(Collider const& _s0, Collider const& _s1)
+{ return OverlapSphereSphere(_s0.center, _s0.radius, _s1.center, _s1.radius); }
+template<> inline bool NarrowPhase<SHAPE_SPHERE, SHAPE_AABB>(Collider const& _s, Collider const& _b)
+{ return OverlapSphereAabb(_s.center, _s.radius, _b.GetMin(), _b.GetMax()); }
+
+template<> inline bool NarrowPhase<SHAPE_AABB, SHAPE_AABB>(Collider const& _b0, Collider const& _b1)
+{ return OverlapAabbAabb(_b0.GetMin(), _b0.GetMax(), _b1.GetMin(), _b1.GetMax()); }
+
+/**
+ * @brief lower half of table, swaps arguments into the specialized upper half
+ */
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+bool NarrowPhaseSwapped(Collider const& _a, Collider const& _b) { return NarrowPhase<B, A>(_b, _a); }
+
+template<size_t I>
+constexpr NarrowPhaseFn MakeNarrowPhaseEntry()
+{
+	constexpr SHAPE_TYPE a = static_cast<SHAPE_TYPE>(I / SHAPE_TYPE_TOTAL);
+	constexpr SHAPE_TYPE b = static_cast<SHAPE_TYPE>(I % SHAPE_TYPE_TOTAL);
+	if constexpr (a <= b) { return &NarrowPhase<a, b>; }
+	else { return &NarrowPhaseSwapped<a, b>; }
+}
+
+template<size_t... I>
+constexpr std::array<NarrowPhaseFn, sizeof...(I)> MakeNarrowPhaseTable(std::index_sequence<I...>)
+{ return { MakeNarrowPhaseEntry<I>()... }; }
+
+// row is type of first collider, column is type of second
+inline constexpr std::array<NarrowPhaseFn, SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL> s_NarrowPhaseTable
+	= MakeNarrowPhaseTable(std::make_index_sequence<SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL>{});
+
+/**
+ * @brief runs narrow phase test of a pair through the table
+ * @return true if colliders are intersecting
+ */
+inline bool NarrowPhaseTest(Collider const& _a, Collider const& _b)
+{ return s_NarrowPhaseTable[_a.type * SHAPE_TYPE_TOTAL + _b.type](_a, _b); }
+
+using SweptPhaseFn = float(*)(Collider const&, Collider const&);
+
+/**
+ * @brief swept test of shape A against shape B over their motion this frame,
+ * only specialized for A <= B. Shapes are swept by translation only, B is held
+ * still and A moves by the relative motion. Pairs without a specialization are
+ * never swept.
+ * @return time of impact in [0, 1], -1 if none
+ */
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+float SweptPhase(Collider const&, Collider const&) { return -1.f; }
+
+/**
+ * @brief motion of A relative to B, and A's center at start of it
+ */
+inline vec3 SweptStart(Collider const& _a, Collider const& _b, vec3& _motion)
+{ _motion = _a.motion - _b.motion; return _a.center - _motion; }
+
+template<> inline float SweptPhase<SHAPE_POINT, SHAPE_PLANE>(Collider const& _p, Collider const& _pl)
+{ vec3 v; vec3 s = SweptStart(_p, _pl, v); return IntersectionTimeMovingSpherePlane(s, 0.f, v, _pl.dir, _pl.d); }
+template<> inline float SweptPhase<SHAPE_POINT, SHAPE_TRIANGLE>(Collider const& _p, Collider const& _t)
+{ vec3 v; vec3 s = SweptStart(_p, _t, v); return IntersectionTimeMovingSphereTriangle(s, 0.f, v, _t.tri[0], _t.tri[1], _t.tri[2]); }
+template<> inline float SweptPhase<SHAPE_POINT, SHAPE_SPHERE>(Collider const& _p, Collider const& _s)
+{ vec3 v; vec3 s = SweptStart(_p, _s, v); return IntersectionTimeMovingSphereSphere(s, 0.f, v, _s.center, _s.radius); }
+template<> inline float SweptPhase<SHAPE_POINT, SHAPE_AABB>(Collider const& _p, Collider const& _b)
+{ vec3 v; vec3 s = SweptStart(_p, _b, v); return IntersectionTimeMovingSphereAabb(s, 0.f, v, _b.GetMin(), _b.GetMax()); }
+
+template<> inline float SweptPhase<SHAPE_PLANE, SHAPE_SPHERE>(Collider const& _pl, Collider const& _s)
+{ vec3 v; vec3 s = SweptStart(_s, _pl, v); return IntersectionTimeMovingSpherePlane(s, _s.radius, v, _pl.dir, _pl.d); }
+template<> inline float SweptPhase<SHAPE_PLANE, SHAPE_AABB>(Collider const& _pl, Collider const& _b)
+{
+	// box against plane is a sphere of the box's projected radius
+	vec3 v; vec3 s = SweptStart(_b, _pl, v);
+	return IntersectionTimeMovingSpherePlane(s, dot(_b.halfExtents, abs(_pl.dir)), v, _pl.dir, _pl.d);
+}
+
+template<> inline float SweptPhase<SHAPE_TRIANGLE, SHAPE_SPHERE>(Collider const& _t, Collider const& _s)
+{ vec3 v; vec3 s = SweptStart(_s, _t, v); return IntersectionTimeMovingSphereTriangle(s, _s.radius, v, _t.tri[0], _t.tri[1], _t.tri[2]); }
+
+template<> inline float SweptPhase<SHAPE_SPHERE, SHAPE_SPHERE>(Collider const& _s0, Collider const& _s1)
+{ vec3 v; vec3 s = SweptStart(_s0, _s1, v); return IntersectionTimeMovingSphereSphere(s, _s0.radius, v, _s1.center, _s1.radius); }
+template<> inline float SweptPhase<SHAPE_SPHERE, SHAPE_AABB>(Collider const& _s, Collider const& _b)
+{ vec3 v; vec3 s = SweptStart(_s, _b, v); return IntersectionTimeMovingSphereAabb(s, _s.radius, v, _b.GetMin(), _b.GetMax()); }
+
+template<> inline float SweptPhase<SHAPE_AABB, SHAPE_AABB>(Collider const& _b0, Collider const& _b1)
+{ vec3 v; vec3 s = SweptStart(_b0, _b1, v); return IntersectionTimeMovingAabbAabb(s - _b0.halfExtents, s + _b0.halfExtents, v, _b1.GetMin(), _b1.GetMax()); }
+
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+float SweptPhaseSwapped(Collider const& _a, Collider const& _b) { return SweptPhase<B, A>(_b, _a); }
+
+template<size_t I>
+constexpr SweptPhaseFn MakeSweptPhaseEntry()
+{
+	constexpr SHAPE_TYPE a = static_cast<SHAPE_TYPE>(I / SHAPE_TYPE_TOTAL);
+	constexpr SHAPE_TYPE b = static_cast<SHAPE_TYPE>(I % SHAPE_TYPE_TOTAL);
+	if constexpr (a <= b) { return &SweptPhase<a, b>; }
+	else { return &SweptPhaseSwapped<a, b>; }
+}
+
+template<size_t... I>
+constexpr std::array<SweptPhaseFn, sizeof...(I)> MakeSweptPhaseTable(std::index_sequence<I...>)
+{ return { MakeSweptPhaseEntry<I>()... }; }
+
+inline constexpr std::array<SweptPhaseFn, SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL> s_SweptPhaseTable
+	= MakeSweptPhaseTable(std::make_index_sequence<SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL>{});
+
+/**
+ * @brief runs swept test of a pair through the table
+ * @return time of impact in [0, 1], -1 if none
+ */
+inline float SweptPhaseTest(Collider const& _a, Collider const& _b)
+{ return s_SweptPhaseTable[_a.type * SHAPE_TYPE_TOTAL + _b.type](_a, _b); }
+
+using ContactPhaseFn = void(*)(Collider const&, Collider const&, ContactManifold&);
+
+/**
+ * @brief contact manifold of shape A and shape B, only called on pairs the
+ * overlap test found intersecting and only specialized for A <= B. Pairs
+ * without a specialization (rays, meshes) report a hit with no points.
+ */
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+void ContactPhase(Collider const&, Collider const&, ContactManifold& _m) { _m.count = 0; }
+
+// points have no volume, they touch at their position and B leaves along its back
+template<> inline void ContactPhase<SHAPE_POINT, SHAPE_PLANE>(Collider const& _p, Collider const& _pl, ContactManifold& _m)
+{ _m.count = 0; _m.normal = -normalize(_pl.dir); _m.AddPoint(_p.center, 0.f); }
+template<> inline void ContactPhase<SHAPE_POINT, SHAPE_TRIANGLE>(Collider const& _p, Collider const& _t, ContactManifold& _m)
+{ _m.count = 0; _m.normal = -normalize(cross(_t.tri[1] - _t.tri[0], _t.tri[2] - _t.tri[0])); _m.AddPoint(_p.center, 0.f); }
+template<> inline void ContactPhase<SHAPE_POINT, SHAPE_SPHERE>(Collider const& _p, Collider const& _s, ContactManifold& _m)
+{ ContactPointSphere(_p.center, _s.center, _s.radius, _m); }
+template<> inline void ContactPhase<SHAPE_POINT, SHAPE_AABB>(Collider const& _p, Collider const& _b, ContactManifold& _m)
+{ ContactPointAabb(_p.center, _b.GetMin(), _b.GetMax(), _m); }
+
+template<> inline void ContactPhase<SHAPE_PLANE, SHAPE_SPHERE>(Collider const& _pl, Collider const& _s, ContactManifold& _m)
+{ ContactPlaneSphere(_pl.dir, _pl.d, _s.center, _s.radius, _m); }
+template<> inline void ContactPhase<SHAPE_PLANE, SHAPE_AABB>(Collider const& _pl, Collider const& _b, ContactManifold& _m)
+{ ContactPlaneAabb(_pl.dir, _pl.d, _b.GetMin(), _b.GetMax(), _m); }
+
+template<> inline void ContactPhase<SHAPE_SPHERE, SHAPE_SPHERE>(Collider const& _s0, Collider const& _s1, ContactManifold& _m)
+{ ContactSphereSphere(_s0.center, _s0.radius, _s1.center, _s1.radius, _m); }
+template<> inline void ContactPhase<SHAPE_SPHERE, SHAPE_AABB>(Collider const& _s, Collider const& _b, ContactManifold& _m)
+{ ContactSphereAabb(_s.center, _s.radius, _b.GetMin(), _b.GetMax(), _m); }
+
+template<> inline void ContactPhase<SHAPE_AABB, SHAPE_AABB>(Collider const& _b0, Collider const& _b1, ContactManifold& _m)
+{ ContactAabbAabb(_b0.GetMin(), _b0.GetMax(), _b1.GetMin(), _b1.GetMax(), _m); }
+
+template<SHAPE_TYPE A, SHAPE_TYPE B>
+void ContactPhaseSwapped(Collider const& _a, Collider const& _b, ContactManifold& _m) { ContactPhase<B, A>(_b, _a, _m); _m.Flip(); }
+
+template<size_t I>
+constexpr ContactPhaseFn MakeContactPhaseEntry()
+{
+	constexpr SHAPE_TYPE a = static_cast<SHAPE_TYPE>(I / SHAPE_TYPE_TOTAL);
+	constexpr SHAPE_TYPE b = static_cast<SHAPE_TYPE>(I % SHAPE_TYPE_TOTAL);
+	if constexpr (a <= b) { return &ContactPhase<a, b>; }
+	else { return &ContactPhaseSwapped<a, b>; }
+}
+
+template<size_t... I>
+constexpr std::array<ContactPhaseFn, sizeof...(I)> MakeContactPhaseTable(std::index_sequence<I...>)
+{ return { MakeContactPhaseEntry<I>()... }; }
+
+inline constexpr std::array<ContactPhaseFn, SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL> s_ContactPhaseTable
+	= MakeContactPhaseTable(std::make_index_sequence<SHAPE_TYPE_TOTAL * SHAPE_TYPE_TOTAL>{});
+
+/**
+ * @brief runs contact generation of an intersecting pair through the table
+ * @param _manifold - normal from _a towards _b, cleared first
+ */
+inline void ContactPhaseTest(Collider const& _a, Collider const& _b, ContactManifold& _manifold)
+{ s_ContactPhaseTable[_a.type * SHAPE_TYPE_TOTAL + _b.type](_a, _b, _manifold); }
+
+#endif /* NARROW_PHASE_HPP */
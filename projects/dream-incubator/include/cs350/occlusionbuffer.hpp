@@ -0,0 +1,114 @@
+/**
+@file    occlusionbuffer.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the OcclusionBuffer class, a low
+resolution software depth buffer for CPU occlusion culling.
+
+*//*__________________________________________________________________________*/
+
+#ifndef OCCLUSION_BUFFER_HPP
+#define OCCLUSION_BUFFER_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <math.hpp>
+#include <cs350/intersectionbatch.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static unsigned constexpr OCCLUSION_WIDTH = 256; // pixels, multiples of cRasterTileSize and powers of 2
+static unsigned constexpr OCCLUSION_HEIGHT = 128;
+static float constexpr OCCLUSION_DEPTH_BIAS = 1e-5f; // ndc depth, keeps occluders from hiding themselves
+
+/**
+ * @struct OccluderMesh
+ * @brief This struct holds a mesh to rasterize into the occlusion buffer,
+ * data is not copied and must outlive Rasterize
+ */
+struct OccluderMesh
+{
+	mat4 mvp; // proj * view * model
+	vec3 const* positions; // strided by stride bytes, see Vertex
+	size_t stride;
+	uint32_t numVertices;
+	uint32_t const* indices; // nullptr if not indexed
+	uint32_t numIndices;
+	bool isStrip; // triangle strip, else triangle list
+};
+
+/**
+ * @class OcclusionBuffer
+ * @brief This class rasterizes occluders into a low resolution depth buffer
+ * and tests boxes against it. Depth is stored in square tiles so each tile is
+ * rasterized by one thread with the batch kernels, then a min/max hierarchy is
+ * built over it. A box is occluded if its nearest depth is behind the farthest
+ * occluder depth everywhere it covers on screen. Runs fully on CPU.
+ */
+class OcclusionBuffer
+{
+
+public:
+
+	OcclusionBuffer();
+
+	/**
+	  * @brief clears depth and rasterizes occluders, triangles are set up in
+	  * parallel over occluders, then binned to tiles and tiles are rasterized
+	  * in parallel. Result does not depend on the thread count.
+	  * @param _occluders - meshes to rasterize
+	  */
+	void Rasterize(std::vector<OccluderMesh> const& _occluders);
+	/**
+	  * @brief tests a world space box, thread safe
+	  * @param _vp - proj * view used for the occluders
+	  * @param _min - min of box
+	  * @param _max - max of box
+	  * @return true if box is hidden behind occluders, false if box crosses
+	  * the near plane or is off screen
+	  */
+	bool IsOccluded(mat4 const& _vp, vec3 const& _min, vec3 const& _max) const;
+
+	/**
+	  * @brief depth of pixel at level 0, ndc depth, 1 if nothing rasterized
+	  */
+	float GetDepth(unsigned _x, unsigned _y) const;
+	uint32_t GetNumTriangles() const { return m_NumTriangles; }
+	uint32_t GetNumLevels() const { return static_cast<uint32_t>(m_MaxDepth.size()) + 1; }
+
+private:
+
+	/**
+	  * @brief clips a clip space triangle to the near plane and sets up what
+	  * is left for rasterizing
+	  */
+	void SetupTriangle(vec4 const& _v0, vec4 const& _v1, vec4 const& _v2, std::vector<BatchRasterTriangle>& _out) const;
+	/**
+	  * @brief min/max of each 2x2 block, level 1 from the tiles then each level
+	  * from the one below
+	  */
+	void BuildHierarchy();
+	/**
+	  * @brief tests texels of a level covering a pixel rectangle, descends into
+	  * texels the box may be in front of
+	  * @param _min - min pixel of rectangle, inclusive
+	  * @param _max - max pixel of rectangle, inclusive
+	  */
+	bool IsRegionOccluded(uint32_t _level, ivec2 const& _min, ivec2 const& _max, float _zNear, float _zFar) const;
+	float GetMaxDepth(uint32_t _level, unsigned _x, unsigned _y) const;
+	float GetMinDepth(uint32_t _level, unsigned _x, unsigned _y) const;
+
+	std::vector<float> m_Tiles; // depth of level 0, tile by tile, each tile row major
+	std::vector<std::vector<float>> m_MaxDepth; // levels from 1, row major
+	std::vector<std::vector<float>> m_MinDepth;
+	std::vector<std::vector<vec4>> m_ThreadClip; // clip space vertices of occluder being set up
+	std::vector<std::vector<BatchRasterTriangle>> m_ThreadTriangles;
+	std::vector<std::vector<uint32_t>> m_Bins; // tile -> triangles touching it, index into m_Triangles
+	std::vector<BatchRasterTriangle> m_Triangles;
+	uint32_t m_NumTriangles{ 0 };
+};
+
+#endif /* OCCLUSION_BUFFER_HPP */
@@ -63,6 +63,7 @@ public:
 	OCTREE_STRADDLING_TYPE& GetStraddleMethod() { return m_StraddleMethod; };
 	int& GetNumObjPerNode() { return m_NumObjPerNode; };
 	entity GetOctreeEnt() { return m_OctreeEnt; };
+	OctTreeNode const& GetRoot() const { return *m_Root; };
 	void ClearTree() { m_Root = std::make_unique<OctTreeNode>(); };
 
 private:
@@ -0,0 +1,148 @@
+/**
+@file    pointkdtree.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the PointKdTree class.
+
+*//*__________________________________________________________________________*/
+
+#ifndef POINTKDTREE_HPP
+#define POINTKDTREE_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cfloat>
+#include <math.hpp>
+#include <graphics/buffer.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct PointKdResult
+ * @brief This struct holds a single result of a point query
+ */
+struct PointKdResult
+{
+	unsigned idx{ ~0u }; // index into the points the tree was built from, ~0u if none
+	float dist2{ FLT_MAX }; // squared distance to the query point
+
+	bool operator<(PointKdResult const& _rhs) const { return dist2 < _rhs.dist2; }
+};
+
+/**
+ * @class PointKdTree
+ * @brief This class is a static k-d tree over points (e.g. mesh vertices) for
+ * nearest neighbour queries. The tree is implicit: points are reordered so that
+ * the median of every range [lo, hi) sits at its middle, no node structs are stored.
+ * Queries do not allocate, results are written into caller provided buffers.
+ */
+class PointKdTree
+{
+
+public:
+
+	/**
+	  * @brief builds the tree from vertex positions, O(n log n)
+	  * @param _vertices - vertices to build from, result indices refer to this array
+	  */
+	void Build(std::vector<Vertex> const& _vertices);
+	/**
+	  * @brief builds the tree from points, O(n log n)
+	  * @param _points - points to build from, result indices refer to this array
+	  */
+	void Build(std::vector<vec3> const& _points);
+	/**
+	  * @brief clears the tree
+	  */
+	void Clear();
+
+	/**
+	  * @brief finds the point closest to _p
+	  * @param _p - query point
+	  * @return closest point, idx is ~0u if tree is empty
+	  */
+	PointKdResult Nearest(vec3 const& _p) const;
+	/**
+	  * @brief finds the _k points closest to _p
+	  * @param _p - query point
+	  * @param _k - number of points to find
+	  * @param _out - buffer of at least _k results, sorted nearest first on return
+	  * @return number of results written, min(_k, Size())
+	  */
+	unsigned KNearest(vec3 const& _p, unsigned _k, PointKdResult* _out) const;
+	/**
+	  * @brief finds points within _radius of _p, in no particular order
+	  * @param _p - query point
+	  * @param _radius - search radius
+	  * @param _out - buffer of at least _maxResults results
+	  * @param _maxResults - capacity of _out, search stops once it is full
+	  * @return number of results written
+	  */
+	unsigned RadiusSearch(vec3 const& _p, float _radius, PointKdResult* _out, unsigned _maxResults) const;
+
+	/**
+	  * @brief Nearest() for every query point, split across threads
+	  * @param _queries - query points
+	  * @param _count - number of query points
+	  * @param _out - buffer of _count results
+	  */
+	void NearestBatch(vec3 const* _queries, unsigned _count, PointKdResult* _out) const;
+	/**
+	  * @brief KNearest() for every query point, split across threads
+	  * @param _queries - query points
+	  * @param _count - number of query points
+	  * @param _k - number of points to find per query
+	  * @param _out - buffer of _count * _k results, query i writes to [i * _k, i * _k + _k)
+	  * @param _outCounts - buffer of _count, number of results written per query
+	  */
+	void KNearestBatch(vec3 const* _queries, unsigned _count, unsigned _k, PointKdResult* _out, unsigned* _outCounts) const;
+	/**
+	  * @brief RadiusSearch() for every query point, split across threads
+	  * @param _queries - query points
+	  * @param _count - number of query points
+	  * @param _radius - search radius
+	  * @param _out - buffer of _count * _maxResults results, query i writes to [i * _maxResults, i * _maxResults + _maxResults)
+	  * @param _maxResults - capacity per query
+	  * @param _outCounts - buffer of _count, number of results written per query
+	  */
+	void RadiusSearchBatch(vec3 const* _queries, unsigned _count, float _radius, PointKdResult* _out, unsigned _maxResults, unsigned* _outCounts) const;
+
+	unsigned Size() const { return static_cast<unsigned>(m_Points.size()); }
+	bool Empty() const { return m_Points.empty(); }
+
+	/**
+	  * @brief returns the tree over all vertices of a loaded mesh, built on first use.
+	  * Result indices refer to the vertices of the mesh's buffers concatenated in order.
+	  * @param _mesh - name of mesh in Renderable::GetBuffers()
+	  */
+	static PointKdTree const& GetMeshTree(std::string const& _mesh);
+	/**
+	  * @brief drops cached mesh trees, call when mesh buffers change
+	  */
+	static void ClearMeshTrees() { s_MeshTrees.clear(); }
+
+private:
+
+	static constexpr unsigned s_MaxDepth = 64; ///< traversal stack size, tree is balanced so depth is log2(n)
+
+	/**
+	  * @brief places the median of [_lo, _hi) along the axis of greatest extent at the middle and recurses
+	  * @param _points - source points
+	  * @param _lo - first index of range
+	  * @param _hi - one past last index of range
+	  */
+	void BuildRange(std::vector<vec3> const& _points, unsigned _lo, unsigned _hi);
+
+	std::vector<vec3> m_Points; ///< points in tree order
+	std::vector<unsigned> m_Indices; ///< original index of each point in tree order
+	std::vector<uint8_t> m_Axes; ///< split axis of the node stored at each index
+
+	static std::unordered_map<std::string, PointKdTree> s_MeshTrees;
+};
+
+#endif /* POINTKDTREE_HPP */
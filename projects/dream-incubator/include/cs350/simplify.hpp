@@ -0,0 +1,57 @@
+/**
+@file    simplify.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of mesh simplification by quadric error
+metric edge collapse and level of detail generation.
+
+*//*__________________________________________________________________________*/
+
+#ifndef SIMPLIFY_HPP
+#define SIMPLIFY_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <graphics/buffer.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static unsigned constexpr MESH_LOD_COUNT = 4; // including the full mesh
+static float constexpr MESH_LOD_RATIO = 0.5f; // triangles of each lod relative to the one before
+static uint32_t constexpr MESH_LOD_MIN_TRIANGLES = 64; // meshes with fewer are not simplified
+static float constexpr MESH_LOD_MAX_ERROR = 0.05f; // relative to the size of the mesh
+
+/**
+ * @brief simplifies a triangle list by collapsing the edge with the least
+ * quadric error until the target is reached. Vertices with the same position
+ * are welded, so seams of split normals or uvs collapse together, and each
+ * collapse moves one vertex onto the other so the result indexes the same
+ * vertices. Collapses that flip a triangle are skipped.
+ * @param _vtx - vertices of mesh
+ * @param _idx - triangle list
+ * @param _targetIndexCount - stop once at or below this many indices
+ * @param _maxError - stop before a collapse moves the surface more than this,
+ * model space distance
+ * @param _error - set to the largest error of the collapses made
+ * @return triangle list indexing _vtx
+ */
+std::vector<uint32_t> SimplifyMesh(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	size_t _targetIndexCount, float _maxError, float& _error);
+
+/**
+ * @brief builds up to MESH_LOD_COUNT lods, each simplified from the one before,
+ * the error of a lod is the sum of the errors of the steps to it so it bounds
+ * its distance to the full mesh. Thread safe.
+ * @param _vtx - vertices of mesh
+ * @param _idx - triangle list of full mesh
+ * @param _lodIdx - set to indices of every lod, lod 0 first
+ * @param _lods - set to range of each lod in _lodIdx, only lod 0 if mesh is too
+ * small or cannot be simplified
+ */
+void GenerateMeshLods(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	std::vector<uint32_t>& _lodIdx, std::vector<Buffer::Lod>& _lods);
+
+#endif /* SIMPLIFY_HPP */
@@ -0,0 +1,115 @@
+/**
+@file    spatialhashgrid.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the SpatialHashGrid broad phase class.
+
+*//*__________________________________________________________________________*/
+
+#ifndef SPATIAL_HASH_GRID_HPP
+#define SPATIAL_HASH_GRID_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <math.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct GridPair
+ * @brief This struct holds 2 boxes whose bounds overlap, index0 < index1
+ */
+struct GridPair
+{
+	uint32_t index0; // index of box passed to Build
+	uint32_t index1;
+};
+
+/**
+ * @class SpatialHashGrid
+ * @brief This class is a uniform grid broad phase for many boxes of similar
+ * size. Each box is put in the one cell holding its center, only occupied cells
+ * are stored in an open addressing table keyed by cell coordinates. Cells are
+ * never smaller than the largest box, so overlapping boxes are always in the
+ * same or a neighbouring cell and both build and pair search are O(n).
+ */
+class SpatialHashGrid
+{
+
+public:
+
+	/**
+	  * @brief sets cell size, raised to the largest box on Build
+	  * @param _cellSize - edge length of a cell
+	  */
+	void SetCellSize(float _cellSize) { m_CellSize = _cellSize; }
+	float GetCellSize() const { return m_CellSize; }
+	/**
+	  * @brief cell size used by the last Build
+	  */
+	float GetBuiltCellSize() const { return m_BuiltCellSize; }
+
+	/**
+	  * @brief rebuilds grid from boxes, boxes are bucketed by a parallel
+	  * counting sort so each cell lists its boxes contiguously in index order
+	  * @param _mins - min of each box
+	  * @param _maxs - max of each box
+	  * @param _count - number of boxes
+	  */
+	void Build(vec3 const* _mins, vec3 const* _maxs, uint32_t _count);
+	/**
+	  * @brief finds every pair of overlapping boxes by testing each cell
+	  * against itself and half of its 26 neighbours, in parallel over cells.
+	  * Order of pairs only depends on the boxes, not on the thread count.
+	  * @return pairs, valid until next call
+	  */
+	std::vector<GridPair> const& FindPairs();
+	/**
+	  * @brief finds boxes overlapping a box
+	  * @param _min - min of box
+	  * @param _max - max of box
+	  * @param _result - indices of boxes, appended
+	  */
+	void Query(vec3 const& _min, vec3 const& _max, std::vector<uint32_t>& _result) const;
+
+	uint32_t GetNumCells() const { return static_cast<uint32_t>(m_CellCoords.size()); }
+
+private:
+
+	/**
+	  * @brief packs cell coordinates into a table key, 21 bits per axis
+	  */
+	static uint64_t CellKey(ivec3 const& _coord);
+	ivec3 CellCoord(vec3 const& _p) const;
+	/**
+	  * @brief dense index of cell, -1 if not occupied
+	  */
+	int FindCell(uint64_t _key) const;
+	/**
+	  * @brief adds pairs between boxes of 2 cells, or within a cell if same
+	  */
+	void CollectPairs(uint32_t _cell0, uint32_t _cell1, std::vector<GridPair>& _pairs) const;
+
+	float m_CellSize{ 1.f };
+	float m_BuiltCellSize{ 1.f };
+	vec3 const* m_Mins{ nullptr };
+	vec3 const* m_Maxs{ nullptr };
+
+	// open addressing table, linear probing, power of 2 size
+	std::vector<uint64_t> m_SlotKeys;
+	std::vector<uint32_t> m_SlotCells; // slot -> dense cell index
+	// dense cells in order of first box in them
+	std::vector<ivec3> m_CellCoords;
+	std::vector<uint32_t> m_CellStarts; // cell -> first of its boxes in m_Sorted, one extra at end
+	std::vector<uint64_t> m_BoxKeys; // box -> key of its cell
+	std::vector<uint32_t> m_BoxCells; // box -> cell
+	std::vector<uint32_t> m_Sorted; // boxes bucketed by cell
+	std::vector<uint32_t> m_ChunkCounts; // per thread histogram of counting sort
+	std::vector<std::vector<GridPair>> m_ThreadPairs;
+	std::vector<GridPair> m_Pairs;
+};
+
+#endif /* SPATIAL_HASH_GRID_HPP */
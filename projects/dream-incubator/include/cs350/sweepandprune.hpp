@@ -0,0 +1,138 @@
+/**
+@file    sweepandprune.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the SweepAndPrune broad phase class.
+
+*//*__________________________________________________________________________*/
+
+#ifndef SWEEP_AND_PRUNE_HPP
+#define SWEEP_AND_PRUNE_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <math.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct SapPair
+ * @brief This struct holds 2 proxies whose boxes overlap, proxy0 < proxy1
+ */
+struct SapPair
+{
+	uint32_t proxy0;
+	uint32_t proxy1;
+};
+
+/**
+ * @class SweepAndPrune
+ * @brief This class is a sweep and prune broad phase over world aabbs. Box
+ * endpoints are kept sorted on each axis and re-sorted with insertion sort
+ * every update, which is close to O(n) when bodies move little between frames.
+ * Every swap of a min past a max changes overlap on that axis, so overlapping
+ * pairs are tracked incrementally from swaps instead of being searched for.
+ */
+class SweepAndPrune
+{
+
+public:
+
+	/**
+	  * @brief adds a box, its pairs are reported by the next Update
+	  * @param _min - min of box
+	  * @param _max - max of box
+	  * @param _userId - id returned by GetUserId, e.g. an entity
+	  * @return proxy of box
+	  */
+	uint32_t CreateProxy(vec3 const& _min, vec3 const& _max, uint32_t _userId);
+	/**
+	  * @brief removes a box, its pairs are reported as removed by the next Update
+	  * and the proxy is reused after it
+	  * @param _proxy - proxy of box
+	  */
+	void DestroyProxy(uint32_t _proxy);
+	/**
+	  * @brief moves a box, pairs change on the next Update
+	  * @param _proxy - proxy of box
+	  * @param _min - min of box
+	  * @param _max - max of box
+	  */
+	void UpdateProxy(uint32_t _proxy, vec3 const& _min, vec3 const& _max);
+	/**
+	  * @brief re-sorts endpoints of moved boxes and updates pairs and pair events
+	  */
+	void Update();
+	/**
+	  * @brief removes all boxes and pairs without reporting events
+	  */
+	void Clear();
+
+	uint32_t GetUserId(uint32_t _proxy) const { return m_Proxies[_proxy].userId; }
+	/**
+	  * @brief all overlapping pairs, unordered
+	  */
+	std::vector<SapPair> const& GetPairs() const { return m_Pairs; }
+	/**
+	  * @brief pairs that started overlapping in the last Update
+	  */
+	std::vector<SapPair> const& GetAddedPairs() const { return m_AddedPairs; }
+	/**
+	  * @brief pairs that stopped overlapping in the last Update, includes pairs
+	  * of destroyed proxies
+	  */
+	std::vector<SapPair> const& GetRemovedPairs() const { return m_RemovedPairs; }
+	/**
+	  * @brief number of endpoint swaps in the last Update, for profiling coherence
+	  */
+	size_t GetNumSwaps() const { return m_NumSwaps; }
+
+private:
+
+	/**
+	 * @struct Endpoint
+	 * @brief This struct holds one end of a box on an axis
+	 */
+	struct Endpoint
+	{
+		float value;
+		uint32_t data; // proxy << 1 | isMax
+	};
+
+	/**
+	 * @struct Proxy
+	 * @brief This struct holds a box and where its endpoints are on each axis
+	 */
+	struct Proxy
+	{
+		vec3 min;
+		vec3 max;
+		uint32_t userId;
+		uint32_t endpoints[3][2]; // index of min and max endpoint per axis
+		bool isAlive;
+	};
+
+	/**
+	  * @brief insertion sort of one axis, adds and removes pairs on swaps
+	  */
+	void SortAxis(int _axis);
+	bool TestOverlap(Proxy const& _a, Proxy const& _b) const;
+	void AddPair(uint32_t _a, uint32_t _b);
+	void RemovePair(uint32_t _a, uint32_t _b);
+
+	std::vector<Endpoint> m_Endpoints[3];
+	std::vector<Proxy> m_Proxies;
+	std::vector<uint32_t> m_FreeProxies;
+	std::vector<uint32_t> m_DestroyedProxies; // freed after their endpoints are sorted out
+	std::vector<SapPair> m_Pairs;
+	std::unordered_map<uint64_t, uint32_t> m_PairIndices; // pair key -> index in m_Pairs
+	std::vector<SapPair> m_AddedPairs;
+	std::vector<SapPair> m_RemovedPairs;
+	size_t m_NumSwaps{ 0 };
+};
+
+#endif /* SWEEP_AND_PRUNE_HPP */
@@ -16,29 +16,21 @@ all OpenGL logic.
 #include <GL/glew.h> 
 #include <iostream> // for debug output to console
 #include <vector>
+#include <algorithm>
 #include <math.hpp>
+#include <graphics/mesharena.hpp>
+#include <graphics/streambuffer.hpp>
+#include <cstring>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
 #define OPENGL_4_5_ABOVE // enable for glCreateBuffers, else glGen 
 
-/**
- * @struct Vertex
- * @brief This struct holds the data for a vertex. pos, nml, clr, uv
- */
-struct Vertex
-{
-	vec3 position;
-	vec3 normal;
-	vec4 color;
-	vec2 uv;
-};
-
 /**
  * @class Buffer
- * @brief This class is responsible for creation and binding of Vertex Buffer Object(VBO),
- * Vertex Array Object(VAO), attribute layout specification, Element Buffer Object(EBO),
- * cleanup of buffer resources.
+ * @brief This class is responsible for a mesh, its vertex and index data kept
+ * on the cpu at full precision and packed into ranges of the MeshArena, and
+ * drawing it with the VAO of its vertex format.
  */
 class Buffer 
 {
@@ -67,6 +59,18 @@ public:
 
 	// TODO: add enum wrappers for faces and blending? 
 
+	/**
+	 * @struct Lod
+	 * @brief This struct holds a level of detail, a range of the index data
+	 * drawn instead of the full mesh
+	 */
+	struct Lod
+	{
+		uint32_t first;	///< first index, or first vertex if not indexed drawing
+		uint32_t count;	///< number of indices or vertices
+		float error;	///< max distance to the full mesh in model space, 0 for lod 0
+	};
+
 	/**
 	 * OpenGL Callbacks
 	 */
@@ -102,15 +106,77 @@ public:
 		}
 	}
 
-	void BindVAO()	 { glBindVertexArray(m_VAO); }
-	void Draw()	
-	{ m_IsIndexedDrawing ? glDrawElements(m_PrimitiveType, m_DrawCount, GL_UNSIGNED_INT, nullptr) : glDrawArrays(m_PrimitiveType, 0, m_DrawCount); };
-	void UnBindVAO() { glBindVertexArray(0); }
+	void BindVAO()	 { MESH_ARENA.BindVAO(GetAllocation().format); }
+	void Draw(uint32_t _lod = 0)
+	{
+		MeshArena::Allocation const& range = GetAllocation();
+		Lod const& lod = m_Lods[_lod];
+		m_IsIndexedDrawing ? glDrawElementsBaseVertex(m_PrimitiveType, lod.count, range.GetIndexType(),
+			reinterpret_cast<void*>(static_cast<size_t>(range.GetIndexSize()) * (range.GetFirstIndex() + lod.first)), range.GetBaseVertex()) :
+			glDrawArrays(m_PrimitiveType, range.GetBaseVertex() + lod.first, lod.count);
+	};
+	void UnBindVAO() { MESH_ARENA.UnBindVAO(); }
+	/**
+	 * @brief draws instances of a lod, VAO must be bound
+	 * @param _instanceCount - number of instances
+	 * @param _baseInstance - first instance in instance buffer
+	 */
+	void DrawInstanced(uint32_t _lod, uint32_t _instanceCount, uint32_t _baseInstance)
+	{
+		MeshArena::Allocation const& range = GetAllocation();
+		Lod const& lod = m_Lods[_lod];
+		m_IsIndexedDrawing ? glDrawElementsInstancedBaseVertexBaseInstance(m_PrimitiveType, lod.count, range.GetIndexType(),
+			reinterpret_cast<void*>(static_cast<size_t>(range.GetIndexSize()) * (range.GetFirstIndex() + lod.first)), _instanceCount, range.GetBaseVertex(), _baseInstance) :
+			glDrawArraysInstancedBaseInstance(m_PrimitiveType, range.GetBaseVertex() + lod.first, lod.count, _instanceCount, _baseInstance);
+	}
+	/**
+	 * @brief indirect command drawing instances of a lod, only for indexed
+	 * drawing, commands of any meshes can be drawn in one call
+	 * @param _instanceCount - number of instances
+	 * @param _baseInstance - first instance in instance buffer
+	 */
+	MeshArena::DrawElementsCommand GetDrawCommand(uint32_t _lod, uint32_t _instanceCount, uint32_t _baseInstance) const
+	{
+		MeshArena::Allocation const& range = GetAllocation();
+		Lod const& lod = m_Lods[_lod];
+		return { lod.count, _instanceCount, range.GetFirstIndex() + lod.first, static_cast<int32_t>(range.GetBaseVertex()), _baseInstance };
+	}
+	bool GetIsIndexedDrawing() const { return m_IsIndexedDrawing; };
+	uint32_t GetMeshId() const { return m_Allocation; }; // unique among live meshes
+	MeshArena::Allocation const& GetAllocation() const { return MESH_ARENA.GetAllocation(m_Allocation); }; // ranges and packing on the gpu
+	mat4 const& GetDecodeMtx() const { return GetAllocation().decodeMtx; }; // model mtx * this for packed positions
 
 	std::vector<Vertex>& GetVertices() { return m_Vertices; };
+	std::vector<uint32_t> const& GetIndices() const { return m_Indices; }; // every lod, empty if not indexed drawing
+	std::vector<Lod> const& GetLods() const { return m_Lods; }; // lod 0 is the full mesh
+	PRIMITIVE_TYPE GetPrimitiveType() const { return m_PrimitiveType; };
 
 	/**
-	 * @brief ctor, sets up buffer
+	 * @brief coarsest lod within an error
+	 * @param _maxError - max distance to the full mesh in model space
+	 */
+	uint32_t SelectLod(float _maxError) const
+	{
+		uint32_t lod = 0;
+		while (lod + 1 < m_Lods.size() && m_Lods[lod + 1].error <= _maxError) { ++lod; }
+		return lod;
+	}
+	/**
+	 * @brief replaces index data with the indices of every lod, only for
+	 * indexed drawing
+	 * @param _idx - indices of every lod, lod 0 first
+	 * @param _lods - range of each lod in _idx, ordered from finest
+	 */
+	void SetLods(std::vector<uint32_t> const& _idx, std::vector<Lod> const& _lods)
+	{
+		if (!m_IsIndexedDrawing || _lods.empty()) { return; }
+		m_Indices = _idx; m_Lods = _lods;
+		MESH_ARENA.SetIndices(m_Allocation, m_Indices);
+	}
+
+	/**
+	 * @brief ctor, packs mesh into the arena in the smallest format that keeps
+	 * what it uses
 	 * @param _vtx - vertex data
 	 * @param _primitiveType - primitive type
 	 * @param _isIndexedDrawing - has indices, if yes provide index data
@@ -118,80 +184,81 @@ public:
 	 */
 	Buffer(std::vector<Vertex> const& _vtx, PRIMITIVE_TYPE _primitiveType,
 		bool _isIndexedDrawing = false, std::vector<uint32_t>* _idx = nullptr) // setup buffer
-		: m_Vertices(_vtx), m_VBO(), m_VAO(), m_EBO(), m_PrimitiveType(_primitiveType),
-		m_DrawCount(static_cast<uint32_t>(_isIndexedDrawing ? _idx->size() : _vtx.size())), m_IsIndexedDrawing(_isIndexedDrawing)
+		: m_Vertices(_vtx), m_Indices(_isIndexedDrawing ? *_idx : std::vector<uint32_t>{}), m_Allocation(MESH_ARENA.Allocate(m_Vertices, m_Indices, MeshArena::SelectFormat(m_Vertices))),
+		m_PrimitiveType(_primitiveType), m_DrawCount(static_cast<uint32_t>(_isIndexedDrawing ? _idx->size() : _vtx.size())), m_IsIndexedDrawing(_isIndexedDrawing)
 	{
+		m_Lods.push_back({ 0, m_DrawCount, 0.f });
+	}
+	/**
+	 * @brief dtor, gives its ranges back to the arena
+	 */
+	~Buffer() { MESH_ARENA.Free(m_Allocation); }
+	Buffer(Buffer const&) = delete;
+	Buffer& operator=(Buffer const&) = delete;
 
-		// create VAO VBO EBO
-#ifdef OPENGL_4_5_ABOVE 
-		glCreateVertexArrays(1, &m_VAO);
-		glBindVertexArray(m_VAO);
+private:
 
-		glCreateBuffers(1, &m_VBO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-		glBufferData(GL_ARRAY_BUFFER, _vtx.size() * sizeof(Vertex), _vtx.data(), GL_STATIC_DRAW);
+	std::vector<Vertex> m_Vertices;
+	std::vector<uint32_t> m_Indices;
+	std::vector<Lod> m_Lods;
+	uint32_t m_Allocation;	///< handle to ranges in mesh arena
+	PRIMITIVE_TYPE m_PrimitiveType;	///< opengl primitive type
+	uint32_t m_DrawCount;		///< the number of elements in the per-vertex data buffers
 
-		if (_isIndexedDrawing) 
-		{
-			glCreateBuffers(1, &m_EBO);
-			glNamedBufferStorage(m_EBO, sizeof(uint32_t) * _idx->size(), reinterpret_cast<GLvoid*>(_idx->data()), GL_DYNAMIC_STORAGE_BIT);
-			glVertexArrayElementBuffer(m_VAO, m_EBO);
-		}
-#else
-		glGenVertexArrays(1, &m_VAO);
-		glBindVertexArray(m_VAO);
+	bool m_IsIndexedDrawing;
+};
 
-		glGenBuffers(1, &m_VBO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-		glBufferData(GL_ARRAY_BUFFER, _vtx.size() * sizeof(Vertex), _vtx.data(), GL_STATIC_DRAW);
+/**
+ * @class BlockBuffer
+ * @brief This class is responsible for the binding point of a uniform or
+ * shader storage block, its data written into a StreamBuffer each upload and
+ * that range bound.
+ */
+class BlockBuffer
+{
+
+public:
 
-		if (_isIndexedDrawing)
+	enum BLOCK_TYPE
+	{
+		UNIFORM_BLOCK	= GL_UNIFORM_BUFFER,
+		STORAGE_BLOCK	= GL_SHADER_STORAGE_BUFFER,
+	};
+
+	/**
+	 * @brief streams data of block and binds it to its binding point, earlier
+	 * draws keep reading what was bound for them
+	 * @param _stream - buffer written this frame
+	 * @param _data - data laid out as the block, std140 for uniform blocks and
+	 * std430 for storage blocks
+	 * @param _size - size in bytes
+	 */
+	void Upload(StreamBuffer& _stream, void const* _data, size_t _size)
+	{
+		if (m_Alignment == 0)
 		{
-			glGenBuffers(1, &m_EBO);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, _idx->size() * sizeof(uint32_t), reinterpret_cast<GLvoid*>(_idx->data()), GL_STATIC_DRAW);
+			GLint alignment;
+			glGetIntegerv(m_Type == UNIFORM_BLOCK ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			m_Alignment = static_cast<uint32_t>(alignment);
 		}
-#endif
-		// attribute layout
-		
-			// pos
-			glEnableVertexAttribArray(0);
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-
-			// nml
-			glEnableVertexAttribArray(1);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(vec3)));
-
-			// clr
-			glEnableVertexAttribArray(2);
-			glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(vec3) * 2));
-
-			// tex coord
-			glEnableVertexAttribArray(3);
-			glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(vec3) * 2 + (sizeof(vec4))));
-
-		UnBindVAO();
+		size_t size = std::max<size_t>(_size, 16);
+		StreamBuffer::Allocation alloc = _stream.Allocate(size, m_Alignment);
+		if (_size) { std::memcpy(alloc.data, _data, _size); }
+		glBindBufferRange(m_Type, m_Binding, alloc.handle, static_cast<GLintptr>(alloc.offset), static_cast<GLsizeiptr>(size));
 	}
+
 	/**
-	 * @brief dtor, cleans up resources
+	 * @brief ctor
+	 * @param _type - type of block
+	 * @param _binding - binding point of block in shader
 	 */
-	~Buffer()
-	{
-		glDeleteBuffers(1, &m_EBO);
-		glDeleteBuffers(1, &m_VBO);
-		glDeleteVertexArrays(1, &m_VAO);
-	}
+	BlockBuffer(BLOCK_TYPE _type, uint32_t _binding) : m_Type(_type), m_Binding(_binding), m_Alignment(0) {};
 
 private:
 
-	std::vector<Vertex> m_Vertices;
-	uint32_t m_VBO;			///< handle to vbo
-	uint32_t m_VAO;			///< handle to vao
-	uint32_t m_EBO;			///< handle to ebo
-	PRIMITIVE_TYPE m_PrimitiveType;	///< opengl primitive type
-	uint32_t m_DrawCount;		///< the number of elements in the per-vertex data buffers
-
-	bool m_IsIndexedDrawing;
+	BLOCK_TYPE m_Type;
+	uint32_t m_Binding;		///< binding point in shader
+	uint32_t m_Alignment;	///< of range offsets, queried on first upload
 };
 
 /**
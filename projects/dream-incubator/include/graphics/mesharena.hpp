@@ -0,0 +1,297 @@
+/**
+@file    mesharena.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the MeshArena class, one vertex and one
+index buffer every mesh is sub-allocated from in a packed format, drawn
+through a VAO per vertex format.
+
+*//*__________________________________________________________________________*/
+
+#ifndef MESH_ARENA_HPP
+#define MESH_ARENA_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <GL/glew.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <math.hpp>
+#include <isingleton.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint32_t constexpr ARENA_VERTEX_UNIT = 12; // bytes, every vertex format is a whole number of units
+static uint32_t constexpr ARENA_INDEX_UNIT = 2; // bytes
+static uint32_t constexpr ARENA_RANGE_ALIGNMENT = 2; // units, ranges are a multiple of the largest vertex and index
+static uint32_t constexpr ARENA_INITIAL_VERTEX_UNITS = 1u << 19;
+static uint32_t constexpr ARENA_INITIAL_INDEX_UNITS = 1u << 21;
+static float constexpr ARENA_MIN_FREE_FRACTION = 0.25f; // pools with less free are never defragmented
+static float constexpr ARENA_MIN_LARGEST_FREE_FRACTION = 0.5f; // defragmented once the largest free range is under this fraction of free
+static uint32_t constexpr ARENA_VERTEX_BINDING = 0; // vertex buffer binding of vertex attributes
+static uint32_t constexpr ARENA_INSTANCE_BINDING = 1; // vertex buffer binding of instance attributes
+
+/**
+ * @struct Vertex
+ * @brief This struct holds the data for a vertex. pos, nml, clr, uv
+ */
+struct Vertex
+{
+	vec3 position;
+	vec3 normal;
+	vec4 color;
+	vec2 uv;
+};
+
+/**
+ * @enum VERTEX_FORMAT
+ * @brief how a mesh's vertices are packed on the gpu. Positions are 16 bit,
+ * quantized to the bounds of the mesh and decoded by its decode mtx, normals
+ * are 10:10:10:2 snorm. Colour and uv are only kept by meshes that use them.
+ */
+enum VERTEX_FORMAT
+{
+	VERTEX_PACKED,			///< position and normal, 12 bytes
+	VERTEX_PACKED_COLOR_UV,	///< and rgba8 colour and uv, 24 bytes
+	VERTEX_FORMAT_TOTAL,
+};
+
+/**
+ * @struct PackedVertex
+ * @brief This struct holds a vertex in VERTEX_PACKED
+ */
+struct PackedVertex
+{
+	uint16_t position[4];	///< unorm of bounds, w unused
+	uint32_t normal;		///< snorm 10:10:10:2, x in the low bits
+};
+
+/**
+ * @struct PackedVertexColorUv
+ * @brief This struct holds a vertex in VERTEX_PACKED_COLOR_UV
+ */
+struct PackedVertexColorUv
+{
+	uint16_t position[4];
+	uint32_t normal;
+	uint32_t color;	///< unorm rgba8, r in the low byte
+	vec2 uv;
+};
+
+/**
+ * @class MeshArena
+ * @brief This class is responsible for the vertex buffer, index buffer and
+ * VAOs shared by every mesh. Meshes get a range of each from a first fit
+ * free list, sorted by offset so freed ranges merge with their neighbours,
+ * and are drawn with their base vertex and first index. Pools are allocated
+ * in units every vertex format and index type is a whole number of, so one
+ * buffer holds them all, with a VAO per vertex format reading it. Meshes
+ * under 65536 vertices get 16 bit indices. Pools double when full and are
+ * compacted into new buffers once their free space is too scattered. Ranges
+ * are found through a handle so meshes do not notice when they move.
+ */
+class MeshArena : public ISingleton<MeshArena>
+{
+
+public:
+
+	/**
+	 * @struct InstanceData
+	 * @brief This struct holds what differs between instances of a batched
+	 * draw, read by the shader as per instance attributes 4 to 8
+	 */
+	struct InstanceData
+	{
+		mat4 modelMtx;
+		uint32_t materialIdx;	///< index into the material storage block
+		uint32_t padding[3];
+	};
+
+	/**
+	 * @struct DrawElementsCommand
+	 * @brief This struct holds an indirect draw, laid out as OpenGL reads it
+	 */
+	struct DrawElementsCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	/**
+	 * @struct Allocation
+	 * @brief This struct holds the ranges of a mesh and how it is packed
+	 */
+	struct Allocation
+	{
+		mat4 decodeMtx;			///< quantized positions to model space
+		uint32_t vertexOffset;	///< in units
+		uint32_t vertexUnits;
+		uint32_t indexOffset;	///< in units
+		uint32_t indexUnits;
+		uint32_t numVertices;
+		uint32_t numIndices;
+		VERTEX_FORMAT format;
+		bool isShortIndices;
+		bool isLive;
+
+		uint32_t GetBaseVertex() const { return vertexOffset * ARENA_VERTEX_UNIT / GetVertexSize(format); }
+		uint32_t GetFirstIndex() const { return indexOffset * ARENA_INDEX_UNIT / GetIndexSize(); }
+		uint32_t GetIndexSize() const { return isShortIndices ? sizeof(uint16_t) : sizeof(uint32_t); }
+		GLenum GetIndexType() const { return isShortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+	};
+
+	/**
+	 * @struct Stats
+	 * @brief This struct holds how full the arena is, in bytes
+	 */
+	struct Stats
+	{
+		uint32_t numMeshes;
+		size_t vertexBytes, vertexCapacity, indexBytes, indexCapacity;
+		size_t unpackedBytes;	///< vertices and indices of every mesh at full size
+		uint32_t numFreeRanges;
+	};
+
+	static uint32_t GetVertexSize(VERTEX_FORMAT _format) { return _format == VERTEX_PACKED ? sizeof(PackedVertex) : sizeof(PackedVertexColorUv); }
+	/**
+	 * @brief smallest format that keeps what a mesh uses, colour and uv are
+	 * only kept if any vertex is not white or has a uv
+	 */
+	static VERTEX_FORMAT SelectFormat(std::vector<Vertex> const& _vtx);
+
+	/**
+	 * @brief packs a mesh and uploads it into free ranges, growing the pools
+	 * if none fit
+	 * @param _vtx - vertex data
+	 * @param _idx - index data relative to the first vertex, empty if not
+	 * indexed drawing
+	 * @param _format - format vertices are packed in
+	 * @return handle to ranges of mesh
+	 */
+	uint32_t Allocate(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx, VERTEX_FORMAT _format);
+	/**
+	 * @brief replaces the index data of a mesh, its vertices stay
+	 */
+	void SetIndices(uint32_t _handle, std::vector<uint32_t> const& _idx);
+	void Free(uint32_t _handle);
+	/**
+	 * @brief true if a pool has enough free space and it is scattered
+	 */
+	bool IsFragmented() const;
+	/**
+	 * @brief copies every live range to the front of new buffers, in the order
+	 * they were in, so free space is one range at the end
+	 */
+	void Defragment();
+	/**
+	 * @brief deletes buffers and VAO while the context is alive, every mesh
+	 * must be freed already
+	 */
+	void Release();
+
+	Allocation const& GetAllocation(uint32_t _handle) const { return m_Allocations[_handle]; }
+	Stats GetStats() const;
+
+	void BindVAO(VERTEX_FORMAT _format) { glBindVertexArray(m_VAOs[_format]); }
+	void UnBindVAO() { glBindVertexArray(0); }
+	/**
+	 * @brief points the instance attributes of every VAO at instance data,
+	 * instance 0 is at the offset
+	 * @param _buffer - handle to buffer holding InstanceData
+	 * @param _offset - in bytes
+	 */
+	void BindInstances(uint32_t _buffer, size_t _offset);
+	/**
+	 * @brief draws commands from an indirect buffer in one call, VAO of their
+	 * format must be bound
+	 * @param _primitiveType - primitive type of every command
+	 * @param _indexType - index type of every command
+	 * @param _buffer - handle to buffer holding DrawElementsCommand
+	 * @param _offset - in bytes, of first command
+	 * @param _count - number of commands
+	 */
+	void MultiDrawIndirect(uint32_t _primitiveType, GLenum _indexType, uint32_t _buffer, size_t _offset, uint32_t _count);
+
+private:
+
+	friend class ISingleton<MeshArena>;
+
+	MeshArena() : m_Vertices{ GL_ARRAY_BUFFER, ARENA_VERTEX_UNIT, ARENA_INITIAL_VERTEX_UNITS },
+		m_Indices{ GL_ELEMENT_ARRAY_BUFFER, ARENA_INDEX_UNIT, ARENA_INITIAL_INDEX_UNITS },
+		m_VAOs{}, m_InstanceVBO(0) {};
+	~MeshArena() {};
+
+	/**
+	 * @struct Range
+	 * @brief This struct holds a free range of a pool, in elements
+	 */
+	struct Range
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/**
+	 * @struct Pool
+	 * @brief This struct holds a buffer sub-allocated in units
+	 */
+	struct Pool
+	{
+		GLenum target;
+		uint32_t unitSize;	///< bytes
+		uint32_t initialCapacity;
+		uint32_t handle{ 0 };
+		uint32_t capacity{ 0 };
+		uint32_t used{ 0 };
+		std::vector<Range> free; // sorted by offset, never adjacent
+	};
+
+	/**
+	 * Helper functions
+	 */
+
+	void Init();
+	/**
+	 * @brief takes the first free range that fits, grows the pool if none do
+	 * @param _count - in units, a multiple of ARENA_RANGE_ALIGNMENT
+	 * @return offset of range in units
+	 */
+	uint32_t AllocateRange(Pool& _pool, uint32_t _count);
+	void FreeRange(Pool& _pool, uint32_t _offset, uint32_t _count);
+	void Upload(Pool& _pool, uint32_t _offset, void const* _data, size_t _bytes);
+	/**
+	 * @brief packs and uploads vertices into the range of a mesh, sets its
+	 * decode mtx
+	 */
+	void UploadVertices(Allocation& _alloc, std::vector<Vertex> const& _vtx);
+	/**
+	 * @brief allocates and uploads indices of a mesh in its index type
+	 */
+	void UploadIndices(Allocation& _alloc, std::vector<uint32_t> const& _idx);
+	/**
+	 * @brief replaces the buffer of a pool with one at least twice as large
+	 * holding the same data
+	 */
+	void Grow(Pool& _pool, uint32_t _minCapacity);
+	/**
+	 * @brief points every VAO at the current buffers, after any is replaced
+	 */
+	void SetupVAO();
+	bool IsFragmented(Pool const& _pool) const;
+
+	Pool m_Vertices;
+	Pool m_Indices;
+	std::vector<Allocation> m_Allocations;
+	std::vector<uint32_t> m_FreeHandles; // of allocations no longer live
+	uint32_t m_VAOs[VERTEX_FORMAT_TOTAL];	///< handle to vao of each format, shared by its meshes
+	uint32_t m_InstanceVBO;	///< handle to one zero instance, read by draws that are not instanced
+};
+
+#define MESH_ARENA MeshArena::GetInstance() // macro for easy access
+
+#endif /* MESH_ARENA_HPP */
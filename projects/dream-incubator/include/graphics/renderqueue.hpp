@@ -0,0 +1,134 @@
+/**
+@file    renderqueue.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the RenderQueue class, draws sorted by
+a 64-bit state key and submitted with redundant state changes left out.
+
+*//*__________________________________________________________________________*/
+
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <vector>
+#include <cstdint>
+#include <graphics/buffer.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief passes in submission order, each with its own polygon mode
+ */
+enum RENDER_PASS
+{
+	PASS_OPAQUE,	///< filled, front to back
+	PASS_WIREFRAME,	///< lines, wireframe meshes and debug volumes
+	RENDER_PASS_TOTAL,
+};
+
+/**
+ * @struct DrawItem
+ * @brief This struct holds a draw waiting in a RenderQueue
+ */
+struct DrawItem
+{
+	uint32_t shader;	///< shader program
+	Buffer* buffer;
+	uint32_t lod;
+	MeshArena::InstanceData instance; ///< model mtx and material, uniforms if drawn alone
+};
+
+/**
+ * @class RenderQueue
+ * @brief This class collects the draws of a viewport, radix sorts them by key
+ * and submits them. The key orders by pass, shader, primitive type, mesh and
+ * lod, depth and material, from most to least significant, so draws sharing
+ * state end up next to each other and draws of a mesh go front to back.
+ * Material is only an index into a storage block and costs no state, so it
+ * only breaks ties of depth. State is only set when it differs from the draw before. Every mesh
+ * is in the MeshArena, so when batching, each run of indexed draws sharing a
+ * pass, shader, primitive type, vertex format and index type is one indirect
+ * call with a command per mesh and lod.
+ */
+class RenderQueue
+{
+
+public:
+
+	// bits of each key field, most significant first
+	static uint32_t constexpr KEY_PASS_BITS = 2;
+	static uint32_t constexpr KEY_SHADER_BITS = 6;
+	static uint32_t constexpr KEY_FORMAT_BITS = 6;	// primitive type, not indexed, vertex format and short indices
+	static uint32_t constexpr KEY_MESH_BITS = 16;
+	static uint32_t constexpr KEY_LOD_BITS = 4;
+	static uint32_t constexpr KEY_DEPTH_BITS = 14;
+	static uint32_t constexpr KEY_MATERIAL_BITS = 16;
+
+	/**
+	 * @struct Stats
+	 * @brief This struct holds what a submit cost
+	 */
+	struct Stats
+	{
+		unsigned numDrawCalls{ 0 };
+		unsigned numStateChanges{ 0 };	///< polygon mode, program and vao binds
+	};
+
+	/**
+	 * @brief packs draw state into a sort key, fields wider than their bits
+	 * only lose sort quality
+	 * @param _pass - pass of draw
+	 * @param _shader - shader program
+	 * @param _mesh - mesh drawn
+	 * @param _lod - lod of mesh
+	 * @param _material - material index
+	 * @param _depth - 0 at the camera to 1 at the far plane
+	 */
+	static uint64_t MakeKey(RENDER_PASS _pass, uint32_t _shader, Buffer const& _mesh, uint32_t _lod, uint32_t _material, float _depth);
+
+	void Clear() { m_Keys.clear(); m_Items.clear(); }
+	void Push(uint64_t _key, DrawItem const& _item) { m_Keys.push_back({ _key, static_cast<uint32_t>(m_Items.size()) }); m_Items.push_back(_item); }
+	/**
+	 * @brief sorts draws by key, stable so equal keys keep push order
+	 */
+	void Sort();
+	/**
+	 * @brief submits sorted draws, leaves polygon mode filled and no program
+	 * in use
+	 * @param _isBatching - draws are instanced and drawn indirect, else each
+	 * draw sets its own uniforms
+	 * @param _vertexTransformLoc - location of model mtx uniform
+	 * @param _materialIdxLoc - location of material index uniform
+	 * @param _isInstancedLoc - location of instanced flag uniform
+	 * @param _stream - buffer instances and indirect commands are written to
+	 */
+	Stats Submit(bool _isBatching, int32_t _vertexTransformLoc, int32_t _materialIdxLoc, int32_t _isInstancedLoc, StreamBuffer& _stream);
+
+	size_t Size() const { return m_Items.size(); }
+
+private:
+
+	/**
+	 * @struct SortEntry
+	 * @brief This struct holds the key of a draw and its index
+	 */
+	struct SortEntry
+	{
+		uint64_t key;
+		uint32_t item; // index into m_Items
+	};
+
+	static RENDER_PASS GetPass(uint64_t _key) { return static_cast<RENDER_PASS>(_key >> (64 - KEY_PASS_BITS)); }
+	static uint64_t GetRun(uint64_t _key) { return _key >> (64 - KEY_PASS_BITS - KEY_SHADER_BITS - KEY_FORMAT_BITS); } // pass, shader and format
+
+	std::vector<SortEntry> m_Keys;
+	std::vector<SortEntry> m_SortScratch;
+	std::vector<DrawItem> m_Items;
+
+	std::vector<MeshArena::DrawElementsCommand> m_Commands; // batching, reused every submit
+};
+
+#endif /* RENDER_QUEUE_HPP */
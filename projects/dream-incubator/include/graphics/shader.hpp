@@ -33,6 +33,15 @@ void UseShader(GLuint _shaderPgm);
 void UnUseShader();
 void DeleteShader(GLuint _shaderPgm);
 
+/**
+ * @brief Location of a uniform, looked up in the locations cached when the program was linked.
+ *
+ * @param _shaderPgm Shader program ID.
+ * @param _name Name of the uniform, struct members as "material.kAmbient".
+ * @return Location, -1 if the program has no such active uniform.
+ */
+GLint GetUniformLocation(GLuint _shaderPgm, std::string const& _name);
+
 void SetUniform(GLuint _shaderPgm, std::string const& _name, int const _val);
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _val);
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _x, float const _y);
@@ -43,3 +52,10 @@ void SetUniform(GLuint _shaderPgm, std::string const& _name, vec3 const& _val);
 void SetUniform(GLuint _shaderPgm, std::string const& _name, vec4 const& _val);
 void SetUniform(GLuint _shaderPgm, std::string const& _name, mat3 const& _val);
 void SetUniform(GLuint _shaderPgm, std::string const& _name, mat4 const& _val);
+
+// by location from GetUniformLocation(), for uniforms set every draw, program must be in use
+void SetUniform(GLint _loc, int const _val);
+void SetUniform(GLint _loc, unsigned const _val);
+void SetUniform(GLint _loc, float const _val);
+void SetUniform(GLint _loc, vec3 const& _val);
+void SetUniform(GLint _loc, mat4 const& _val);
@@ -0,0 +1,123 @@
+/**
+@file    streambuffer.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the StreamBuffer class, a persistently
+mapped ring that data written every frame is bump allocated from.
+
+*//*__________________________________________________________________________*/
+
+#ifndef STREAM_BUFFER_HPP
+#define STREAM_BUFFER_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint32_t constexpr STREAM_FRAMES = 3; // frames the gpu may be behind by
+static size_t constexpr STREAM_INITIAL_FRAME_SIZE = 4u << 20; // bytes
+
+/**
+ * @class StreamBuffer
+ * @brief This class is responsible for a buffer mapped once, persistent and
+ * coherent, split into a region per frame in flight. A frame bump allocates
+ * from its region and writes through the mapping, then fences it, and the
+ * region is only reused once its fence has passed, so the cpu never writes
+ * what the gpu is still reading and no upload respecifies a buffer. A frame
+ * that outgrows its region carries on in a larger buffer. The old one keeps
+ * what the frame already allocated and stays bound where it was, it is only
+ * deleted once a fence after the frame has passed. Created on the first
+ * frame so it can be a member of anything made before the context.
+ */
+class StreamBuffer
+{
+
+public:
+
+	/**
+	 * @struct Allocation
+	 * @brief This struct holds a range written this frame, bind it with the
+	 * buffer handle and offset given here
+	 */
+	struct Allocation
+	{
+		uint32_t handle;	///< handle to buffer, changes when it grows
+		size_t offset;		///< in bytes from the start of the buffer
+		void* data;			///< mapped, write only
+	};
+
+	/**
+	 * @brief waits for the gpu to be done with the region of this frame and
+	 * starts allocating from its start, deletes outgrown buffers it is done with
+	 */
+	void BeginFrame();
+	/**
+	 * @brief fences every draw so far as reading this frame's region
+	 */
+	void EndFrame();
+	/**
+	 * @brief bump allocates from this frame's region, grows if it is full
+	 * @param _size - size in bytes
+	 * @param _alignment - offset is a multiple of it, need not be a power of 2
+	 */
+	Allocation Allocate(size_t _size, size_t _alignment);
+	/**
+	 * @brief allocates and copies data in
+	 */
+	Allocation Upload(void const* _data, size_t _size, size_t _alignment);
+
+	/**
+	 * @brief unmaps and deletes buffer while the context is alive, created
+	 * again on the next frame
+	 */
+	void Release();
+
+	size_t GetFrameSize() const { return m_FrameSize; }; // bytes allocated last frame
+	unsigned GetNumStalls() const { return m_NumStalls; }; // frames that waited on a fence
+
+	StreamBuffer() : m_Handle(0), m_Data(nullptr), m_RegionSize(STREAM_INITIAL_FRAME_SIZE), m_Region(0), m_Offset(0),
+		m_FrameSize(0), m_NumStalls(0), m_Fences{} {};
+	~StreamBuffer();
+	StreamBuffer(StreamBuffer const&) = delete;
+	StreamBuffer& operator=(StreamBuffer const&) = delete;
+
+private:
+
+	/**
+	 * @struct Retired
+	 * @brief This struct holds an outgrown buffer draws may still read
+	 */
+	struct Retired
+	{
+		uint32_t handle;
+		GLsync fence;	///< after the last frame to use it, null until that frame ends
+	};
+
+	/**
+	 * @brief creates and maps a buffer whose regions hold a size, the current
+	 * one must be retired or released already
+	 */
+	void Create(size_t _regionSize);
+	/**
+	 * @brief unmaps and deletes a buffer
+	 */
+	void Delete(uint32_t _handle);
+
+	uint32_t m_Handle;		///< handle to buffer
+	char* m_Data;			///< mapping of whole buffer
+	size_t m_RegionSize;	///< bytes per frame
+	uint32_t m_Region;		///< region of this frame
+	size_t m_Offset;		///< next free byte in region
+	size_t m_FrameSize;
+	unsigned m_NumStalls;
+	GLsync m_Fences[STREAM_FRAMES]; ///< fence of last frame to use each region
+	std::vector<Retired> m_Retired; ///< outgrown buffers not deleted yet
+};
+
+#endif /* STREAM_BUFFER_HPP */
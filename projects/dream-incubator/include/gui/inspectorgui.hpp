@@ -42,6 +42,7 @@ public:
     void DisplayCameraComp();
     void DisplayLightComp();
     void DisplayMeshComp();
+    void DisplayColliderComp();
     void DisplayBVComp();
     void DisplayString(std::string& _str);
     void DisplayFloat(std::string _title, float& _data);
@@ -0,0 +1,33 @@
+/* !
+@file    hash.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains a hash of bytes that is the same on every run and
+compiler, for keys of files cached between runs.
+
+*//*__________________________________________________________________________*/
+
+#ifndef HASH_HPP
+#define HASH_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <cstdint>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint64_t constexpr HASH_BASIS = 14695981039346656037ull; // FNV-1a 64 bit offset basis
+
+/**
+ * @brief FNV-1a of bytes, continuing from _hash
+ */
+static uint64_t HashBytes(void const* _data, size_t _size, uint64_t _hash = HASH_BASIS)
+{
+	unsigned char const* bytes = static_cast<unsigned char const*>(_data);
+	for (size_t i = 0; i < _size; ++i) { _hash = (_hash ^ bytes[i]) * 1099511628211ull; }
+	return _hash;
+}
+
+#endif /* HASH_HPP */
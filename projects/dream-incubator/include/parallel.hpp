@@ -0,0 +1,152 @@
+/* !
+@file    parallel.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains helper functions to split work across threads, run on a
+pool of worker threads made once.
+
+*//*__________________________________________________________________________*/
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <isingleton.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief number of threads available for ParallelFor(), at least 1
+ */
+static unsigned GetNumWorkerThreads()
+{
+	static unsigned const s_NumThreads = std::max(1u, std::thread::hardware_concurrency());
+	return s_NumThreads;
+}
+
+/**
+ * @class WorkerPool
+ * @brief This class is responsible for the threads ParallelFor() runs chunks
+ * on, made on first use and kept until exit so a call costs a wake up rather
+ * than a thread per chunk. Worker i runs chunk i, the caller runs chunk 0. A
+ * call made while the pool is busy, from inside a chunk or another thread,
+ * runs its chunks in order on the calling thread, with the same indices.
+ */
+class WorkerPool : public ISingleton<WorkerPool>
+{
+
+public:
+
+	/**
+	 * @brief calls _invoke(_job, i) for every chunk i in [0, _numChunks) and
+	 * blocks until all are done
+	 */
+	void Run(unsigned _numChunks, void (*_invoke)(void*, unsigned), void* _job)
+	{
+		if (_numChunks > m_Threads.size() + 1 || m_IsBusy.exchange(true))
+		{
+			for (unsigned i = 0; i < _numChunks; ++i) { _invoke(_job, i); }
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Invoke = _invoke; m_Job = _job;
+			m_NumChunks = _numChunks; m_NumPending = _numChunks - 1;
+			++m_Generation;
+		}
+		m_Wake.notify_all();
+		_invoke(_job, 0);
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Done.wait(lock, [this]() { return m_NumPending == 0; });
+		}
+		m_IsBusy = false;
+	}
+
+private:
+
+	friend class ISingleton<WorkerPool>;
+
+	WorkerPool() : m_Invoke(nullptr), m_Job(nullptr), m_NumChunks(0), m_NumPending(0), m_Generation(0), m_IsStopping(false), m_IsBusy(false)
+	{
+		for (unsigned i = 1; i < GetNumWorkerThreads(); ++i) { m_Threads.emplace_back([this, i]() { WorkerLoop(i); }); }
+	}
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_IsStopping = true;
+		}
+		m_Wake.notify_all();
+		for (auto& thread : m_Threads) { thread.join(); }
+	}
+
+	void WorkerLoop(unsigned _chunk)
+	{
+		uint64_t seen = 0;
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (true)
+		{
+			m_Wake.wait(lock, [this, &seen]() { return m_IsStopping || m_Generation != seen; });
+			if (m_IsStopping) { return; }
+			seen = m_Generation;
+			if (_chunk >= m_NumChunks) { continue; }
+			lock.unlock();
+			m_Invoke(m_Job, _chunk);
+			lock.lock();
+			if (--m_NumPending == 0) { m_Done.notify_one(); }
+		}
+	}
+
+	std::vector<std::thread> m_Threads;
+	std::mutex m_Mutex;
+	std::condition_variable m_Wake;	///< a call started or the pool is stopping
+	std::condition_variable m_Done;	///< every worker chunk of the call is done
+	void (*m_Invoke)(void*, unsigned);
+	void* m_Job;
+	unsigned m_NumChunks;
+	unsigned m_NumPending;	///< worker chunks of the call not done yet
+	uint64_t m_Generation;	///< calls started, workers run each once
+	bool m_IsStopping;
+	std::atomic<bool> m_IsBusy;	///< a call is running
+};
+
+#define WORKER_POOL WorkerPool::GetInstance() // macro for easy access
+
+/**
+ * @brief splits [0, _count) into contiguous chunks, one per thread, and calls
+ * _func(begin, end, chunkIdx) for each chunk on the WorkerPool. Blocks until
+ * every chunk is done. The calling thread runs the first chunk.
+ * @param _count - number of items
+ * @param _func - callable taking (unsigned begin, unsigned end, unsigned chunkIdx),
+ * chunkIdx is below GetNumWorkerThreads() and no two chunks share one
+ * @param _minChunk - minimum items per thread, small workloads run on the calling thread
+ * @return number of chunks the work was split into
+ */
+template <typename Func>
+static unsigned ParallelFor(unsigned _count, Func&& _func, unsigned _minChunk = 256)
+{
+	if (_count == 0) { return 0; }
+	unsigned numChunks = std::min(GetNumWorkerThreads(), (_count + _minChunk - 1) / std::max(_minChunk, 1u));
+	if (numChunks <= 1) { _func(0u, _count, 0u); return 1; }
+
+	unsigned chunkSize = (_count + numChunks - 1) / numChunks;
+	auto chunk = [&_func, chunkSize, _count](unsigned _i)
+	{
+		unsigned begin = std::min(_i * chunkSize, _count);
+		_func(begin, std::min(begin + chunkSize, _count), _i);
+	};
+	WORKER_POOL.Run(numChunks, [](void* _job, unsigned _i) { (*static_cast<decltype(chunk)*>(_job))(_i); }, &chunk);
+	return numChunks;
+}
+
+#endif /* PARALLEL_HPP */
@@ -13,9 +13,84 @@ This file contains the declaration of the Collision system class.
 ----------------------------------------------------------------------------- */
 
 #include <systems/isystem.hpp>
+#include <cs350/gjk.hpp>
+#include <cs350/sweepandprune.hpp>
+#include <cs350/spatialhashgrid.hpp>
+#include <cs350/contactmanifold.hpp>
+#include <components/boundingvolume.hpp>
+#include <components/collider.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
+enum BROAD_PHASE_TYPE
+{
+    BROAD_PHASE_SAP, // incremental, best when bodies move little per frame
+    BROAD_PHASE_HASH_GRID, // rebuilt each frame, best for swarms of similar size
+    BROAD_PHASE_TYPE_TOTAL
+};
+
+/**
+ * @struct ColliderEntry
+ * @brief This struct holds a collider gathered for pair tests this frame
+ */
+struct ColliderEntry
+{
+    uint32_t id; // entity
+    Collider* col;
+    Transform* xform;
+    ConvexShape shape;
+    bool hasShape; // shape has a support function
+    bool isBounded; // rays and planes are infinite and skip the broad phase
+    bool hasMoved; // model matrix changed since last frame
+};
+
+enum CONTACT_EVENT_TYPE
+{
+    CONTACT_BEGIN,
+    CONTACT_STAY,
+    CONTACT_END,
+    CONTACT_EVENT_TYPE_TOTAL
+};
+
+/**
+ * @struct ContactEvent
+ * @brief This struct holds a change of contact state of a pair this frame
+ */
+struct ContactEvent
+{
+    uint32_t id0; // entity, id0 < id1
+    uint32_t id1;
+    CONTACT_EVENT_TYPE type;
+    ContactManifold manifold; // normal from id0 towards id1, no points on end or if only the swept test hit
+};
+
+/**
+ * @struct PairCache
+ * @brief This struct holds what persists of a pair across frames while the
+ * broad phase keeps reporting it
+ */
+struct PairCache
+{
+    GjkCache gjk; // last simplex if pair goes through GJK
+    ContactManifold manifold; // from lower entity towards higher, valid while touching
+    float toi{ -1.f }; // time of impact if only the swept test hit
+    bool isTouching{ false };
+    bool wasTouching{ false }; // touching last frame, for begin/stay/end
+    uint32_t frame{ 0 }; // frame pair was last reported
+};
+
+/**
+ * @struct CandidatePair
+ * @brief This struct holds a pair reported by the broad phase for the narrow phase
+ */
+struct CandidatePair
+{
+    uint32_t entry0; // index in colliders gathered this frame, lower entity
+    uint32_t entry1;
+    PairCache* cache;
+    bool isUnchanged; // neither transform changed since last test, test is skipped
+};
+
 /**
  * @class Collision
  * @brief This class is responsible for checking intersection between geometry primitives.
@@ -36,7 +111,66 @@ public:
     Collision() {};
     ~Collision() {};
 
+    static BROAD_PHASE_TYPE& GetBroadPhaseType() { return s_BroadPhaseType; }
+    static float& GetGridCellSize() { return s_GridCellSize; } ///< 0 fits cells to the largest collider
+
+    /**
+      * @brief begin/stay/end of every touching pair this frame, in pair order
+      */
+    std::vector<ContactEvent> const& GetContactEvents() const { return m_ContactEvents; }
+
 private:
+
+    /**
+      * @brief keeps a proxy per bounded collider and adds the pairs it reports
+      * to candidate pairs
+      */
+    void SweepAndPruneBroadPhase();
+    /**
+      * @brief rebuilds the hash grid over bounded colliders and adds its pairs
+      * to candidate pairs
+      */
+    void HashGridBroadPhase();
+    /**
+      * @brief adds a candidate pair, finds or makes its pair cache
+      */
+    void AddCandidatePair(uint32_t _entry0, uint32_t _entry1);
+    /**
+      * @brief tests candidate pairs in chunks across threads, hits are merged in
+      * pair order and only then written to transforms, colliders and events
+      */
+    void NarrowPhase();
+    /**
+      * @brief erases pair cache of a pair the broad phase stopped reporting,
+      * ends its contact if touching
+      */
+    void DropPairCache(std::unordered_map<uint64_t, PairCache>::iterator _it);
+
+    // colliders gathered for pair tests, reused every frame
+    std::vector<ColliderEntry> m_Colliders;
+    std::vector<uint32_t> m_Bounded; // index in m_Colliders of colliders with world bounds
+    std::vector<uint32_t> m_Unbounded; // index in m_Colliders of rays and planes
+    std::vector<mat4> m_ColliderMtxs; // by entity index, model matrix last frame
+    BROAD_PHASE_TYPE m_ActiveBroadPhase{ BROAD_PHASE_TYPE_TOTAL };
+    // broad phase over swept world bounds, proxies persist while their entity has a bounded collider
+    SweepAndPrune m_Sap;
+    std::unordered_map<uint32_t, uint32_t> m_SapProxies; // entity -> proxy
+    std::vector<uint32_t> m_ProxyEntries; // proxy -> index in m_Colliders, ~0 if not seen this frame
+    // uniform grid rebuilt from bounds of m_Bounded every frame
+    SpatialHashGrid m_Grid;
+    std::vector<vec3> m_GridMins;
+    std::vector<vec3> m_GridMaxs;
+    // narrow phase input and per thread output, reused every frame
+    std::vector<CandidatePair> m_CandidatePairs;
+    std::vector<std::vector<uint32_t>> m_ThreadHits; // candidate pairs touching or no longer touching
+    std::vector<ContactEvent> m_ContactEvents;
+
+    // keyed by both entity ids, dropped on the first frame the pair is not a candidate
+    std::unordered_map<uint64_t, PairCache> m_PairCaches;
+    uint32_t m_Frame{ 0 };
+
+    static BROAD_PHASE_TYPE s_BroadPhaseType;
+    static float s_GridCellSize;
 };
 
 #endif /* COLLISION_SYSTEM_HPP */
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+@file    culling.hpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of the Culling system class.
+
+*//*__________________________________________________________________________*/
+
+#ifndef CULLING_SYSTEM_HPP
+#define CULLING_SYSTEM_HPP
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+
+#include <systems/isystem.hpp>
+#include <cs350/intersectionbatch.hpp>
+#include <cs350/occlusionbuffer.hpp>
+#include <components/boundingvolume.hpp>
+#include <components/camera.hpp>
+#include <components/visibleset.hpp>
+#include <unordered_map>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @class Culling
+ * @brief This class is responsible for finding what every camera with a
+ * framebuffer can see. Bounding volumes are gathered once per frame and
+ * classified against each camera's frustum in batches. Results are cached per
+ * camera, only bounding volumes that moved are retested while the camera is
+ * still, and those outside last frame try the plane that rejected them first.
+ * Octree cells whose HLOD proxy is off by less than a pixel tolerance are
+ * drawn as the proxy instead of their meshes. Meshes inside the frustum that
+ * project to too few pixels are dropped, the rest are tested against a
+ * software depth buffer of occluder meshes. The result is written to the
+ * camera's VisibleSet for Render.
+ */
+class Culling : public ISystem
+{
+
+public:
+
+    void Init() override;
+    /**
+     * @brief Culls every camera with a framebuffer, must run before Render.
+     */
+    void Update() override;
+    void CleanUp() override;
+
+    /*
+     * Ctors and Dtor.
+     */
+
+    Culling() {};
+    ~Culling() {};
+
+    /**
+      * @brief marks the meshes with the largest bounds as occluders, meshes with
+      * too many triangles to rasterize every frame are skipped
+      * @param _count - max number of occluders
+      */
+    static void SelectOccluders(unsigned _count);
+
+    /**
+      * @brief local bounds of every buffer of a mesh type, computed once per type
+      */
+    static std::pair<vec3, vec3> const& GetMeshBounds(std::string const& _meshType);
+
+    /**
+      * @brief bounding volumes of an entity were rebuilt where its transform
+      * did not move, as trees do, their cached results are dropped next frame
+      */
+    static void InvalidateBVs(entt::entity _ent);
+
+    static bool& GetIsOcclusionCulling() { return s_IsOcclusionCulling; }
+    static float& GetContributionThreshold() { return s_ContributionThreshold; }
+    static float& GetDetailThreshold() { return s_DetailThreshold; }
+    static bool& GetIsUsingHlod() { return s_IsUsingHlod; }
+    static float& GetHlodPixelError() { return s_HlodPixelError; }
+
+private:
+
+    /**
+     * @struct BVEntry
+     * @brief This struct holds a gathered bounding volume and its entity
+     */
+    struct BVEntry
+    {
+        entt::entity ent;
+        BoundingVolume* bv;
+    };
+
+    /**
+     * @struct CameraCache
+     * @brief This struct holds what a camera saw last frame
+     */
+    struct CameraCache
+    {
+        mat4 vp{ 0.f }; // vp results were made with
+        uint64_t bvVersion{ ~0ull }; // m_BVVersion results were made for, never a valid version at first
+        std::vector<int8_t> results; // SIDE_RESULT of each gathered bounding volume
+        std::vector<int8_t> planes; // frustum plane that rejected each bounding volume, -1 if not outside
+
+        // occlusion input and result
+        std::vector<entt::entity> frustumMeshes;
+        std::vector<entt::entity> occluders;
+        std::vector<entt::entity> meshes;
+        std::vector<float> screenSizes;
+        unsigned numOccluderTriangles{ 0 };
+        bool isOcclusionValid{ false };
+    };
+
+    /**
+      * @brief compares every model matrix against last frame's, the only way to
+      * tell what moved as Transform::isDirty is only cleared by the inspector
+      */
+    void GatherMoved();
+    /**
+      * @brief gathers active bounding volumes of every entity and which of them
+      * moved, a change in the set of bounding volumes invalidates every cache
+      */
+    void GatherBVs();
+    /**
+      * @brief adds a gathered bounding volume to the batch of its type
+      */
+    void QueueFrustumTest(uint32_t _idx);
+    /**
+      * @brief classifies gathered bounding volumes against a camera frustum
+      * and fills its visible set, cached results are kept where nothing moved
+      * @param _camEnt - camera entity, key of its cache
+      * @param _cam - camera, its vp is up to date
+      * @param _fbSize - size of camera's framebuffer in pixels
+      * @param _visible - visible set of camera, cleared first
+      * @param _isMain - main camera also writes each bounding volume's vfc for colouring
+      */
+    void CullCamera(entt::entity _camEnt, Camera const& _cam, vec2 const& _fbSize, VisibleSet& _visible, bool _isMain);
+    /**
+      * @brief walks the HLOD cells top down, a cell in the frustum whose proxy
+      * is close enough is drawn as the proxy and its meshes are marked covered
+      * @param _cam - camera, its vp is up to date
+      * @param _frustum - planes of camera
+      * @param _fbHeight - height of camera's framebuffer in pixels
+      * @param _visible - visible set of camera, proxies are added
+      */
+    void SelectProxies(Camera const& _cam, BatchFrustum const& _frustum, float _fbHeight, VisibleSet& _visible);
+    /**
+      * @brief rasterizes occluders in a visible set and removes the meshes
+      * hidden behind them
+      * @param _cam - camera, its vp is up to date
+      * @param _visible - visible set of camera after frustum culling
+      * @param _cache - cache of camera, last result is reused if nothing changed
+      * @param _isStatic - camera and every mesh are where they were last frame
+      */
+    void OcclusionCull(Camera const& _cam, VisibleSet& _visible, CameraCache& _cache, bool _isStatic);
+
+    // bounding volumes gathered for frustum tests
+    std::vector<BVEntry> m_BVs;
+    std::vector<BVEntry> m_GatheredBVs; // this frame, swapped in if it differs
+    std::vector<uint8_t> m_IsBVDirty; // transform of bounding volume moved this frame
+    std::vector<mat4> m_Mtxs; // by entity index, model matrix last frame
+    std::vector<uint8_t> m_HasMoved; // by entity index, model matrix changed or bvs invalidated this frame
+    bool m_IsMeshMoved{ false }; // some mesh moved this frame
+    uint64_t m_BVVersion{ 0 }; // bumped when m_BVs changes
+    std::unordered_map<entt::entity, CameraCache> m_CameraCaches;
+
+    // bounding volumes to retest this frame by type, reused every frame
+    AabbSoA m_Aabbs;
+    SphereSoA m_Spheres;
+    ObbSoA m_Obbs;
+    std::vector<uint32_t> m_AabbBVs; // index in m_BVs of each aabb
+    std::vector<uint32_t> m_SphereBVs;
+    std::vector<uint32_t> m_ObbBVs;
+    std::vector<int8_t> m_BatchResults;
+    std::vector<uint8_t> m_IsOutside; // by entity index, some bounding volume is outside
+
+    // hlod, reused every frame
+    std::vector<uint32_t> m_HlodStack;
+    std::vector<uint8_t> m_IsInProxy; // by entity index, drawn by a selected proxy
+
+    // occlusion culling, reused every frame
+    OcclusionBuffer m_Occlusion;
+    std::vector<entt::entity> m_OccluderEnts;
+    std::vector<OccluderMesh> m_Occluders;
+    std::vector<vec3> m_MeshMins; // world bounds of each mesh in the visible set
+    std::vector<vec3> m_MeshMaxs;
+    std::vector<uint8_t> m_IsOccluded;
+
+    static bool s_IsOcclusionCulling;
+    static float s_ContributionThreshold; // pixels, meshes projecting to less are culled
+    static float s_DetailThreshold; // pixels, meshes projecting to less are drawn as their bounds
+    static bool s_IsUsingHlod;
+    static float s_HlodPixelError; // pixels, proxies projecting their error to less are drawn
+    static std::vector<uint8_t> s_IsBVInvalid; // by entity index, see InvalidateBVs()
+};
+
+#endif /* CULLING_SYSTEM_HPP */
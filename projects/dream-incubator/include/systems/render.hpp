@@ -13,9 +13,14 @@ This file contains the declaration of the Render system class.
 ----------------------------------------------------------------------------- */
 
 #include <systems/isystem.hpp>
+#include <graphics/buffer.hpp>
+#include <graphics/renderqueue.hpp>
+#include <vector>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
+static char constexpr MODEL_CACHE_DIR[] = "../modelcache/"; // optimised meshes of imported models
+
 /**
  * @class Render
  * @brief This is the class for Render system.
@@ -26,8 +31,9 @@ class Render : public ISystem
 public:
 
     /**
-     * @brief Loads shaders, creates primitive meshes, loads models using assimp 
-     * and creates bounding volumes for models loaded.
+     * @brief Loads shaders, creates primitive meshes, loads models using assimp
+     * or from the model cache, optimises their triangle order, simplifies them
+     * into lods and creates bounding volumes for models loaded.
      */
     void Init() override;
     /**
@@ -43,7 +49,61 @@ public:
     Render()  {};
     ~Render() {};
 
+    static bool& GetIsUsingLods() { return s_IsUsingLods; }
+    static float& GetLodPixelError() { return s_LodPixelError; }
+    static bool& GetIsBatching() { return s_IsBatching; }
+    static StreamBuffer const& GetStream() { return s_Stream; }
+
 private:
+
+    /**
+     * @struct FrameBlock
+     * @brief This struct holds the shader's Frame uniform block, std140
+     */
+    struct FrameBlock
+    {
+        mat4 viewMtx;
+        mat4 projMtx;
+        vec3 lightPosition;
+        int lightType;
+        vec3 lightColor;
+        float lightIntensity;
+        vec3 lightDirection;
+        float lightRange;
+        float lightAngle;
+        float padding[3];
+    };
+
+    /**
+     * @struct MaterialData
+     * @brief This struct holds an element of the shader's Materials storage
+     * block, std430
+     */
+    struct MaterialData
+    {
+        vec3 kAmbient;
+        float shininess;
+        vec3 kDiffuse;
+        float padding;
+        vec3 kSpecular;
+        float padding1;
+    };
+
+    // shader data, reused every camera
+    BlockBuffer m_FrameBlock{ BlockBuffer::UNIFORM_BLOCK, 0 };
+    BlockBuffer m_MaterialBlock{ BlockBuffer::STORAGE_BLOCK, 1 };
+    std::vector<MaterialData> m_Materials; // indexed by materialIdx of each draw
+    int32_t m_VertexTransformLoc{ -1 };
+    int32_t m_MaterialIdxLoc{ -1 };
+    int32_t m_IsInstancedLoc{ -1 };
+
+    RenderQueue m_Queue; // reused every camera
+
+    static StreamBuffer s_Stream; // blocks, instances and indirect commands of every camera this frame
+
+    static bool s_IsUsingLods;
+    static float s_LodPixelError; // pixels, coarsest lod whose error projects to less is drawn
+    static bool s_IsBatching; // draws sharing a buffer are drawn instanced instead of one call each
 };
 
 #endif /* RENDER_SYSTEM_HPP */
\ No newline at end of file
@@ -1,8 +1,8 @@
-#version 410 core
+#version 430 core
 
 layout(location=0) out vec4 FragColor;
 
-struct Material // use std140
+struct Material // use std430
 {
     vec3 kAmbient;
     float shininess;        
@@ -12,7 +12,7 @@ struct Material // use std140
     float padding1;  
 };
 
-struct Light
+struct Light // use std140
 {
 	vec3 position;
 	int type; // point = 0, directional = 1, spot = 2
@@ -25,11 +25,21 @@ struct Light
 
 in vec3 pos;
 in vec3 nml;
+flat in uint matIdx;
 
-uniform Material material;
-uniform mat4 viewMtx;       
-uniform int numLights;
-uniform Light light;
+// set once per viewport
+layout(std140, binding = 0) uniform Frame
+{
+    mat4 viewMtx;
+    mat4 projMtx;
+    Light light;
+};
+
+// every material drawn in a viewport, indexed per draw
+layout(std430, binding = 1) readonly buffer Materials
+{
+    Material materials[];
+};
 
 
 vec3 BlinnPhong(vec3 position, vec3 normal, Light light, Material material, mat4 view)
@@ -72,5 +82,5 @@ vec3 BlinnPhong(vec3 position, vec3 normal, Light light, Material material, mat4
 
 void main() 
 {
-    FragColor = vec4(BlinnPhong(pos, normalize(nml), light, material, viewMtx), 1.0f);
+    FragColor = vec4(BlinnPhong(pos, normalize(nml), light, materials[matIdx], viewMtx), 1.0f);
 }
\ No newline at end of file
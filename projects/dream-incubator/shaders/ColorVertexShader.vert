@@ -1,21 +1,46 @@
-#version 410 core
+#version 430 core
 
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec4 aColor;
 layout(location = 3) in vec2 aTexCoord;
 
+// per instance, read when batched
+layout(location = 4) in mat4 aModelMtx;
+layout(location = 8) in uint aMaterialIdx;
+
+struct Light // use std140
+{
+	vec3 position;
+	int type; // point = 0, directional = 1, spot = 2
+	vec3 color;
+	float intensity;
+	vec3 direction; ///< if dir
+	float range; ///< if point/spot
+	float angle; ///< if spot
+};
+
+// set once per viewport
+layout(std140, binding = 0) uniform Frame
+{
+    mat4 viewMtx;
+    mat4 projMtx;
+    Light light;
+};
+
+// set per draw when not batched
 uniform mat4 vertexTransform;
+uniform uint materialIdx;
+uniform bool isInstanced;
 
 out vec3 pos;
 out vec3 nml;
-
-uniform mat4 viewMtx;
-uniform mat4 projMtx;
+flat out uint matIdx;
 
 void main()
 {
-    mat4 mdlViewMtx = viewMtx * vertexTransform; 
+    mat4 mdlViewMtx = viewMtx * (isInstanced ? aModelMtx : vertexTransform); 
+    matIdx = isInstanced ? aMaterialIdx : materialIdx;
 
     mat3 nmlMtx = mat3(vec3(mdlViewMtx[0]), vec3(mdlViewMtx[1]), vec3(mdlViewMtx[2])); 
     nml = normalize(nmlMtx * aNormal);
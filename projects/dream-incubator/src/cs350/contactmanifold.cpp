@@ -0,0 +1,183 @@
+/**
+@file    contactmanifold.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of contact manifolds and the contact
+generation functions of primitive pairs.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/contactmanifold.hpp>
+#include <cs350/intersectiontests.hpp>
+#include <algorithm>
+#include <cfloat>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+void ContactManifold::AddPoint(vec3 const& _position, float _depth)
+{
+	if (count >= MAX_MANIFOLD_POINTS) { return; }
+	points[count++] = ContactPoint{ _position, _depth, 0 };
+}
+
+float ContactManifold::GetMaxDepth() const
+{
+	float depth = 0.f;
+	for (int i = 0; i < count; ++i) { depth = max(depth, points[i].depth); }
+	return depth;
+}
+
+void MatchContacts(ContactManifold const& _old, ContactManifold& _new)
+{
+	// normal flipped, the shapes swapped sides and every contact is new
+	if (dot(_old.normal, _new.normal) < 0.f) { return; }
+	float constexpr maxDistSq = CONTACT_MATCH_DISTANCE * CONTACT_MATCH_DISTANCE;
+	for (int i = 0; i < _new.count; ++i)
+	{
+		int best = -1; float bestDistSq = maxDistSq;
+		for (int j = 0; j < _old.count; ++j)
+		{
+			vec3 d = _new.points[i].position - _old.points[j].position;
+			float distSq = dot(d, d);
+			if (distSq <= bestDistSq) { best = j; bestDistSq = distSq; }
+		}
+		if (best >= 0) { _new.points[i].age = _old.points[best].age + 1; }
+	}
+}
+
+/**
+ * @brief single point halfway between the deepest point of A along the normal
+ * and the deepest point of B against it
+ */
+static bool SetSingleContact(vec3 const& _normal, vec3 const& _deepestA, vec3 const& _deepestB, ContactManifold& _manifold)
+{
+	_manifold.normal = _normal;
+	_manifold.AddPoint(0.5f * (_deepestA + _deepestB), max(0.f, dot(_deepestA - _deepestB, _normal)));
+	return true;
+}
+
+/**
+ * @brief axis of aabb face nearest to a point inside it
+ * @return normal that moves the aabb off the point, distance to that face
+ */
+static std::pair<vec3, float> NearestAabbFace(vec3 const& _p, vec3 const& _min, vec3 const& _max)
+{
+	vec3 normal = vec3(0); float dist = FLT_MAX;
+	for (int i = 0; i < 3; ++i)
+	{
+		// leaving through max face means the box moves towards -axis
+		if (_max[i] - _p[i] < dist) { dist = _max[i] - _p[i]; normal = vec3(0); normal[i] = -1.f; }
+		if (_p[i] - _min[i] < dist) { dist = _p[i] - _min[i]; normal = vec3(0); normal[i] = 1.f; }
+	}
+	return { normal, dist };
+}
+
+bool ContactSphereSphere(vec3 const& _c1, float _r1, vec3 const& _c2, float _r2, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	vec3 d = _c2 - _c1;
+	float distSq = dot(d, d);
+	if (distSq > (_r1 + _r2) * (_r1 + _r2)) { return false; }
+	float dist = sqrt(distSq);
+	// concentric spheres have no preferred direction
+	vec3 normal = dist > cEpsilon ? d / dist : vec3(0, 1, 0);
+	return SetSingleContact(normal, _c1 + normal * _r1, _c2 - normal * _r2, _manifold);
+}
+
+bool ContactSphereAabb(vec3 const& _c, float _r, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	vec3 q = clamp(_c, _min, _max);
+	vec3 d = q - _c;
+	float distSq = dot(d, d);
+	if (distSq > _r * _r) { return false; }
+	if (distSq > cEpsilon * cEpsilon)
+	{
+		vec3 normal = d / sqrt(distSq);
+		return SetSingleContact(normal, _c + normal * _r, q, _manifold);
+	}
+	// center inside box, pushed out through the nearest face
+	auto [normal, dist] = NearestAabbFace(_c, _min, _max);
+	return SetSingleContact(normal, _c + normal * _r, _c - normal * dist, _manifold);
+}
+
+bool ContactAabbAabb(vec3 const& _min1, vec3 const& _max1, vec3 const& _min2, vec3 const& _max2, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	vec3 lo = max(_min1, _min2), hi = min(_max1, _max2);
+	vec3 overlap = hi - lo;
+	if (overlap.x < 0.f || overlap.y < 0.f || overlap.z < 0.f) { return false; }
+
+	int axis = 0;
+	for (int i = 1; i < 3; ++i) { if (overlap[i] < overlap[axis]) { axis = i; } }
+	_manifold.normal = vec3(0);
+	_manifold.normal[axis] = (_min2[axis] + _max2[axis]) >= (_min1[axis] + _max1[axis]) ? 1.f : -1.f;
+
+	// corners of the overlap rectangle, on the middle of the overlap along the normal
+	int u = (axis + 1) % 3, v = (axis + 2) % 3;
+	int numU = overlap[u] > cEpsilon ? 2 : 1, numV = overlap[v] > cEpsilon ? 2 : 1;
+	for (int i = 0; i < numU; ++i)
+	{
+		for (int j = 0; j < numV; ++j)
+		{
+			vec3 p;
+			p[axis] = 0.5f * (lo[axis] + hi[axis]);
+			p[u] = i == 0 ? lo[u] : hi[u];
+			p[v] = j == 0 ? lo[v] : hi[v];
+			_manifold.AddPoint(p, overlap[axis]);
+		}
+	}
+	return true;
+}
+
+bool ContactPointSphere(vec3 const& _p, vec3 const& _c, float _r, ContactManifold& _manifold)
+{
+	return ContactSphereSphere(_p, 0.f, _c, _r, _manifold);
+}
+
+bool ContactPointAabb(vec3 const& _p, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	if (!OverlapPointAabb(_p, _min, _max)) { return false; }
+	auto [normal, dist] = NearestAabbFace(_p, _min, _max);
+	return SetSingleContact(normal, _p, _p - normal * dist, _manifold);
+}
+
+bool ContactPlaneSphere(vec3 const& _n, float _d, vec3 const& _c, float _r, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	vec3 n = normalize(_n);
+	float dist = dot(n, _c) - _d;
+	if (abs(dist) > _r) { return false; }
+	vec3 normal = dist >= 0.f ? n : -n;
+	return SetSingleContact(normal, _c - normal * abs(dist), _c - normal * _r, _manifold);
+}
+
+bool ContactPlaneAabb(vec3 const& _n, float _d, vec3 const& _min, vec3 const& _max, ContactManifold& _manifold)
+{
+	_manifold.count = 0;
+	vec3 n = normalize(_n);
+	vec3 c = 0.5f * (_min + _max), e = 0.5f * (_max - _min);
+	float dist = dot(n, c) - _d;
+	if (abs(dist) > dot(e, abs(n))) { return false; }
+	vec3 normal = dist >= 0.f ? n : -n;
+	_manifold.normal = normal;
+
+	// corners past the plane, deepest first
+	std::pair<float, vec3> corners[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		vec3 p = vec3(i & 1 ? _max.x : _min.x, i & 2 ? _max.y : _min.y, i & 4 ? _max.z : _min.z);
+		corners[i] = { dot(normal, p) - dot(normal, n) * _d, p };
+	}
+	std::sort(std::begin(corners), std::end(corners), [](auto const& _a, auto const& _b) { return _a.first < _b.first; });
+	for (int i = 0; i < MAX_MANIFOLD_POINTS; ++i)
+	{
+		auto const& [height, p] = corners[i];
+		// only touching, keep the one corner on the plane
+		if (height > 0.f && i > 0) { break; }
+		_manifold.AddPoint(p - normal * (0.5f * height), max(0.f, -height));
+	}
+	return true;
+}
@@ -0,0 +1,232 @@
+/**
+@file    convexhull.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of Quickhull.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/convexhull.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cfloat>
+#include <cmath>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+std::unordered_map<std::string, ConvexHull> ConvexHull::s_Hulls;
+
+/**
+ * @struct HullFace
+ * @brief This struct holds a face of the hull being built and the points outside it
+ */
+struct HullFace
+{
+	unsigned v[3];
+	double n[3]; // plane is kept in double, thin faces far from origin lose too much in float
+	double d;
+	std::vector<unsigned> outside; // points in front of face
+	bool isAlive{ true };
+	unsigned visitId{ 0 };
+};
+
+/**
+ * @brief key of directed edge _a -> _b
+ */
+static uint64_t HullEdgeKey(unsigned _a, unsigned _b) { return (static_cast<uint64_t>(_a) << 32) | _b; }
+
+/**
+ * @brief signed distance of point to face
+ */
+static double HullFaceDist(HullFace const& _face, vec3 const& _p)
+{
+	return _face.n[0] * _p.x + _face.n[1] * _p.y + _face.n[2] * _p.z - _face.d;
+}
+
+/**
+ * @brief returns hull of only the extreme points, used for degenerate input
+ */
+static ConvexHull CreateDegenerateHull(std::vector<vec3> const& _points, std::vector<unsigned> const& _extremes)
+{
+	ConvexHull hull;
+	for (unsigned i : _extremes) { hull.vertices.push_back(_points[i]); }
+	std::sort(hull.vertices.begin(), hull.vertices.end(), [](vec3 const& _a, vec3 const& _b)
+		{ return _a.x != _b.x ? _a.x < _b.x : _a.y != _b.y ? _a.y < _b.y : _a.z < _b.z; });
+	hull.vertices.erase(std::unique(hull.vertices.begin(), hull.vertices.end()), hull.vertices.end());
+	return hull;
+}
+
+ConvexHull CreateConvexHullQuickhull(std::vector<vec3> const& _points)
+{
+	if (_points.empty()) { return ConvexHull(); }
+	unsigned numPts = static_cast<unsigned>(_points.size());
+
+	// extreme points along each axis
+	unsigned extremes[6]{ 0, 0, 0, 0, 0, 0 }; // min x, max x, min y ...
+	vec3 maxAbs(0.f);
+	for (unsigned i = 0; i < numPts; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			if (_points[i][j] < _points[extremes[j * 2]][j]) { extremes[j * 2] = i; }
+			if (_points[i][j] > _points[extremes[j * 2 + 1]][j]) { extremes[j * 2 + 1] = i; }
+			maxAbs[j] = max(maxAbs[j], abs(_points[i][j]));
+		}
+	}
+	// tolerance scaled to size of input
+	float const eps = 3.f * FLT_EPSILON * (maxAbs.x + maxAbs.y + maxAbs.z);
+	std::vector<unsigned> extremeList(extremes, extremes + 6);
+
+	// initial tetrahedron: most distant extreme pair, then furthest from line, then from plane
+	unsigned i0 = extremes[0], i1 = extremes[1]; float best = -1.f;
+	for (int j = 0; j < 6; ++j)
+	{
+		for (int k = j + 1; k < 6; ++k)
+		{
+			float dist2 = distance2(_points[extremes[j]], _points[extremes[k]]);
+			if (dist2 > best) { best = dist2; i0 = extremes[j]; i1 = extremes[k]; }
+		}
+	}
+	if (best <= eps * eps) { return CreateDegenerateHull(_points, extremeList); }
+
+	vec3 line = normalize(_points[i1] - _points[i0]);
+	unsigned i2 = i0; best = -1.f;
+	for (unsigned i = 0; i < numPts; ++i)
+	{
+		vec3 p = _points[i] - _points[i0];
+		float dist2 = length2(p - line * dot(p, line));
+		if (dist2 > best) { best = dist2; i2 = i; }
+	}
+	if (best <= eps * eps) { return CreateDegenerateHull(_points, extremeList); }
+
+	vec3 n = normalize(cross(_points[i1] - _points[i0], _points[i2] - _points[i0]));
+	unsigned i3 = i0; best = -1.f;
+	for (unsigned i = 0; i < numPts; ++i)
+	{
+		float dist = abs(dot(_points[i] - _points[i0], n));
+		if (dist > best) { best = dist; i3 = i; }
+	}
+	if (best <= eps)
+	{
+		extremeList.insert(extremeList.end(), { i0, i1, i2 });
+		return CreateDegenerateHull(_points, extremeList);
+	}
+
+	std::vector<HullFace> faces;
+	std::unordered_map<uint64_t, unsigned> edgeToFace; // directed edge -> face on its left
+	auto addFace = [&](unsigned _a, unsigned _b, unsigned _c)
+	{
+		HullFace face;
+		face.v[0] = _a; face.v[1] = _b; face.v[2] = _c;
+		double ab[3], ac[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			ab[j] = static_cast<double>(_points[_b][j]) - _points[_a][j];
+			ac[j] = static_cast<double>(_points[_c][j]) - _points[_a][j];
+		}
+		face.n[0] = ab[1] * ac[2] - ab[2] * ac[1];
+		face.n[1] = ab[2] * ac[0] - ab[0] * ac[2];
+		face.n[2] = ab[0] * ac[1] - ab[1] * ac[0];
+		double len = std::sqrt(face.n[0] * face.n[0] + face.n[1] * face.n[1] + face.n[2] * face.n[2]);
+		for (double& n : face.n) { n = len > 0.0 ? n / len : 0.0; }
+		face.d = face.n[0] * _points[_a].x + face.n[1] * _points[_a].y + face.n[2] * _points[_a].z;
+		unsigned idx = static_cast<unsigned>(faces.size());
+		edgeToFace[HullEdgeKey(_a, _b)] = idx;
+		edgeToFace[HullEdgeKey(_b, _c)] = idx;
+		edgeToFace[HullEdgeKey(_c, _a)] = idx;
+		faces.push_back(std::move(face));
+		return idx;
+	};
+
+	// wind tetrahedron so faces point away from i3
+	if (dot(_points[i3] - _points[i0], n) > 0.f) { std::swap(i1, i2); }
+	addFace(i0, i1, i2); addFace(i0, i3, i1); addFace(i1, i3, i2); addFace(i2, i3, i0);
+
+	// assign points to first face they are in front of
+	auto assignPoints = [&](std::vector<unsigned> const& _pts, unsigned _firstFace)
+	{
+		for (unsigned p : _pts)
+		{
+			for (unsigned f = _firstFace; f < faces.size(); ++f)
+			{
+				if (faces[f].isAlive && HullFaceDist(faces[f], _points[p]) > eps)
+				{ faces[f].outside.push_back(p); break; }
+			}
+		}
+	};
+	std::vector<unsigned> allPts(numPts);
+	for (unsigned i = 0; i < numPts; ++i) { allPts[i] = i; }
+	assignPoints(allPts, 0);
+
+	std::vector<unsigned> visible, stack, orphans;
+	std::vector<std::pair<unsigned, unsigned>> horizon;
+	unsigned visitId = 0;
+	for (unsigned f = 0; f < faces.size(); ++f)
+	{
+		while (faces[f].isAlive && !faces[f].outside.empty())
+		{
+			// furthest point in front of face becomes new hull vertex
+			unsigned eye = faces[f].outside[0]; double eyeDist = -DBL_MAX;
+			for (unsigned p : faces[f].outside)
+			{
+				double dist = HullFaceDist(faces[f], _points[p]);
+				if (dist > eyeDist) { eyeDist = dist; eye = p; }
+			}
+
+			// flood fill faces visible from eye, edges to faces that are not visible form the horizon
+			// no tolerance here, a face the eye is barely in front of must go or the cone turns concave
+			++visitId; visible.clear(); horizon.clear();
+			stack.assign(1, f); faces[f].visitId = visitId;
+			while (!stack.empty())
+			{
+				unsigned curr = stack.back(); stack.pop_back();
+				visible.push_back(curr);
+				for (int e = 0; e < 3; ++e)
+				{
+					unsigned a = faces[curr].v[e], b = faces[curr].v[(e + 1) % 3];
+					unsigned neighbour = edgeToFace[HullEdgeKey(b, a)];
+					if (faces[neighbour].visitId == visitId) { continue; }
+					if (HullFaceDist(faces[neighbour], _points[eye]) > 0.0)
+					{ faces[neighbour].visitId = visitId; stack.push_back(neighbour); }
+					else { horizon.push_back({ a, b }); }
+				}
+			}
+
+			// remove visible faces and cone horizon to eye
+			orphans.clear();
+			for (unsigned v : visible)
+			{
+				faces[v].isAlive = false;
+				orphans.insert(orphans.end(), faces[v].outside.begin(), faces[v].outside.end());
+				faces[v].outside.clear(); faces[v].outside.shrink_to_fit();
+			}
+			unsigned firstNew = static_cast<unsigned>(faces.size());
+			for (auto [a, b] : horizon) { addFace(a, b, eye); }
+			orphans.erase(std::remove(orphans.begin(), orphans.end(), eye), orphans.end());
+			assignPoints(orphans, firstNew);
+		}
+	}
+
+	// compact to used vertices
+	ConvexHull hull;
+	std::unordered_map<unsigned, unsigned> remap;
+	for (HullFace const& face : faces)
+	{
+		if (!face.isAlive) { continue; }
+		for (unsigned v : face.v)
+		{
+			auto [it, isNew] = remap.try_emplace(v, static_cast<unsigned>(hull.vertices.size()));
+			if (isNew) { hull.vertices.push_back(_points[v]); }
+			hull.indices.push_back(it->second);
+		}
+	}
+	return hull;
+}
+
+ConvexHull CreateConvexHullQuickhull(std::vector<Vertex> const& _vertices)
+{
+	std::vector<vec3> points(_vertices.size());
+	for (size_t i = 0; i < _vertices.size(); ++i) { points[i] = _vertices[i].position; }
+	return CreateConvexHullQuickhull(points);
+}
@@ -0,0 +1,468 @@
+/**
+@file    gjk.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of convex shape support functions, GJK
+distance/overlap queries and EPA penetration depth.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/gjk.hpp>
+#include <cs350/intersectiontests.hpp>
+#include <vector>
+#include <algorithm>
+#include <cfloat>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static constexpr int GJK_MAX_ITERATIONS = 64;
+static constexpr float GJK_REL_TOL = 1e-5f; // stop once |v|^2 - v.w is below this fraction of |v|^2
+static constexpr float GJK_ABS_TOL2 = cEpsilon * cEpsilon; // |v|^2 below this is touching
+static constexpr int EPA_MAX_ITERATIONS = 128;
+static constexpr float EPA_TOL = 1e-4f; // stop once polytope grows less than this along closest face
+static constexpr int TOI_MAX_ITERATIONS = 32;
+
+/**
+ * @struct GjkVertex
+ * @brief This struct holds a vertex of the Minkowski difference A - B
+ */
+struct GjkVertex
+{
+	vec3 w; // a - b
+	vec3 a; // support of A
+	vec3 b; // support of B
+	vec3 dir; // direction support was taken along, kept for warm starting
+};
+
+/**
+ * @struct GjkSimplex
+ * @brief This struct holds the current simplex and the barycentric weights of
+ * its point closest to the origin
+ */
+struct GjkSimplex
+{
+	GjkVertex v[4];
+	float bary[4]{ 1.f, 0.f, 0.f, 0.f };
+	int count{ 0 };
+};
+
+ConvexShape MakeConvexPoint(vec3 const& _p)
+{
+	ConvexShape ret; ret.type = CONVEX_POINT; ret.center = _p;
+	return ret;
+}
+
+ConvexShape MakeConvexSphere(vec3 const& _c, float _r)
+{
+	ConvexShape ret; ret.type = CONVEX_SPHERE; ret.center = _c; ret.radius = _r;
+	return ret;
+}
+
+ConvexShape MakeConvexObb(vec3 const& _c, vec3 const& _halfExtents, vec3 const _axes[3])
+{
+	ConvexShape ret; ret.type = CONVEX_OBB; ret.center = _c; ret.halfExtents = _halfExtents;
+	for (int i = 0; i < 3; ++i) { ret.axes[i] = _axes[i]; }
+	return ret;
+}
+
+ConvexShape MakeConvexHull(ConvexHull const& _hull, mat4 const& _modelMtx)
+{
+	ConvexShape ret; ret.type = CONVEX_HULL; ret.hull = &_hull; ret.modelMtx = _modelMtx;
+	ret.center = vec3(_modelMtx[3]);
+	return ret;
+}
+
+ConvexShape TranslateConvex(ConvexShape const& _shape, vec3 const& _offset)
+{
+	ConvexShape ret = _shape;
+	ret.center += _offset;
+	ret.modelMtx[3] += vec4(_offset, 0.f);
+	return ret;
+}
+
+vec3 ConvexSupport(ConvexShape const& _shape, vec3 const& _dir)
+{
+	switch (_shape.type)
+	{
+	case CONVEX_SPHERE:
+	{
+		float len2 = length2(_dir);
+		return len2 > 0.f ? _shape.center + _dir * (_shape.radius / sqrt(len2)) : _shape.center + vec3(_shape.radius, 0.f, 0.f);
+	}
+	case CONVEX_OBB:
+	{
+		vec3 ret = _shape.center;
+		for (int i = 0; i < 3; ++i)
+		{ ret += _shape.axes[i] * (dot(_dir, _shape.axes[i]) >= 0.f ? _shape.halfExtents[i] : -_shape.halfExtents[i]); }
+		return ret;
+	}
+	case CONVEX_HULL:
+	{
+		if (_shape.hull == nullptr || _shape.hull->vertices.empty()) { return _shape.center; }
+		// dot(M p, d) == dot(p, M^T d), so search model space vertices and transform only the winner
+		vec3 dirLocal = transpose(mat3(_shape.modelMtx)) * _dir;
+		std::vector<vec3> const& vtx = _shape.hull->vertices;
+		size_t best = 0; float bestDot = dot(vtx[0], dirLocal);
+		for (size_t i = 1; i < vtx.size(); ++i)
+		{
+			float d = dot(vtx[i], dirLocal);
+			if (d > bestDot) { bestDot = d; best = i; }
+		}
+		return vec3(_shape.modelMtx * vec4(vtx[best], 1.f));
+	}
+	default: return _shape.center;
+	}
+}
+
+/**
+ * @brief support of Minkowski difference A - B
+ */
+static GjkVertex GjkSupport(ConvexShape const& _a, ConvexShape const& _b, vec3 const& _dir)
+{
+	GjkVertex ret;
+	ret.dir = _dir;
+	ret.a = ConvexSupport(_a, _dir);
+	ret.b = ConvexSupport(_b, -_dir);
+	ret.w = ret.a - ret.b;
+	return ret;
+}
+
+/**
+ * @brief point of simplex closest to origin from its barycentric weights
+ */
+static vec3 GjkClosest(GjkSimplex const& _s)
+{
+	vec3 ret(0.f);
+	for (int i = 0; i < _s.count; ++i) { ret += _s.v[i].w * _s.bary[i]; }
+	return ret;
+}
+
+/**
+ * @brief closest feature of segment to origin
+ */
+static GjkSimplex GjkSegment(GjkVertex const& _a, GjkVertex const& _b)
+{
+	GjkSimplex ret;
+	vec3 ab = _b.w - _a.w;
+	float t = -dot(_a.w, ab), len2 = dot(ab, ab);
+	if (t <= 0.f || len2 <= 0.f) { ret.v[0] = _a; ret.bary[0] = 1.f; ret.count = 1; }
+	else if (t >= len2) { ret.v[0] = _b; ret.bary[0] = 1.f; ret.count = 1; }
+	else
+	{
+		t /= len2;
+		ret.v[0] = _a; ret.v[1] = _b; ret.bary[0] = 1.f - t; ret.bary[1] = t; ret.count = 2;
+	}
+	return ret;
+}
+
+/**
+ * @brief closest feature of triangle to origin, voronoi regions as in
+ * Ericson's ClosestPtPointTriangle
+ */
+static GjkSimplex GjkTriangle(GjkVertex const& _a, GjkVertex const& _b, GjkVertex const& _c)
+{
+	GjkSimplex ret;
+	vec3 ab = _b.w - _a.w, ac = _c.w - _a.w;
+	float d1 = -dot(ab, _a.w), d2 = -dot(ac, _a.w);
+	if (d1 <= 0.f && d2 <= 0.f) { ret.v[0] = _a; ret.count = 1; return ret; }
+	float d3 = -dot(ab, _b.w), d4 = -dot(ac, _b.w);
+	if (d3 >= 0.f && d4 <= d3) { ret.v[0] = _b; ret.count = 1; return ret; }
+	float d5 = -dot(ab, _c.w), d6 = -dot(ac, _c.w);
+	if (d6 >= 0.f && d5 <= d6) { ret.v[0] = _c; ret.count = 1; return ret; }
+
+	float vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+	if (va + vb + vc <= FLT_MIN)
+	{
+		// degenerate triangle, best of its edges
+		GjkSimplex edges[3]{ GjkSegment(_a, _b), GjkSegment(_a, _c), GjkSegment(_b, _c) };
+		int best = 0; float bestDist2 = FLT_MAX;
+		for (int i = 0; i < 3; ++i)
+		{
+			float dist2 = length2(GjkClosest(edges[i]));
+			if (dist2 < bestDist2) { bestDist2 = dist2; best = i; }
+		}
+		return edges[best];
+	}
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		float v = d1 / (d1 - d3);
+		ret.v[0] = _a; ret.v[1] = _b; ret.bary[0] = 1.f - v; ret.bary[1] = v; ret.count = 2; return ret;
+	}
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		float w = d2 / (d2 - d6);
+		ret.v[0] = _a; ret.v[1] = _c; ret.bary[0] = 1.f - w; ret.bary[1] = w; ret.count = 2; return ret;
+	}
+	if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		ret.v[0] = _b; ret.v[1] = _c; ret.bary[0] = 1.f - w; ret.bary[1] = w; ret.count = 2; return ret;
+	}
+	float denom = 1.f / (va + vb + vc);
+	float v = vb * denom, w = vc * denom;
+	ret.v[0] = _a; ret.v[1] = _b; ret.v[2] = _c;
+	ret.bary[0] = 1.f - v - w; ret.bary[1] = v; ret.bary[2] = w; ret.count = 3;
+	return ret;
+}
+
+/**
+ * @brief closest feature of tetrahedron to origin
+ * @return true if origin is inside tetrahedron, simplex is left unchanged
+ */
+static bool GjkTetrahedron(GjkSimplex& _s)
+{
+	GjkVertex const& a = _s.v[0], & b = _s.v[1], & c = _s.v[2], & d = _s.v[3];
+	// each face with the vertex opposite it
+	GjkVertex const* faces[4][4]{ { &a, &b, &c, &d }, { &a, &c, &d, &b }, { &a, &d, &b, &c }, { &b, &d, &c, &a } };
+	float vol = dot(d.w - a.w, cross(b.w - a.w, c.w - a.w));
+	// flat tetrahedron cannot hold origin, closest point is on one of its faces
+	bool isFlat = abs(vol) <= FLT_EPSILON * length(b.w - a.w) * length(c.w - a.w) * length(d.w - a.w);
+
+	GjkSimplex best; float bestDist2 = FLT_MAX; bool isOutside = false;
+	for (auto& face : faces)
+	{
+		vec3 p0 = face[0]->w;
+		vec3 n = cross(face[1]->w - p0, face[2]->w - p0);
+		// origin and opposite vertex on different sides of face
+		if (!isFlat && dot(-p0, n) * dot(face[3]->w - p0, n) >= 0.f) { continue; }
+		isOutside = true;
+		GjkSimplex tri = GjkTriangle(*face[0], *face[1], *face[2]);
+		float dist2 = length2(GjkClosest(tri));
+		if (dist2 < bestDist2) { bestDist2 = dist2; best = tri; }
+	}
+	if (!isOutside) { return true; }
+	_s = best;
+	return false;
+}
+
+/**
+ * @brief reduces simplex to its feature closest to origin
+ * @return true if origin is enclosed by simplex
+ */
+static bool GjkSolve(GjkSimplex& _s)
+{
+	switch (_s.count)
+	{
+	case 1: _s.bary[0] = 1.f; return false;
+	case 2: _s = GjkSegment(_s.v[0], _s.v[1]); return false;
+	case 3: _s = GjkTriangle(_s.v[0], _s.v[1], _s.v[2]); return false;
+	case 4: return GjkTetrahedron(_s);
+	default: return false;
+	}
+}
+
+/**
+ * @brief GJK iterations
+ * @param _stopOnSeparation - returns as soon as a separating axis is found, for boolean queries
+ * @param _s - final simplex
+ * @param _v - closest point of A - B to origin
+ * @return true if overlapping
+ */
+static bool GjkRun(ConvexShape const& _a, ConvexShape const& _b, GjkCache const* _cache, bool _stopOnSeparation,
+	GjkSimplex& _s, vec3& _v, int& _iterations)
+{
+	// seed with supports along last frame's directions
+	_s.count = 0;
+	for (int i = 0; _cache != nullptr && i < _cache->count; ++i)
+	{
+		GjkVertex w = GjkSupport(_a, _b, _cache->dirs[i]);
+		bool isDuplicate = false;
+		for (int j = 0; j < _s.count; ++j) { isDuplicate |= distance2(w.w, _s.v[j].w) <= GJK_ABS_TOL2; }
+		if (!isDuplicate) { _s.v[_s.count++] = w; }
+	}
+	if (_s.count == 0) { _s.v[_s.count++] = GjkSupport(_a, _b, _b.center - _a.center); }
+
+	_v = _s.v[0].w;
+	while (true)
+	{
+		if (GjkSolve(_s)) { return true; }
+		_v = GjkClosest(_s);
+		float vv = dot(_v, _v);
+		if (vv <= GJK_ABS_TOL2) { return true; }
+		if (_iterations++ >= GJK_MAX_ITERATIONS) { return false; }
+
+		GjkVertex w = GjkSupport(_a, _b, -_v);
+		float vw = dot(_v, w.w);
+		// w is the point of A - B furthest along -v, origin is behind it so -v separates
+		if (_stopOnSeparation && vw > 0.f) { return false; }
+		if (vv - vw <= GJK_REL_TOL * vv) { return false; }
+		for (int j = 0; j < _s.count; ++j)
+		{
+			if (distance2(w.w, _s.v[j].w) <= GJK_ABS_TOL2) { return false; } // no progress
+		}
+		_s.v[_s.count++] = w;
+	}
+}
+
+/**
+ * @brief saves simplex directions for warm starting next query
+ */
+static void GjkStoreCache(GjkSimplex const& _s, GjkCache* _cache)
+{
+	if (_cache == nullptr) { return; }
+	_cache->count = _s.count;
+	for (int i = 0; i < _s.count; ++i) { _cache->dirs[i] = _s.v[i].dir; }
+}
+
+/**
+ * @struct EpaFace
+ * @brief This struct holds a face of the EPA polytope
+ */
+struct EpaFace
+{
+	int v[3];
+	vec3 n; // unit, pointing out of polytope
+	float dist; // distance of plane to origin
+	bool isAlive;
+};
+
+/**
+ * @brief expanding polytope algorithm, writes penetration depth, normal and
+ * contact points of overlapping shapes into result
+ */
+static void EpaRun(ConvexShape const& _a, ConvexShape const& _b, GjkSimplex const& _s, GjkResult& _res)
+{
+	std::vector<GjkVertex> verts(_s.v, _s.v + _s.count);
+
+	// GJK may stop on a point, edge or triangle touching the origin, blow it up to a tetrahedron
+	static vec3 const axes[3]{ vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+	while (verts.size() < 4)
+	{
+		vec3 candidates[3]; int numCandidates = 0;
+		vec3 const w0 = verts[0].w;
+		vec3 u(0.f), n(0.f);
+		if (verts.size() == 1) { for (vec3 const& axis : axes) { candidates[numCandidates++] = axis; } }
+		else if (verts.size() == 2)
+		{
+			u = normalize(verts[1].w - w0);
+			vec3 absU = abs(u);
+			vec3 axis = absU.x < absU.y ? (absU.x < absU.z ? axes[0] : axes[2]) : (absU.y < absU.z ? axes[1] : axes[2]);
+			candidates[numCandidates++] = normalize(cross(u, axis));
+			candidates[numCandidates++] = cross(u, candidates[0]);
+		}
+		else
+		{
+			n = normalize(cross(verts[1].w - w0, verts[2].w - w0));
+			candidates[numCandidates++] = n;
+		}
+
+		bool isAdded = false;
+		for (int i = 0; i < numCandidates * 2 && !isAdded; ++i)
+		{
+			GjkVertex w = GjkSupport(_a, _b, i % 2 ? -candidates[i / 2] : candidates[i / 2]);
+			vec3 offset = w.w - w0;
+			// distance of new point to the affine hull of current points
+			float dist = verts.size() == 1 ? length(offset) : verts.size() == 2 ? length(cross(offset, u)) : abs(dot(offset, n));
+			if (dist > cEpsilon) { verts.push_back(w); isAdded = true; }
+		}
+		// Minkowski difference is flat, shapes only touch
+		if (!isAdded) { return; }
+	}
+
+	std::vector<EpaFace> faces;
+	auto addFace = [&](int _i0, int _i1, int _i2)
+	{
+		EpaFace face{ { _i0, _i1, _i2 }, vec3(0.f), FLT_MAX, true };
+		vec3 n = cross(verts[_i1].w - verts[_i0].w, verts[_i2].w - verts[_i0].w);
+		float len = length(n);
+		// sliver faces keep dist FLT_MAX so they are never picked as closest
+		if (len > 0.f) { face.n = n / len; face.dist = dot(face.n, verts[_i0].w); }
+		faces.push_back(face);
+	};
+	// wind tetrahedron so faces point away from the 4th vertex
+	if (dot(cross(verts[1].w - verts[0].w, verts[2].w - verts[0].w), verts[3].w - verts[0].w) > 0.f)
+	{ std::swap(verts[1], verts[2]); }
+	addFace(0, 1, 2); addFace(0, 3, 1); addFace(1, 3, 2); addFace(2, 3, 0);
+
+	std::vector<std::pair<int, int>> horizon;
+	int closest = 0;
+	for (int iter = 0; iter < EPA_MAX_ITERATIONS; ++iter)
+	{
+		closest = -1;
+		for (int i = 0; i < static_cast<int>(faces.size()); ++i)
+		{
+			if (faces[i].isAlive && (closest < 0 || faces[i].dist < faces[closest].dist)) { closest = i; }
+		}
+		if (closest < 0) { return; }
+		vec3 n = faces[closest].n;
+		GjkVertex w = GjkSupport(_a, _b, n);
+		if (dot(w.w, n) - faces[closest].dist <= EPA_TOL * max(1.f, faces[closest].dist)) { break; }
+
+		// remove faces seen from new point, their unshared edges form the horizon
+		int newIdx = static_cast<int>(verts.size());
+		verts.push_back(w);
+		horizon.clear();
+		for (EpaFace& face : faces)
+		{
+			if (!face.isAlive || dot(face.n, w.w - verts[face.v[0]].w) <= 0.f) { continue; }
+			face.isAlive = false;
+			for (int e = 0; e < 3; ++e)
+			{
+				std::pair<int, int> edge{ face.v[e], face.v[(e + 1) % 3] };
+				auto twin = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+				if (twin != horizon.end()) { *twin = horizon.back(); horizon.pop_back(); }
+				else { horizon.push_back(edge); }
+			}
+		}
+		for (auto [i0, i1] : horizon) { addFace(i0, i1, newIdx); }
+	}
+
+	// contact points from barycentric coordinates of origin projected on closest face
+	EpaFace const& face = faces[closest];
+	GjkVertex const& a = verts[face.v[0]], & b = verts[face.v[1]], & c = verts[face.v[2]];
+	vec3 p = face.n * face.dist;
+	vec3 v0 = b.w - a.w, v1 = c.w - a.w, v2 = p - a.w;
+	float d00 = dot(v0, v0), d01 = dot(v0, v1), d11 = dot(v1, v1), d20 = dot(v2, v0), d21 = dot(v2, v1);
+	float denom = d00 * d11 - d01 * d01;
+	float v = 0.f, w = 0.f;
+	if (abs(denom) > FLT_MIN) { v = (d11 * d20 - d01 * d21) / denom; w = (d00 * d21 - d01 * d20) / denom; }
+	float u = 1.f - v - w;
+	_res.pointA = a.a * u + b.a * v + c.a * w;
+	_res.pointB = a.b * u + b.b * v + c.b * w;
+	_res.normal = face.n;
+	_res.depth = max(0.f, face.dist);
+}
+
+GjkResult GjkDistance(ConvexShape const& _a, ConvexShape const& _b, GjkCache* _cache, bool _computePenetration)
+{
+	GjkResult res;
+	GjkSimplex s; vec3 v;
+	res.isOverlapping = GjkRun(_a, _b, _cache, false, s, v, res.iterations);
+	GjkStoreCache(s, _cache);
+	if (!res.isOverlapping)
+	{
+		for (int i = 0; i < s.count; ++i) { res.pointA += s.v[i].a * s.bary[i]; res.pointB += s.v[i].b * s.bary[i]; }
+		res.distance = length(v);
+		res.normal = res.distance > 0.f ? -v / res.distance : vec3(0.f);
+	}
+	else if (_computePenetration) { EpaRun(_a, _b, s, res); }
+	return res;
+}
+
+bool GjkOverlap(ConvexShape const& _a, ConvexShape const& _b, GjkCache* _cache)
+{
+	GjkSimplex s; vec3 v; int iterations = 0;
+	bool ret = GjkRun(_a, _b, _cache, true, s, v, iterations);
+	GjkStoreCache(s, _cache);
+	return ret;
+}
+
+float GjkTimeOfImpact(ConvexShape const& _a, vec3 const& _motionA, ConvexShape const& _b, vec3 const& _motionB, float _tolerance)
+{
+	// B is held still, A moves by the relative motion
+	vec3 motion = _motionA - _motionB;
+	GjkCache cache;
+	float t = 0.f;
+	for (int iter = 0; iter < TOI_MAX_ITERATIONS; ++iter)
+	{
+		GjkResult res = GjkDistance(TranslateConvex(_a, motion * t), _b, &cache);
+		if (res.isOverlapping || res.distance <= _tolerance) { return t; }
+		// distance along a linear path is convex, once it stops closing it never will
+		float closing = dot(motion, res.normal);
+		if (closing <= 0.f) { return -1.f; }
+		t += res.distance / closing;
+		if (t > 1.f) { return -1.f; }
+	}
+	return -1.f;
+}
@@ -0,0 +1,361 @@
+/**
+@file    hlod.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the Hlod class.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/hlod.hpp>
+#include <cs350/simplify.hpp>
+#include <components/transform.hpp>
+#include <components/renderable.hpp>
+#include <components/material.hpp>
+#include <parallel.hpp>
+#include <hash.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cfloat>
+#include <cstdio>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint32_t constexpr HLOD_CACHE_MAGIC = 0x444f4c48; // "HLOD"
+static uint32_t constexpr HLOD_CACHE_VERSION = 2; // bump when proxies are built differently
+
+std::vector<HlodNode> Hlod::s_Nodes;
+std::vector<HlodProxy> Hlod::s_Proxies;
+std::vector<std::vector<uint32_t>> Hlod::s_EntityProxies;
+std::unordered_map<uint64_t, Hlod::CacheEntry> Hlod::s_Cache;
+
+/**
+ * @struct HlodMesh
+ * @brief This struct holds a proxy mesh before it is uploaded
+ */
+struct HlodMesh
+{
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	float error{ 0.f };
+};
+
+/**
+ * @struct HlodChild
+ * @brief This struct holds the proxy of a child cell merged into its parent
+ */
+struct HlodChild
+{
+	Buffer* buffer;
+	float error;
+};
+
+/**
+ * @struct HlodSource
+ * @brief This struct holds a mesh in the octree gathered for building proxies
+ */
+struct HlodSource
+{
+	std::vector<Buffer*> buffers;
+	mat4 model;
+	float size; // diagonal of world bounds
+	uint64_t hash; // of mesh type, the file it was loaded from and transform
+};
+
+static std::string GetCachePath(uint64_t _key)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.hlod", static_cast<unsigned long long>(_key));
+	return std::string(HLOD_CACHE_DIR) + name;
+}
+
+/**
+ * @brief reads a proxy mesh cached by an earlier run, false if there is none or it is bad
+ */
+static bool LoadCachedMesh(uint64_t _key, HlodMesh& _mesh)
+{
+	std::ifstream ifs(GetCachePath(_key), std::ios::binary | std::ios::ate);
+	if (!ifs) { return false; }
+	uint64_t fileSize = static_cast<uint64_t>(ifs.tellg());
+	ifs.seekg(0);
+	uint32_t header[4]{}; // magic, version, vertices, indices
+	ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+	ifs.read(reinterpret_cast<char*>(&_mesh.error), sizeof(float));
+	if (!ifs || header[0] != HLOD_CACHE_MAGIC || header[1] != HLOD_CACHE_VERSION || header[3] % 3 != 0) { return false; }
+	// counts of a truncated or corrupt file are not trusted with an allocation
+	uint64_t dataSize = sizeof(Vertex) * static_cast<uint64_t>(header[2]) + sizeof(uint32_t) * static_cast<uint64_t>(header[3]);
+	if (dataSize != fileSize - sizeof(header) - sizeof(float)) { return false; }
+	_mesh.vertices.resize(header[2]); _mesh.indices.resize(header[3]);
+	ifs.read(reinterpret_cast<char*>(_mesh.vertices.data()), sizeof(Vertex) * header[2]);
+	ifs.read(reinterpret_cast<char*>(_mesh.indices.data()), sizeof(uint32_t) * header[3]);
+	if (!ifs) { return false; }
+	for (uint32_t i : _mesh.indices) { if (i >= header[2]) { return false; } }
+	return true;
+}
+
+/**
+ * @brief writes a proxy mesh for later runs, written to a temporary file first
+ * so a run stopped halfway never leaves a bad file under the key
+ */
+static void SaveCachedMesh(uint64_t _key, HlodMesh const& _mesh)
+{
+	std::string path = GetCachePath(_key), tmpPath = path + ".tmp";
+	{
+		std::ofstream ofs(tmpPath, std::ios::binary);
+		if (!ofs) { return; }
+		uint32_t header[4]{ HLOD_CACHE_MAGIC, HLOD_CACHE_VERSION,
+			static_cast<uint32_t>(_mesh.vertices.size()), static_cast<uint32_t>(_mesh.indices.size()) };
+		ofs.write(reinterpret_cast<char const*>(header), sizeof(header));
+		ofs.write(reinterpret_cast<char const*>(&_mesh.error), sizeof(float));
+		ofs.write(reinterpret_cast<char const*>(_mesh.vertices.data()), sizeof(Vertex) * _mesh.vertices.size());
+		ofs.write(reinterpret_cast<char const*>(_mesh.indices.data()), sizeof(uint32_t) * _mesh.indices.size());
+		if (!ofs) { return; }
+	}
+	std::error_code err;
+	std::filesystem::rename(tmpPath, path, err);
+}
+
+/**
+ * @brief appends the triangles of a mesh, positions and normals moved to world space
+ */
+static void AppendTriangles(HlodMesh& _out, std::vector<Vertex> const& _vtx, uint32_t const* _idx, uint32_t _count, mat4 const& _model)
+{
+	mat3 nmlMtx = transpose(inverse(mat3(_model)));
+	uint32_t base = static_cast<uint32_t>(_out.vertices.size());
+	for (Vertex vtx : _vtx)
+	{
+		vtx.position = vec3(_model * vec4(vtx.position, 1.f));
+		vec3 nml = nmlMtx * vtx.normal;
+		vtx.normal = nml == vec3(0.f) ? nml : normalize(nml);
+		_out.vertices.push_back(vtx);
+	}
+	for (uint32_t i = 0; i < _count; ++i) { _out.indices.push_back(base + (_idx ? _idx[i] : i)); }
+}
+
+/**
+ * @brief merges proxies of children and meshes not in them, then simplifies
+ * @param _children - proxies of child cells, already in world space
+ * @param _sources - meshes in cell not in any child with a proxy
+ * @param _cellSize - edge length of cell
+ * @param _mesh - set to proxy mesh
+ * @return false if there are no triangles
+ */
+static bool BuildProxyMesh(std::vector<HlodChild> const& _children, std::vector<HlodSource const*> const& _sources,
+	float _cellSize, HlodMesh& _mesh)
+{
+	// the proxy is at least as far off as what it is merged from
+	HlodMesh merged;
+	float inputError = 0.f;
+	for (auto const& child : _children)
+	{
+		std::vector<uint32_t> const& idx = child.buffer->GetIndices();
+		AppendTriangles(merged, child.buffer->GetVertices(), idx.data(), static_cast<uint32_t>(idx.size()), mat4(1.f));
+		inputError = std::max(inputError, child.error);
+	}
+	for (auto src : _sources)
+	{
+		// a part much smaller than the cell is left out, moving the surface by at most its size
+		if (src->size < _cellSize * HLOD_MIN_PART_FRACTION) { inputError = std::max(inputError, src->size); continue; }
+		for (Buffer* buf : src->buffers)
+		{
+			if (buf->GetPrimitiveType() != Buffer::TRIANGLES) { continue; }
+			std::vector<uint32_t> const& idx = buf->GetIndices();
+			AppendTriangles(merged, buf->GetVertices(), idx.empty() ? nullptr : idx.data(), buf->GetLods()[0].count, src->model);
+		}
+	}
+	if (merged.indices.empty()) { return false; }
+
+	size_t numTris = merged.indices.size() / 3;
+	size_t target = std::min<size_t>(numTris / 2, HLOD_MAX_TRIANGLES) * 3;
+	float stepError;
+	std::vector<uint32_t> idx = SimplifyMesh(merged.vertices, merged.indices, target, _cellSize * HLOD_MAX_ERROR_FRACTION, stepError);
+	_mesh.error = inputError + stepError;
+
+	// only vertices still used are kept
+	std::vector<uint32_t> remap(merged.vertices.size(), UINT32_MAX);
+	_mesh.vertices.clear(); _mesh.indices.clear(); _mesh.indices.reserve(idx.size());
+	for (uint32_t i : idx)
+	{
+		if (remap[i] == UINT32_MAX) { remap[i] = static_cast<uint32_t>(_mesh.vertices.size()); _mesh.vertices.push_back(merged.vertices[i]); }
+		_mesh.indices.push_back(remap[i]);
+	}
+	return !_mesh.indices.empty();
+}
+
+void Hlod::Build(OctTreeNode const& _root, bool _isGenerating)
+{
+	Clear();
+	if (_root.entities.size() < HLOD_MIN_MESHES) { s_Cache.clear(); return; }
+
+	// cells large enough with enough meshes, parents before children
+	std::vector<OctTreeNode const*> cells{ &_root };
+	std::vector<unsigned> depths{ 0 };
+	float minSize = 2.f * _root.halfExtent * HLOD_MIN_CELL_FRACTION;
+	s_Nodes.push_back({ _root.center - vec3(_root.halfExtent), _root.center + vec3(_root.halfExtent), -1, {} });
+	for (size_t i = 0; i < cells.size(); ++i)
+	{
+		for (auto const& child : cells[i]->pChildren)
+		{
+			if (!child || 2.f * child->halfExtent < minSize || child->entities.size() < HLOD_MIN_MESHES) { continue; }
+			s_Nodes[i].children.push_back(static_cast<uint32_t>(cells.size()));
+			s_Nodes.push_back({ child->center - vec3(child->halfExtent), child->center + vec3(child->halfExtent), -1, {} });
+			cells.push_back(child.get()); depths.push_back(depths[i] + 1);
+		}
+	}
+
+	// every mesh is in the root, gathered once
+	std::vector<HlodSource> sources;
+	std::vector<uint32_t> sourceOf; // by entity index
+	std::unordered_map<std::string, std::pair<vec3, vec3>> localBounds;
+	for (entity ent : _root.entities)
+	{
+		auto idx = entt::to_entity(ent);
+		if (idx >= sourceOf.size()) { sourceOf.resize(idx + 1, UINT32_MAX); }
+		if (sourceOf[idx] != UINT32_MAX || !ECS.registry().all_of<Transform, Renderable>(ent)) { continue; }
+		std::string meshType = ECS.registry().get<Renderable>(ent).GetMeshType();
+		auto bufs = Renderable::GetBuffers().find(meshType);
+		if (bufs == Renderable::GetBuffers().end()) { continue; }
+
+		HlodSource src;
+		for (auto& buf : bufs->second) { src.buffers.push_back(buf.get()); }
+		src.model = ECS.registry().get<Transform>(ent).getMtx();
+		auto it = localBounds.find(meshType);
+		if (it == localBounds.end())
+		{
+			vec3 lo(FLT_MAX), hi(-FLT_MAX);
+			for (Buffer* buf : src.buffers) { for (Vertex const& vtx : buf->GetVertices()) { lo = min(lo, vtx.position); hi = max(hi, vtx.position); } }
+			if (lo.x > hi.x) { lo = hi = vec3(0.f); }
+			it = localBounds.emplace(meshType, std::make_pair(lo, hi)).first;
+		}
+		vec3 extents = 0.5f * (it->second.second - it->second.first), radius;
+		for (int i = 0; i < 3; ++i)
+		{ radius[i] = abs(src.model[0][i]) * extents.x + abs(src.model[1][i]) * extents.y + abs(src.model[2][i]) * extents.z; }
+		src.size = 2.f * length(radius);
+		// a model file edited under the same name changes its key, built in meshes have none
+		auto content = Renderable::GetContentKeys().find(meshType);
+		uint64_t contentKey = content == Renderable::GetContentKeys().end() ? 0 : content->second;
+		src.hash = HashBytes(meshType.data(), meshType.size());
+		src.hash = HashBytes(&contentKey, sizeof(contentKey), src.hash);
+		src.hash = HashBytes(&src.model, sizeof(mat4), src.hash);
+		sourceOf[idx] = static_cast<uint32_t>(sources.size());
+		sources.push_back(std::move(src));
+	}
+
+	// key of a cell covers its meshes, its place and the cells it is merged from, children first
+	std::vector<uint64_t> keys(cells.size());
+	std::vector<uint64_t> hashes;
+	for (size_t i = cells.size(); i-- > 0;)
+	{
+		hashes.clear();
+		for (entity ent : cells[i]->entities)
+		{
+			auto idx = entt::to_entity(ent);
+			if (idx < sourceOf.size() && sourceOf[idx] != UINT32_MAX) { hashes.push_back(sources[sourceOf[idx]].hash); }
+		}
+		std::sort(hashes.begin(), hashes.end());
+		for (uint32_t child : s_Nodes[i].children) { hashes.push_back(keys[child]); }
+		uint64_t key = HashBytes(&HLOD_CACHE_VERSION, sizeof(HLOD_CACHE_VERSION));
+		key = HashBytes(&cells[i]->center, sizeof(vec3), key);
+		key = HashBytes(&cells[i]->halfExtent, sizeof(float), key);
+		keys[i] = HashBytes(hashes.data(), hashes.size() * sizeof(uint64_t), key);
+	}
+
+	// deepest level first so children are uploaded before their parent merges them
+	std::error_code err;
+	if (_isGenerating) { std::filesystem::create_directories(HLOD_CACHE_DIR, err); }
+	std::unordered_map<uint64_t, CacheEntry> cache;
+	std::vector<CacheEntry const*> cellEntries(cells.size(), nullptr);
+	unsigned maxDepth = *std::max_element(depths.begin(), depths.end());
+	for (unsigned depth = maxDepth + 1; depth-- > 0;)
+	{
+		std::vector<uint32_t> level;
+		for (uint32_t i = 0; i < cells.size(); ++i) { if (depths[i] == depth) { level.push_back(i); } }
+
+		// inputs are gathered here, threads only read them
+		std::vector<std::vector<HlodChild>> children(level.size());
+		std::vector<std::vector<HlodSource const*>> levelSources(level.size());
+		std::vector<uint8_t> isMergeable(level.size(), 1);
+		std::vector<uint8_t> isInChild(sourceOf.size(), 0);
+		for (size_t j = 0; j < level.size(); ++j)
+		{
+			uint32_t cell = level[j];
+			for (uint32_t child : s_Nodes[cell].children)
+			{
+				if (!cellEntries[child]) { isMergeable[j] = 0; break; }
+				children[j].push_back({ cellEntries[child]->buffer.get(), cellEntries[child]->error });
+				for (entity ent : cells[child]->entities) { isInChild[entt::to_entity(ent)] = 1; }
+			}
+			for (entity ent : cells[cell]->entities)
+			{
+				auto idx = entt::to_entity(ent);
+				if (!isInChild[idx] && idx < sourceOf.size() && sourceOf[idx] != UINT32_MAX) { levelSources[j].push_back(&sources[sourceOf[idx]]); }
+			}
+			for (uint32_t child : s_Nodes[cell].children) { for (entity ent : cells[child]->entities) { isInChild[entt::to_entity(ent)] = 0; } }
+		}
+
+		std::vector<HlodMesh> meshes(level.size());
+		std::vector<uint8_t> isBuilt(level.size(), 0);
+		ParallelFor(static_cast<unsigned>(level.size()), [&](unsigned _begin, unsigned _end, unsigned)
+		{
+			for (unsigned j = _begin; j < _end; ++j)
+			{
+				uint32_t cell = level[j];
+				if (s_Cache.count(keys[cell])) { continue; }
+				if (LoadCachedMesh(keys[cell], meshes[j])) { isBuilt[j] = 1; continue; }
+				if (!_isGenerating || !isMergeable[j]) { continue; }
+				if (BuildProxyMesh(children[j], levelSources[j], 2.f * cells[cell]->halfExtent, meshes[j]))
+				{ SaveCachedMesh(keys[cell], meshes[j]); isBuilt[j] = 1; }
+			}
+		}, 1);
+
+		// upload on this thread
+		for (size_t j = 0; j < level.size(); ++j)
+		{
+			uint32_t cell = level[j];
+			auto it = s_Cache.find(keys[cell]);
+			if (it != s_Cache.end()) { it = cache.insert(*it).first; }
+			else if (isBuilt[j])
+			{
+				auto buffer = std::make_shared<Buffer>(meshes[j].vertices, Buffer::TRIANGLES, true, &meshes[j].indices);
+				it = cache.insert({ keys[cell], { buffer, meshes[j].error } }).first;
+			}
+			else { continue; }
+			cellEntries[cell] = &it->second;
+		}
+	}
+
+	// proxies are drawn with the average material of their meshes
+	s_EntityProxies.assign(sourceOf.size(), {});
+	for (uint32_t i = 0; i < cells.size(); ++i)
+	{
+		if (!cellEntries[i]) { continue; }
+		HlodProxy proxy{ cellEntries[i]->buffer, cellEntries[i]->error, vec3(0.f), cells[i]->entities, vec3(0.f), vec3(0.f), vec3(0.f), 0.f };
+		for (entity ent : proxy.entities)
+		{
+			Material* pMat = ECS.registry().try_get<Material>(ent);
+			Material const& mat = pMat ? *pMat : Material{};
+			proxy.kAmbient += mat.kAmbient; proxy.kDiffuse += mat.kDiffuse; proxy.kSpecular += mat.kSpecular; proxy.shininess += mat.shininess;
+			s_EntityProxies[entt::to_entity(ent)].push_back(static_cast<uint32_t>(s_Proxies.size()));
+		}
+		float invCount = 1.f / proxy.entities.size();
+		proxy.kAmbient *= invCount; proxy.kDiffuse *= invCount; proxy.kSpecular *= invCount; proxy.shininess *= invCount;
+
+		vec3 lo(FLT_MAX), hi(-FLT_MAX);
+		for (Vertex const& vtx : proxy.buffer->GetVertices()) { lo = min(lo, vtx.position); hi = max(hi, vtx.position); }
+		s_Nodes[i].min = lo; s_Nodes[i].max = hi; proxy.center = 0.5f * (lo + hi);
+		s_Nodes[i].proxy = static_cast<int32_t>(s_Proxies.size());
+		s_Proxies.push_back(std::move(proxy));
+	}
+
+	// proxies of cells that changed are dropped
+	s_Cache.swap(cache);
+}
+
+void Hlod::InvalidateProxies(entity _ent)
+{
+	auto idx = entt::to_entity(_ent);
+	if (idx >= s_EntityProxies.size()) { return; }
+	for (uint32_t proxy : s_EntityProxies[idx]) { s_Proxies[proxy].isValid = false; }
+}
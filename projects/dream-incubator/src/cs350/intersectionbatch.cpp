@@ -0,0 +1,216 @@
+/**
+@file    intersectionbatch.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition for batch intersection test functions, the
+scalar kernels and runtime instruction set dispatch.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/intersectionbatch.hpp>
+#include <cmath>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct ScalarLane
+ * @brief 1 wide lane for the shared kernels. Min/Max keep the operand order of
+ * minps/maxps (second operand returned on NaN or equal) so results match SIMD.
+ */
+struct ScalarLane
+{
+	using F = float;
+	using M = bool;
+	static constexpr unsigned Width = 1;
+
+	static F Load(float const* _p) { return *_p; }
+	static void Store(float* _p, F _v) { *_p = _v; }
+	static F Set(float _f) { return _f; }
+	static F Add(F _a, F _b) { return _a + _b; }
+	static F Sub(F _a, F _b) { return _a - _b; }
+	static F Mul(F _a, F _b) { return _a * _b; }
+	static F Div(F _a, F _b) { return _a / _b; }
+	static F Min(F _a, F _b) { return _a < _b ? _a : _b; }
+	static F Max(F _a, F _b) { return _a > _b ? _a : _b; }
+	static F Sqrt(F _a) { return std::sqrt(_a); }
+	static F Abs(F _a) { return std::fabs(_a); }
+	static M Lt(F _a, F _b) { return _a < _b; }
+	static M Le(F _a, F _b) { return _a <= _b; }
+	static M Gt(F _a, F _b) { return _a > _b; }
+	static M Ge(F _a, F _b) { return _a >= _b; }
+	static M And(M _a, M _b) { return _a && _b; }
+	static M Or(M _a, M _b) { return _a || _b; }
+	static F Select(M _m, F _a, F _b) { return _m ? _a : _b; }
+	static unsigned MoveMask(M _m) { return _m ? 1u : 0u; }
+};
+
+BatchKernels const* GetBatchKernelsScalar()
+{
+	static BatchKernels const s_Kernels = MakeBatchKernels<ScalarLane>();
+	return &s_Kernels;
+}
+
+/**
+ * @brief checks cpu features and which kernels were compiled in
+ */
+static BATCH_ISA DetectBatchIsa()
+{
+	bool hasSse41{ false }, hasAvx2{ false };
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4]; __cpuid(info, 1);
+	hasSse41 = (info[2] & (1 << 19)) != 0;
+	// avx needs os support for saving ymm registers
+	bool hasOsAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+	__cpuidex(info, 7, 0);
+	hasAvx2 = hasOsAvx && (info[1] & (1 << 5)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	hasSse41 = __builtin_cpu_supports("sse4.1");
+	hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
+	if (hasAvx2 && GetBatchKernelsAvx2()) { return BATCH_ISA_AVX2; }
+	if (hasSse41 && GetBatchKernelsSse4()) { return BATCH_ISA_SSE4; }
+	return BATCH_ISA_SCALAR;
+}
+
+BATCH_ISA GetBatchIsaSupported()
+{
+	static BATCH_ISA const s_Supported = DetectBatchIsa();
+	return s_Supported;
+}
+
+static BATCH_ISA s_BatchIsa = BATCH_ISA_TOTAL; // unset until first use
+
+BATCH_ISA GetBatchIsa()
+{
+	if (s_BatchIsa == BATCH_ISA_TOTAL) { s_BatchIsa = GetBatchIsaSupported(); }
+	return s_BatchIsa;
+}
+
+void SetBatchIsa(BATCH_ISA _isa)
+{
+	s_BatchIsa = _isa < GetBatchIsaSupported() ? _isa : GetBatchIsaSupported();
+}
+
+BatchKernels const& GetBatchKernels()
+{
+	switch (GetBatchIsa())
+	{
+	case BATCH_ISA_AVX2: return *GetBatchKernelsAvx2();
+	case BATCH_ISA_SSE4: return *GetBatchKernelsSse4();
+	default: return *GetBatchKernelsScalar();
+	}
+}
+
+BatchRay MakeBatchRay(vec3 const& _s, vec3 const& _dir)
+{
+	BatchRay ray;
+	for (int i = 0; i < 3; ++i)
+	{
+		ray.s[i] = _s[i]; ray.dir[i] = _dir[i];
+		ray.invDir[i] = SafeInvDir(_dir[i]);
+	}
+	ray.dirLen2 = _dir.x * _dir.x + _dir.y * _dir.y + _dir.z * _dir.z;
+	ray.invDirLen2 = 1.f / ray.dirLen2;
+	return ray;
+}
+
+/**
+ * @brief packs plane for kernels
+ */
+static BatchPlane MakeBatchPlane(vec3 const& _n, float _d)
+{
+	return BatchPlane{ { _n.x, _n.y, _n.z }, { std::abs(_n.x), std::abs(_n.y), std::abs(_n.z) }, _d };
+}
+
+BatchFrustum MakeBatchFrustum(mat4 const& _vp)
+{
+	vec4 r0 = vec4(_vp[0][0], _vp[1][0], _vp[2][0], _vp[3][0]);
+	vec4 r1 = vec4(_vp[0][1], _vp[1][1], _vp[2][1], _vp[3][1]);
+	vec4 r2 = vec4(_vp[0][2], _vp[1][2], _vp[2][2], _vp[3][2]);
+	vec4 r3 = vec4(_vp[0][3], _vp[1][3], _vp[2][3], _vp[3][3]);
+	// negated so normals point out of frustum, n.p - d > 0 is outside
+	vec4 planes[6]{ -r3 - r0, -r3 + r0, -r3 - r1, -r3 + r1, -r3 - r2, -r3 + r2 }; // l r b t n f
+
+	BatchFrustum frustum;
+	for (int i = 0; i < 6; ++i)
+	{
+		float invLen = 1.f / length(vec3(planes[i]));
+		frustum.planes[i] = MakeBatchPlane(vec3(planes[i]) * invLen, -planes[i].w * invLen);
+	}
+	return frustum;
+}
+
+/**
+ * Batch tests, kernels process whole lanes and the scalar kernel finishes the tail
+ */
+
+void IntersectionTimeRayAabbBatch(vec3 const& _s, vec3 const& _dir, AabbSoA const& _aabbs, float* _outT)
+{
+	BatchRay ray = MakeBatchRay(_s, _dir); AabbSoAView view = _aabbs.View();
+	RayAabbKernel<ScalarLane>(ray, view, GetBatchKernels().rayAabb(ray, view, 0, _outT), _outT);
+}
+
+void IntersectionTimeRaySphereBatch(vec3 const& _s, vec3 const& _dir, SphereSoA const& _spheres, float* _outT)
+{
+	BatchRay ray = MakeBatchRay(_s, _dir); SphereSoAView view = _spheres.View();
+	RaySphereKernel<ScalarLane>(ray, view, GetBatchKernels().raySphere(ray, view, 0, _outT), _outT);
+}
+
+void IntersectionTimeRayTriangleBatch(vec3 const& _s, vec3 const& _dir, TriangleSoA const& _tris, float* _outT)
+{
+	BatchRay ray = MakeBatchRay(_s, _dir); TriangleSoAView view = _tris.View();
+	RayTriangleKernel<ScalarLane>(ray, view, GetBatchKernels().rayTriangle(ray, view, 0, _outT), _outT);
+}
+
+void OverlapSphereAabbBatch(vec3 const& _c, float _r, AabbSoA const& _aabbs, uint8_t* _out)
+{
+	BatchSphere sphere{ { _c.x, _c.y, _c.z }, _r }; AabbSoAView view = _aabbs.View();
+	SphereAabbKernel<ScalarLane>(sphere, view, GetBatchKernels().sphereAabb(sphere, view, 0, _out), _out);
+}
+
+void OverlapSphereSphereBatch(vec3 const& _c, float _r, SphereSoA const& _spheres, uint8_t* _out)
+{
+	BatchSphere sphere{ { _c.x, _c.y, _c.z }, _r }; SphereSoAView view = _spheres.View();
+	SphereSphereKernel<ScalarLane>(sphere, view, GetBatchKernels().sphereSphere(sphere, view, 0, _out), _out);
+}
+
+void OverlapAabbAabbBatch(vec3 const& _min, vec3 const& _max, AabbSoA const& _aabbs, uint8_t* _out)
+{
+	BatchAabb aabb{ { _min.x, _min.y, _min.z }, { _max.x, _max.y, _max.z } }; AabbSoAView view = _aabbs.View();
+	AabbAabbKernel<ScalarLane>(aabb, view, GetBatchKernels().aabbAabb(aabb, view, 0, _out), _out);
+}
+
+void ClassifyPlaneAabbBatch(vec3 const& _n, float _d, AabbSoA const& _aabbs, int8_t* _out)
+{
+	BatchPlane plane = MakeBatchPlane(_n, _d); AabbSoAView view = _aabbs.View();
+	PlaneAabbKernel<ScalarLane>(plane, view, GetBatchKernels().planeAabb(plane, view, 0, _out), _out);
+}
+
+void ClassifyPlaneSphereBatch(vec3 const& _n, float _d, SphereSoA const& _spheres, int8_t* _out)
+{
+	BatchPlane plane = MakeBatchPlane(_n, _d); SphereSoAView view = _spheres.View();
+	PlaneSphereKernel<ScalarLane>(plane, view, GetBatchKernels().planeSphere(plane, view, 0, _out), _out);
+}
+
+void ClassifyFrustumAabbBatch(BatchFrustum const& _frustum, AabbSoA const& _aabbs, int8_t* _out)
+{
+	AabbSoAView view = _aabbs.View();
+	FrustumAabbKernel<ScalarLane>(_frustum, view, GetBatchKernels().frustumAabb(_frustum, view, 0, _out), _out);
+}
+
+void ClassifyFrustumSphereBatch(BatchFrustum const& _frustum, SphereSoA const& _spheres, int8_t* _out)
+{
+	SphereSoAView view = _spheres.View();
+	FrustumSphereKernel<ScalarLane>(_frustum, view, GetBatchKernels().frustumSphere(_frustum, view, 0, _out), _out);
+}
+
+void ClassifyFrustumObbBatch(BatchFrustum const& _frustum, ObbSoA const& _obbs, int8_t* _out)
+{
+	ObbSoAView view = _obbs.View();
+	FrustumObbKernel<ScalarLane>(_frustum, view, GetBatchKernels().frustumObb(_frustum, view, 0, _out), _out);
+}
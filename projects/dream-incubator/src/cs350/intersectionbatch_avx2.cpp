@@ -0,0 +1,63 @@
+/**
+@file    intersectionbatch_avx2.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the AVX2 batch intersection kernels. It is compiled with
+AVX2 enabled and only called when the CPU supports it.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/intersectionbatchkernels.hpp>
+#if defined(__AVX2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define BATCH_AVX2_ENABLED
+#include <immintrin.h>
+#endif
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+#ifdef BATCH_AVX2_ENABLED
+
+/**
+ * @struct Avx2Lane
+ * @brief 8 wide lane for the shared kernels. Comparisons are ordered and 
+ * non-signalling to match the SSE/scalar compares.
+ */
+struct Avx2Lane
+{
+	using F = __m256;
+	using M = __m256;
+	static constexpr unsigned Width = 8;
+
+	static F Load(float const* _p) { return _mm256_loadu_ps(_p); }
+	static void Store(float* _p, F _v) { _mm256_storeu_ps(_p, _v); }
+	static F Set(float _f) { return _mm256_set1_ps(_f); }
+	static F Add(F _a, F _b) { return _mm256_add_ps(_a, _b); }
+	static F Sub(F _a, F _b) { return _mm256_sub_ps(_a, _b); }
+	static F Mul(F _a, F _b) { return _mm256_mul_ps(_a, _b); }
+	static F Div(F _a, F _b) { return _mm256_div_ps(_a, _b); }
+	static F Min(F _a, F _b) { return _mm256_min_ps(_a, _b); }
+	static F Max(F _a, F _b) { return _mm256_max_ps(_a, _b); }
+	static F Sqrt(F _a) { return _mm256_sqrt_ps(_a); }
+	static F Abs(F _a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), _a); }
+	static M Lt(F _a, F _b) { return _mm256_cmp_ps(_a, _b, _CMP_LT_OQ); }
+	static M Le(F _a, F _b) { return _mm256_cmp_ps(_a, _b, _CMP_LE_OQ); }
+	static M Gt(F _a, F _b) { return _mm256_cmp_ps(_a, _b, _CMP_GT_OQ); }
+	static M Ge(F _a, F _b) { return _mm256_cmp_ps(_a, _b, _CMP_GE_OQ); }
+	static M And(M _a, M _b) { return _mm256_and_ps(_a, _b); }
+	static M Or(M _a, M _b) { return _mm256_or_ps(_a, _b); }
+	static F Select(M _m, F _a, F _b) { return _mm256_blendv_ps(_b, _a, _m); }
+	static unsigned MoveMask(M _m) { return static_cast<unsigned>(_mm256_movemask_ps(_m)); }
+};
+
+BatchKernels const* GetBatchKernelsAvx2()
+{
+	static BatchKernels const s_Kernels = MakeBatchKernels<Avx2Lane>();
+	return &s_Kernels;
+}
+
+#else
+
+BatchKernels const* GetBatchKernelsAvx2() { return nullptr; }
+
+#endif
@@ -0,0 +1,62 @@
+/**
+@file    intersectionbatch_sse4.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the SSE4.1 batch intersection kernels. It is compiled with
+SSE4.1 enabled and only called when the CPU supports it.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/intersectionbatchkernels.hpp>
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define BATCH_SSE4_ENABLED
+#include <smmintrin.h>
+#endif
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+#ifdef BATCH_SSE4_ENABLED
+
+/**
+ * @struct Sse4Lane
+ * @brief 4 wide lane for the shared kernels
+ */
+struct Sse4Lane
+{
+	using F = __m128;
+	using M = __m128;
+	static constexpr unsigned Width = 4;
+
+	static F Load(float const* _p) { return _mm_loadu_ps(_p); }
+	static void Store(float* _p, F _v) { _mm_storeu_ps(_p, _v); }
+	static F Set(float _f) { return _mm_set1_ps(_f); }
+	static F Add(F _a, F _b) { return _mm_add_ps(_a, _b); }
+	static F Sub(F _a, F _b) { return _mm_sub_ps(_a, _b); }
+	static F Mul(F _a, F _b) { return _mm_mul_ps(_a, _b); }
+	static F Div(F _a, F _b) { return _mm_div_ps(_a, _b); }
+	static F Min(F _a, F _b) { return _mm_min_ps(_a, _b); }
+	static F Max(F _a, F _b) { return _mm_max_ps(_a, _b); }
+	static F Sqrt(F _a) { return _mm_sqrt_ps(_a); }
+	static F Abs(F _a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), _a); }
+	static M Lt(F _a, F _b) { return _mm_cmplt_ps(_a, _b); }
+	static M Le(F _a, F _b) { return _mm_cmple_ps(_a, _b); }
+	static M Gt(F _a, F _b) { return _mm_cmpgt_ps(_a, _b); }
+	static M Ge(F _a, F _b) { return _mm_cmpge_ps(_a, _b); }
+	static M And(M _a, M _b) { return _mm_and_ps(_a, _b); }
+	static M Or(M _a, M _b) { return _mm_or_ps(_a, _b); }
+	static F Select(M _m, F _a, F _b) { return _mm_blendv_ps(_b, _a, _m); }
+	static unsigned MoveMask(M _m) { return static_cast<unsigned>(_mm_movemask_ps(_m)); }
+};
+
+BatchKernels const* GetBatchKernelsSse4()
+{
+	static BatchKernels const s_Kernels = MakeBatchKernels<Sse4Lane>();
+	return &s_Kernels;
+}
+
+#else
+
+BatchKernels const* GetBatchKernelsSse4() { return nullptr; }
+
+#endif
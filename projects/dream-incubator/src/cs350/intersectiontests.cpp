@@ -122,38 +122,20 @@ float IntersectionTimeRaySphere(vec3 const& _s, vec3 const& _dir, vec3 const& _c
 
 float IntersectionTimeRayAabb(vec3 const& _s, vec3 const& _dir, vec3 const& _min, vec3 const& _max)
 {
-	// TODO: update to non branching code for optimization
-	float tmin = -1.f; // set to -FLT_MAX to get first hit on line
-	float tmax = FLT_MAX; // set to max distance ray can travel (for segment)
-	// for all three slabs
+	// branchless slab test, same operations as the batch kernel in intersectionbatchkernels.hpp
+	float tEnter = -FLT_MAX; 
+	float tExit = FLT_MAX; 
 	for (int i = 0; i < 3; i++)
 	{
-		if (abs(_dir[i]) < cEpsilon)
-		{
-			// origin not within slab
-			if (_s[i] < _min[i] || _s[i] > _max[i]) { return -1; }
-		}
-		else
-		{
-			// compute intersection t value of ray with near and far plane of slab
-			float invD = 1.0f / _dir[i];
-			float t1 = (_min[i] - _s[i]) * invD;
-			float t2 = (_max[i] - _s[i]) * invD;
-			// t1 - near plane, t2 - far plane
-			if (t1 > t2)
-			{
-				float tmp = t1;
-				t1 = t2;
-				t2 = tmp;
-			}
-			if (t1 > tmin) { tmin = t1; }
-			if (t2 < tmax) { tmax = t2; }
-
-		}
+		float invD = SafeInvDir(_dir[i]);
+		float t1 = (_min[i] - _s[i]) * invD;
+		float t2 = (_max[i] - _s[i]) * invD;
+		float tNear = t1 < t2 ? t1 : t2;
+		float tFar = t1 > t2 ? t1 : t2;
+		tEnter = tEnter > tNear ? tEnter : tNear;
+		tExit = tExit < tFar ? tExit : tFar;
 	}
-	if (tmin > tmax) { return -1; }
-	if (tmin < 0 && tmax > 0) { return 0; }
-	return tmin;
+	return (tEnter <= tExit && tExit > 0.f) ? (tEnter > 0.f ? tEnter : 0.f) : -1.f;
 }
 
 SIDE_RESULT ClassifyPlaneSphere(vec3 const& _n, float _d, vec3 const& _c, float _r)
@@ -200,5 +182,154 @@ SIDE_RESULT ClassifyPlaneObb(vec3 const& _n, float _d, vec3 const& _c, vec3 cons
 }
 
 
+/**
+ * @brief smallest root of a t^2 + 2 b t + c = 0 at or after 0, -1 if none
+ */
+static float SmallestRoot(float _a, float _b, float _c)
+{
+	if (_c <= 0.f) { return 0.f; } // starts inside
+	if (_b >= 0.f || _a <= 0.f) { return -1.f; } // moving away or not moving
+	float discr = _b * _b - _a * _c;
+	if (discr < 0.f) { return -1.f; }
+	return (-_b - sqrt(discr)) / _a;
+}
+
+float IntersectionTimeRayCapsule(vec3 const& _s, vec3 const& _dir, vec3 const& _A, vec3 const& _B, float _r)
+{
+	// Ericson 5.3.7, infinite cylinder first then the end caps
+	vec3 d = _B - _A, m = _s - _A;
+	float md = dot(m, d), nd = dot(_dir, d), dd = dot(d, d);
+	float nn = dot(_dir, _dir), mn = dot(m, _dir);
+	float k = dot(m, m) - _r * _r;
+	float a = dd * nn - nd * nd;
+	float c = dd * k - md * md;
+	float best = -1.f;
+	if (a > cEpsilon * dd * nn)
+	{
+		float t = SmallestRoot(a, dd * mn - nd * md, c);
+		float proj = md + t * nd; // position of hit along segment, times dd
+		if (t >= 0.f && proj >= 0.f && proj <= dd) { best = t; }
+	}
+	if (best == 0.f) { return 0.f; }
+	// end caps, also handles ray parallel to segment
+	for (vec3 const& cap : { _A, _B })
+	{
+		vec3 L = _s - cap;
+		float t = SmallestRoot(nn, dot(L, _dir), dot(L, L) - _r * _r);
+		if (t >= 0.f && (best < 0.f || t < best)) { best = t; }
+	}
+	return best;
+}
+
+float IntersectionTimeMovingSphereSphere(vec3 const& _c1, float _r1, vec3 const& _v, vec3 const& _c2, float _r2)
+{
+	if (CheckNaN(_c1) || CheckNaN(_v) || CheckNaN(_c2)) { return -1; }
+	// ray vs sphere of summed radius
+	vec3 L = _c1 - _c2; float r = _r1 + _r2;
+	float t = SmallestRoot(dot(_v, _v), dot(L, _v), dot(L, L) - r * r);
+	return t <= 1.f ? t : -1.f;
+}
+
+float IntersectionTimeMovingSpherePlane(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _n, float _d)
+{
+	if (CheckNaN(_c) || CheckNaN(_v) || CheckNaN(_n)) { return -1; }
+	float dist = dot(_n, _c) - _d;
+	if (abs(dist) <= _r) { return 0.f; }
+	float denom = dot(_n, _v);
+	// moving parallel to or away from plane
+	if (denom * dist >= 0.f) { return -1; }
+	float t = ((dist > 0.f ? _r : -_r) - dist) / denom;
+	return t <= 1.f ? t : -1.f;
+}
+
+float IntersectionTimeMovingSphereAabb(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _min, vec3 const& _max)
+{
+	if (CheckNaN(_c) || CheckNaN(_v) || CheckNaN(_min) || CheckNaN(_max)) { return -1; }
+	if (OverlapSphereAabb(_c, _r, _min, _max)) { return 0.f; }
+	// Ericson 5.5.7, ray vs box expanded by radius, then round off edges and corners
+	float t = IntersectionTimeRayAabb(_c, _v, _min - vec3(_r), _max + vec3(_r));
+	if (t < 0.f || t > 1.f) { return -1; }
+	vec3 p = _c + _v * t;
+	int u = 0, v = 0; // axes p is below min / above max
+	for (int i = 0; i < 3; ++i)
+	{
+		if (p[i] < _min[i]) { u |= 1 << i; }
+		if (p[i] > _max[i]) { v |= 1 << i; }
+	}
+	int mask = u + v;
+	// face region, slab hit is exact
+	if (mask == 0 || mask == 1 || mask == 2 || mask == 4) { return t; }
+	auto corner = [&](int _n) { return vec3(_n & 1 ? _max.x : _min.x, _n & 2 ? _max.y : _min.y, _n & 4 ? _max.z : _min.z); };
+	float best = -1.f;
+	auto testEdge = [&](int _a, int _b)
+	{
+		float te = IntersectionTimeRayCapsule(_c, _v, corner(_a), corner(_b), _r);
+		if (te >= 0.f && (best < 0.f || te < best)) { best = te; }
+	};
+	if (mask == 7)
+	{
+		// corner region, the 3 edges meeting at the corner
+		testEdge(v, v ^ 1); testEdge(v, v ^ 2); testEdge(v, v ^ 4);
+	}
+	else
+	{
+		// edge region, the edge along the axis p is inside on
+		int axis = 7 ^ mask;
+		testEdge(v, v ^ axis);
+	}
+	return best <= 1.f ? best : -1.f;
+}
+
+float IntersectionTimeMovingSphereTriangle(vec3 const& _c, float _r, vec3 const& _v, vec3 const& _A, vec3 const& _B, vec3 const& _C)
+{
+	if (CheckNaN(_c) || CheckNaN(_v) || CheckNaN(_A) || CheckNaN(_B) || CheckNaN(_C)) { return -1; }
+	vec3 n = cross(_B - _A, _C - _A);
+	if (length2(n) <= cEpsilon * cEpsilon) { return -1; }
+	n = normalize(n);
+	// face first, if the sphere touches the plane inside the triangle that is the first contact
+	float t = IntersectionTimeMovingSpherePlane(_c, _r, _v, n, dot(n, _A));
+	if (t >= 0.f)
+	{
+		vec3 p = _c + _v * t;
+		vec3 q = p - n * (dot(n, p) - dot(n, _A)); // closest point on plane
+		if (OverlapPointTriangle(q, _A, _B, _C)) { return t; }
+	}
+	// otherwise sphere hits an edge or vertex first
+	float best = -1.f;
+	for (auto [a, b] : { std::pair{ _A, _B }, std::pair{ _B, _C }, std::pair{ _C, _A } })
+	{
+		float te = IntersectionTimeRayCapsule(_c, _v, a, b, _r);
+		if (te >= 0.f && (best < 0.f || te < best)) { best = te; }
+	}
+	return best <= 1.f ? best : -1.f;
+}
+
+float IntersectionTimeMovingAabbAabb(vec3 const& _min1, vec3 const& _max1, vec3 const& _v, vec3 const& _min2, vec3 const& _max2)
+{
+	if (CheckNaN(_min1) || CheckNaN(_max1) || CheckNaN(_v) || CheckNaN(_min2) || CheckNaN(_max2)) { return -1; }
+	if (OverlapAabbAabb(_min1, _max1, _min2, _max2)) { return 0.f; }
+	// Ericson 5.5.8, first and last time of overlap on each axis
+	float tFirst = 0.f, tLast = 1.f;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (_v[i] < 0.f)
+		{
+			if (_max1[i] < _min2[i]) { return -1; } // moving apart
+			if (_min1[i] > _max2[i]) { tFirst = max((_max2[i] - _min1[i]) / _v[i], tFirst); }
+			if (_max1[i] > _min2[i]) { tLast = min((_min2[i] - _max1[i]) / _v[i], tLast); }
+		}
+		else if (_v[i] > 0.f)
+		{
+			if (_min1[i] > _max2[i]) { return -1; } // moving apart
+			if (_max1[i] < _min2[i]) { tFirst = max((_min2[i] - _max1[i]) / _v[i], tFirst); }
+			if (_min1[i] < _max2[i]) { tLast = min((_max2[i] - _min1[i]) / _v[i], tLast); }
+		}
+		else if (_max1[i] < _min2[i] || _min1[i] > _max2[i]) { return -1; } // separated and not moving on axis
+		if (tFirst > tLast) { return -1; }
+	}
+	return tFirst;
+}
+
 bool CheckNaN(float _f) { return _f != _f; }
-bool CheckNaN(vec3 _v) { return (CheckNaN(_v.x) || CheckNaN(_v.y) || CheckNaN(_v.z)); }
\ No newline at end of file
+bool CheckNaN(vec3 _v) { return (CheckNaN(_v.x) || CheckNaN(_v.y) || CheckNaN(_v.z)); }
+float SafeInvDir(float _d) { return abs(_d) < cEpsilon ? (_d < 0.f ? -FLT_MAX : FLT_MAX) : 1.f / _d; }
\ No newline at end of file
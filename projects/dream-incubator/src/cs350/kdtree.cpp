@@ -11,105 +11,321 @@ This file contains the definition of the KdTree class.
 #include <cs350/intersectiontests.hpp>
 #include <components/material.hpp>
 #include <random>
+#include <parallel.hpp>
+#include <algorithm>
+#include <numeric>
+#include <thread>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
-void KdTree::BuildKDTree(int _depth, std::unique_ptr<TreeNode> const& _node, std::vector<entity>& _ents)
+constexpr unsigned KD_MIN_PARALLEL_OBJS = 1024; // smaller subtrees are not worth a thread
+
+void KdTree::BuildKDTree(std::vector<entity> const& _ents)
 {
-	// init root bv
-	if (_depth == 0)
+	// gather object AABBs once, rebuilds only touch these arrays
+	m_Ents = _ents;
+	m_ObjMin.resize(m_Ents.size()); m_ObjMax.resize(m_Ents.size());
+	auto aabbs = GetAABBs(m_Ents);
+	for (size_t i = 0; i < aabbs.size(); ++i)
 	{
-		_node->bv = std::make_shared<Aabb>(MergeAabbs(GetAABBs(_ents)));
-		ECS.registry().get<BVList>(m_KdTreeEnt).push_back(_node->bv);
+		m_ObjMin[i] = aabbs[i]->GetMin(); m_ObjMax[i] = aabbs[i]->GetMax();
 	}
+	Rebuild();
+}
+
+void KdTree::Rebuild()
+{
+	ClearTree(); // keeps capacity so rebuilds do not allocate
+	unsigned numObjs = static_cast<unsigned>(m_Ents.size());
+	if (numObjs == 0) { return; }
 
-	if (m_VisibilityFlags.size() <= _depth) { m_VisibilityFlags.push_back(std::vector<bool*>()); }
-	m_VisibilityFlags[_depth].push_back(&_node->bv->isActive); _node->bv->isActive = true;
-	_node->bv->depth = _depth;
+	vec3 min = vec3(FLT_MAX); vec3 max = vec3(-FLT_MAX);
+	m_Keys.resize(numObjs); m_Indices.resize(numObjs);
+	for (unsigned i = 0; i < numObjs; ++i)
+	{
+		m_Keys[i] = m_SplitStrategy == TOP_DOWN_BV_EXTENT_MEDIAN ? m_ObjMin[i] : (m_ObjMin[i] + m_ObjMax[i]) * 0.5f;
+		m_Indices[i] = i;
+		min = glm::min(min, m_ObjMin[i]); max = glm::max(max, m_ObjMax[i]);
+	}
+
+	m_ParallelDepth = 0;
+	while ((1u << m_ParallelDepth) < GetNumWorkerThreads()) { ++m_ParallelDepth; }
+
+	m_Nodes.resize(CountNodes(numObjs));
+	BuildNode(0, 0, numObjs, 0, min, max);
+}
+
+unsigned KdTree::CountNodes(unsigned _count) const
+{
+	if (_count <= static_cast<unsigned>(std::max(m_NumObjPerNode, 1))) { return 1; }
+	return 1 + CountNodes(_count / 2) + CountNodes(_count - _count / 2);
+}
+
+void KdTree::BuildNode(int _node, unsigned _first, unsigned _count, int _depth, vec3 _min, vec3 _max)
+{
+	KdNode& node = m_Nodes[_node];
+	node = KdNode();
+	node.min = _min; node.max = _max;
+	node.first = _first; node.count = _count;
 
 	// termination based on number of objects per node
-	if (_ents.size() <= m_NumObjPerNode)
+	if (_count <= static_cast<unsigned>(std::max(m_NumObjPerNode, 1))) { return; }
+
+	// median split, left half of range has keys <= split and right half >= split
+	int axis = _depth % 3;
+	unsigned half = _count / 2;
+	auto begin = m_Indices.begin() + _first;
+	std::nth_element(begin, begin + half, begin + _count, [this, axis](unsigned _a, unsigned _b)
+		{ return m_Keys[_a][axis] < m_Keys[_b][axis]; });
+	float split = clamp(m_Keys[m_Indices[_first + half]][axis], _min[axis], _max[axis]);
+
+	// subtree layout is known up front, left child follows parent and right follows left subtree
+	int left = _node + 1;
+	int right = left + static_cast<int>(CountNodes(half));
+	node.axis = axis; node.split = split;
+	node.children[0] = left; node.children[1] = right;
+
+	vec3 leftMax = _max; leftMax[axis] = split;
+	vec3 rightMin = _min; rightMin[axis] = split;
+	if (_depth < m_ParallelDepth && _count >= KD_MIN_PARALLEL_OBJS)
+	{
+		std::thread leftThread([=, this]() { BuildNode(left, _first, half, _depth + 1, _min, leftMax); });
+		BuildNode(right, _first + half, _count - half, _depth + 1, rightMin, _max);
+		leftThread.join();
+	}
+	else
+	{
+		BuildNode(left, _first, half, _depth + 1, _min, leftMax);
+		BuildNode(right, _first + half, _count - half, _depth + 1, rightMin, _max);
+	}
+}
+
+void KdTree::BuildDebugVolumes()
+{
+	BVList& bvList = ECS.registry().get<BVList>(m_KdTreeEnt); bvList.clear();
+	m_VisibilityFlags.clear();
+	if (m_Nodes.empty()) { return; }
+
+	std::random_device rd; std::mt19937 gen(rd());
+	std::uniform_real_distribution<> dis(0, 1.f);// smtimes produces bad results - change to HSV?
+
+	std::vector<std::pair<int, int>> nodes{ { 0, 0 } }; // node, depth
+	while (!nodes.empty())
 	{
-		_node->type = TreeNode::NODE_TYPE::LEAF;
-		_node->entities = _ents;
+		auto [idx, depth] = nodes.back(); nodes.pop_back();
+		KdNode const& node = m_Nodes[idx];
+
+		auto bv = std::make_shared<Aabb>();
+		bv->center = (node.min + node.max) * 0.5f;
+		bv->halfExtents = (node.max - node.min) * 0.5f;
+		bv->depth = depth; bv->isActive = true;
+		bvList.push_back(bv);
+		if (m_VisibilityFlags.size() <= depth) { m_VisibilityFlags.push_back(std::vector<bool*>()); }
+		m_VisibilityFlags[depth].push_back(&bv->isActive);
+
+		if (node.axis >= 0)
+		{
+			nodes.push_back({ node.children[1], depth + 1 });
+			nodes.push_back({ node.children[0], depth + 1 });
+			continue;
+		}
 		// color objects
-		std::random_device rd; std::mt19937 gen(rd());
-		std::uniform_real_distribution<> dis(0, 1.f);// smtimes produces bad results - change to HSV?
-		vec3 clr = /*clrs[dis(gen)];*/vec3(dis(gen), dis(gen), dis(gen));
-		for (auto ent : _node->entities)
+		vec3 clr = vec3(dis(gen), dis(gen), dis(gen));
+		for (unsigned i = node.first; i < node.first + node.count; ++i)
 		{
-			ECS.registry().get<Material>(ent).kAmbient
-				= ECS.registry().get<Material>(ent).kDiffuse = clr;
+			Material& mat = ECS.registry().get<Material>(m_Ents[m_Indices[i]]);
+			mat.kAmbient = mat.kDiffuse = clr;
 		}
 	}
-	else // split
+}
+
+/**
+  * @brief clips ray against AABB
+  * @param _s - start position of ray
+  * @param _invDir - 1 / direction of ray
+  * @param _min - min of AABB
+  * @param _max - max of AABB
+  * @param _tMin - entry time
+  * @param _tMax - exit time
+  * @return true if ray overlaps AABB
+  */
+static bool ClipRayAabb(vec3 const& _s, vec3 const& _invDir, vec3 const& _min, vec3 const& _max, float& _tMin, float& _tMax)
+{
+	_tMin = -FLT_MAX; _tMax = FLT_MAX;
+	for (int i = 0; i < 3; ++i)
 	{
-		_node->type = TreeNode::NODE_TYPE::INTERNAL;
-
-		// store split point in internal point
-		std::vector<entity> left;
-		std::vector<entity> right;
-		float splitPoint = PartitionObjects(_ents, _depth % 3, left, _node->entities, right);
-
-		_node->pLeft = std::make_unique<TreeNode>();
-		_node->pRight = std::make_unique<TreeNode>();
-
-		// split parent bv
-		auto splitAABB = SplitAABB(dynamic_cast<Aabb&>(*_node->bv), _depth % 3, splitPoint);
-		_node->pLeft->bv = std::make_shared<Aabb>(splitAABB.first);
-		_node->pRight->bv = std::make_shared<Aabb>(splitAABB.second);
-		ECS.registry().get<BVList>(m_KdTreeEnt).push_back(_node->pLeft->bv);
-		ECS.registry().get<BVList>(m_KdTreeEnt).push_back(_node->pRight->bv);
-
-		// create subtrees
-		BuildKDTree(_depth + 1, _node->pLeft, left);
-		BuildKDTree(_depth + 1, _node->pRight, right);
+		float t1 = (_min[i] - _s[i]) * _invDir[i];
+		float t2 = (_max[i] - _s[i]) * _invDir[i];
+		if (t1 != t1 || t2 != t2) { continue; } // ray parallel to and on slab plane
+		_tMin = max(_tMin, min(t1, t2));
+		_tMax = min(_tMax, max(t1, t2));
 	}
+	return _tMin <= _tMax && _tMax >= 0.f;
+}
+
+void KdTree::BuildRopes()
+{
+	m_RopeLeafObjs.clear();
+	if (m_Nodes.empty()) { return; }
+
+	std::vector<unsigned> objs(m_Ents.size());
+	std::iota(objs.begin(), objs.end(), 0u);
+	DistributeObjects(0, objs);
+	LinkRopes(0, { -1, -1, -1, -1, -1, -1 });
 }
 
-float KdTree::PartitionObjects(std::vector<entity>& _ents, int _axis, std::vector<entity>& _left, std::vector<entity>& _split, std::vector<entity>& _right)
+void KdTree::DistributeObjects(int _node, std::vector<unsigned> const& _objs)
 {
-	// sort entities by split strategy
-	std::sort(_ents.begin(), _ents.end(), [&_axis, &m_SplitStrategy = m_SplitStrategy](entity _ent, entity _ent1)
+	KdNode& node = m_Nodes[_node];
+	if (node.axis < 0)
+	{
+		node.ropeFirst = static_cast<unsigned>(m_RopeLeafObjs.size());
+		node.ropeCount = static_cast<unsigned>(_objs.size());
+		m_RopeLeafObjs.insert(m_RopeLeafObjs.end(), _objs.begin(), _objs.end());
+		return;
+	}
+
+	// objects straddling the split plane go to both children
+	std::vector<unsigned> left, right;
+	for (unsigned obj : _objs)
+	{
+		if (m_ObjMin[obj][node.axis] <= node.split) { left.push_back(obj); }
+		if (m_ObjMax[obj][node.axis] >= node.split) { right.push_back(obj); }
+	}
+	DistributeObjects(node.children[0], left);
+	DistributeObjects(node.children[1], right);
+}
+
+void KdTree::LinkRopes(int _node, std::array<int, 6> _ropes)
+{
+	KdNode& node = m_Nodes[_node];
+	if (node.axis < 0)
+	{
+		for (int i = 0; i < 6; ++i) { node.ropes[i] = _ropes[i]; }
+		return;
+	}
+	int left = node.children[0]; int right = node.children[1]; int axis = node.axis;
+	std::array<int, 6> leftRopes = _ropes;  leftRopes[axis * 2 + 1] = right;
+	std::array<int, 6> rightRopes = _ropes; rightRopes[axis * 2] = left;
+	LinkRopes(left, leftRopes);
+	LinkRopes(right, rightRopes);
+}
+
+KdRayHit KdTree::RayCast(vec3 const& _s, vec3 const& _dir, KDTREE_TRAVERSAL_TYPE _type)
+{
+	return _type == KD_TRAVERSAL_ROPES ? TraverseRopes(_s, _dir, FLT_MAX, false) : TraverseStack(_s, _dir, FLT_MAX, false);
+}
+
+KdRayHit KdTree::ShadowRay(vec3 const& _s, vec3 const& _dir, float _tMax, KDTREE_TRAVERSAL_TYPE _type)
+{
+	return _type == KD_TRAVERSAL_ROPES ? TraverseRopes(_s, _dir, _tMax, true) : TraverseStack(_s, _dir, _tMax, true);
+}
+
+KdRayHit KdTree::TraverseRopes(vec3 const& _s, vec3 const& _dir, float _tMax, bool _isAnyHit)
+{
+	KdRayHit hit;
+	if (m_Nodes.empty()) { return hit; }
+
+	vec3 invDir = vec3(1.f) / _dir;
+	float tEntry, tExit;
+	if (!ClipRayAabb(_s, invDir, m_Nodes[0].min, m_Nodes[0].max, tEntry, tExit)) { return hit; }
+
+	float t = max(tEntry, 0.f);
+	float closest = _tMax;
+	int node = 0;
+	while (node >= 0 && t <= closest)
+	{
+		// descend from rope target to leaf containing entry point
+		vec3 p = _s + _dir * t;
+		while (m_Nodes[node].axis >= 0)
+		{
+			KdNode const& internal = m_Nodes[node]; ++hit.nodesVisited;
+			int axis = internal.axis;
+			bool isLeft = p[axis] < internal.split || (p[axis] == internal.split && _dir[axis] < 0.f);
+			node = internal.children[isLeft ? 0 : 1];
+		}
+		KdNode const& leaf = m_Nodes[node]; ++hit.nodesVisited;
+
+		for (unsigned i = leaf.ropeFirst; i < leaf.ropeFirst + leaf.ropeCount; ++i)
 		{
-			BVList& bvList = ECS.registry().get<BVList>(_ent);
-			auto bv = std::dynamic_pointer_cast<Aabb>(*std::find_if(bvList.begin(), bvList.end(),
-				[](std::shared_ptr<BoundingVolume> _bv) { return  _bv->type == AABB; }));
-			BVList& bvList1 = ECS.registry().get<BVList>(_ent1);
-			auto bv1 = std::dynamic_pointer_cast<Aabb>(*std::find_if(bvList1.begin(), bvList1.end(),
-				[](std::shared_ptr<BoundingVolume> _bv) { return  _bv->type == AABB; }));
-
-			switch (m_SplitStrategy)
+			unsigned obj = m_RopeLeafObjs[i];
+			float tHit = IntersectionTimeRayAabb(_s, _dir, m_ObjMin[obj], m_ObjMax[obj]);
+			if (tHit >= 0.f && tHit < closest)
 			{
-			case TOP_DOWN_BV_CENTER_MEDIAN: return bv->center[_axis] < bv1->center[_axis];
-			case TOP_DOWN_BV_EXTENT_MEDIAN: return bv->GetMin()[_axis] < bv1->GetMin()[_axis];
+				closest = hit.t = tHit; hit.ent = m_Ents[obj];
+				if (_isAnyHit) { return hit; }
 			}
-		});
-	// check for coplanar points
-	_split.push_back(_ents[_ents.size() / 2]); std::remove(_ents.begin(), _ents.end(), _split.back());
-	BVList& bvList = ECS.registry().get<BVList>(_split.back());
-	auto bv = std::dynamic_pointer_cast<Aabb>(*std::find_if(bvList.begin(), bvList.end(),
-		[](std::shared_ptr<BoundingVolume> _bv) { return  _bv->type == AABB; }));
-	vec3 splitPoint = m_SplitStrategy == TOP_DOWN_BV_CENTER_MEDIAN ? bv->center : bv->GetMin();
-	for (auto ent : _ents)
+		}
+
+		// find exit face of leaf
+		float tLeafExit = FLT_MAX; int face = -1;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (_dir[axis] == 0.f) { continue; }
+			bool isPositive = _dir[axis] > 0.f;
+			float tFace = ((isPositive ? leaf.max[axis] : leaf.min[axis]) - _s[axis]) * invDir[axis];
+			if (tFace < tLeafExit) { tLeafExit = tFace; face = axis * 2 + (isPositive ? 1 : 0); }
+		}
+		// hit inside this leaf cannot be beaten by leaves further along the ray
+		if (face < 0 || closest <= tLeafExit) { break; }
+		t = tLeafExit;
+		node = leaf.ropes[face];
+	}
+	return hit;
+}
+
+KdRayHit KdTree::TraverseStack(vec3 const& _s, vec3 const& _dir, float _tMax, bool _isAnyHit)
+{
+	KdRayHit hit;
+	if (m_Nodes.empty()) { return hit; }
+
+	vec3 invDir = vec3(1.f) / _dir;
+	float tMin, tMax;
+	if (!ClipRayAabb(_s, invDir, m_Nodes[0].min, m_Nodes[0].max, tMin, tMax)) { return hit; }
+	tMin = max(tMin, 0.f);
+
+	struct StackEntry { int node; float tMin; float tMax; };
+	thread_local std::vector<StackEntry> stack; stack.clear();
+
+	float closest = _tMax;
+	int node = 0;
+	while (true)
 	{
-		BVList& bvList = ECS.registry().get<BVList>(ent);
-		auto bv = std::dynamic_pointer_cast<Aabb>(*std::find_if(bvList.begin(), bvList.end(),
-			[](std::shared_ptr<BoundingVolume> _bv) { return  _bv->type == AABB; }));
+		// descend to nearest leaf, push far child if ray crosses split plane
+		while (m_Nodes[node].axis >= 0)
+		{
+			KdNode const& internal = m_Nodes[node]; ++hit.nodesVisited;
+			int axis = internal.axis;
+			bool isLeftNear = _s[axis] < internal.split || (_s[axis] == internal.split && _dir[axis] <= 0.f);
+			int nearChild = internal.children[isLeftNear ? 0 : 1];
+			int farChild = internal.children[isLeftNear ? 1 : 0];
+			if (_dir[axis] == 0.f) { node = nearChild; continue; }
+
+			float tSplit = (internal.split - _s[axis]) * invDir[axis];
+			if (tSplit > tMax || tSplit <= 0.f) { node = nearChild; }
+			else if (tSplit < tMin) { node = farChild; }
+			else
+			{
+				stack.push_back({ farChild, tSplit, tMax });
+				node = nearChild; tMax = tSplit;
+			}
+		}
+		KdNode const& leaf = m_Nodes[node]; ++hit.nodesVisited;
 
-		switch (m_SplitStrategy)
+		for (unsigned i = leaf.ropeFirst; i < leaf.ropeFirst + leaf.ropeCount; ++i)
 		{
-		case TOP_DOWN_BV_CENTER_MEDIAN: if (bv->center[_axis] == splitPoint[_axis])   { _split.push_back(ent); } break;
-		case TOP_DOWN_BV_EXTENT_MEDIAN: if (bv->GetMin()[_axis] == splitPoint[_axis]) { _split.push_back(ent); } break;
+			unsigned obj = m_RopeLeafObjs[i];
+			float tHit = IntersectionTimeRayAabb(_s, _dir, m_ObjMin[obj], m_ObjMax[obj]);
+			if (tHit >= 0.f && tHit < closest)
+			{
+				closest = hit.t = tHit; hit.ent = m_Ents[obj];
+				if (_isAnyHit) { return hit; }
+			}
 		}
+
+		if (closest <= tMax || stack.empty()) { break; }
+		node = stack.back().node; tMin = stack.back().tMin; tMax = stack.back().tMax;
+		stack.pop_back();
 	}
-	// remove points at internal nodes from entlist
-	for (auto ent : _split)
-	{ std::remove(_ents.begin(), _ents.end(), ent); }
-	// split ents
-	unsigned k = _ents.size() / 2;
-	_left = std::vector<entity>(_ents.begin(), _ents.begin() + k);
-	_right = std::vector<entity>(_ents.begin() + k, _ents.end());
-
-	return splitPoint[_axis];
-}
\ No newline at end of file
+	return hit;
+}
@@ -0,0 +1,244 @@
+/**
+@file    meshoptimize.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of mesh optimisation at import.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/meshoptimize.hpp>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @struct FifoCache
+ * @brief This struct holds a simulated fifo vertex cache, a vertex is cached
+ * while fewer than size misses happened since its own
+ */
+struct FifoCache
+{
+	std::vector<uint32_t> stamps;
+	uint32_t size;
+	uint32_t time;
+
+	FifoCache(size_t _numVertices, uint32_t _size) : stamps(_numVertices, 0), size(_size), time(_size + 1) {}
+
+	bool IsCached(uint32_t _v) const { return time - stamps[_v] <= size; }
+	/**
+	  * @brief true if it missed
+	  */
+	bool Touch(uint32_t _v)
+	{
+		if (IsCached(_v)) { return false; }
+		stamps[_v] = time++;
+		return true;
+	}
+	void Flush() { time += size + 1; }
+};
+
+/**
+ * @struct TriangleAdjacency
+ * @brief This struct holds the triangles using each vertex, those of vertex v
+ * are triangles[offsets[v], offsets[v + 1])
+ */
+struct TriangleAdjacency
+{
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> triangles;
+
+	TriangleAdjacency(std::vector<uint32_t> const& _idx, size_t _numVertices) : offsets(_numVertices + 1, 0), triangles(_idx.size())
+	{
+		for (uint32_t v : _idx) { ++offsets[v + 1]; }
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < _idx.size(); ++i) { triangles[next[_idx[i]]++] = static_cast<uint32_t>(i / 3); }
+	}
+};
+
+float ComputeAcmr(std::vector<uint32_t> const& _idx, size_t _numVertices, uint32_t _cacheSize)
+{
+	if (_idx.size() < 3) { return 0.f; }
+	FifoCache cache(_numVertices, _cacheSize);
+	size_t misses = 0;
+	for (uint32_t v : _idx) { misses += cache.Touch(v); }
+	return static_cast<float>(misses) / static_cast<float>(_idx.size() / 3);
+}
+
+std::vector<uint32_t> OptimizeVertexCache(std::vector<uint32_t> const& _idx, size_t _numVertices, std::vector<uint32_t>* _clusters)
+{
+	if (_clusters) { _clusters->clear(); }
+	size_t numTris = _idx.size() / 3;
+	if (numTris == 0) { return _idx; }
+
+	TriangleAdjacency adj(_idx, _numVertices);
+	std::vector<uint32_t> live(_numVertices); // triangles of each vertex not emitted yet
+	for (size_t v = 0; v < _numVertices; ++v) { live[v] = adj.offsets[v + 1] - adj.offsets[v]; }
+	std::vector<char> isEmitted(numTris, 0);
+	std::vector<uint32_t> deadEnd; // vertices of emitted triangles, most recent last
+	std::vector<uint32_t> candidates;
+	FifoCache cache(_numVertices, MESH_VERTEX_CACHE_SIZE);
+	std::vector<uint32_t> ret; ret.reserve(_idx.size());
+
+	// a vertex still in use from the dead end stack, else the next in input order
+	uint32_t cursor = 0;
+	auto skipDeadEnd = [&]() -> int64_t
+	{
+		while (!deadEnd.empty())
+		{
+			uint32_t v = deadEnd.back(); deadEnd.pop_back();
+			if (live[v] > 0) { return v; }
+		}
+		while (cursor < _numVertices) { if (live[cursor] > 0) { return cursor; } ++cursor; }
+		return -1;
+	};
+
+	int64_t fan = skipDeadEnd();
+	if (_clusters) { _clusters->push_back(0); }
+	while (fan >= 0)
+	{
+		// emit every triangle around the fanning vertex
+		candidates.clear();
+		for (uint32_t a = adj.offsets[fan]; a < adj.offsets[fan + 1]; ++a)
+		{
+			uint32_t t = adj.triangles[a];
+			if (isEmitted[t]) { continue; }
+			isEmitted[t] = 1;
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t v = _idx[t * 3 + k];
+				ret.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				--live[v];
+				cache.Touch(v);
+			}
+		}
+
+		// next fans around the oldest cached neighbour whose triangles will still hit the cache
+		int64_t next = -1;
+		int64_t best = -1;
+		for (uint32_t v : candidates)
+		{
+			if (live[v] == 0) { continue; }
+			int64_t priority = 0;
+			int64_t age = cache.time - cache.stamps[v];
+			if (age + 2 * live[v] <= cache.size) { priority = age; }
+			if (priority > best) { best = priority; next = v; }
+		}
+		if (next < 0)
+		{
+			// nothing cached is left to fan around, what follows starts cold
+			next = skipDeadEnd();
+			if (next >= 0 && _clusters) { _clusters->push_back(static_cast<uint32_t>(ret.size() / 3)); }
+		}
+		fan = next;
+	}
+	return ret;
+}
+
+std::vector<uint32_t> OptimizeOverdraw(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	std::vector<uint32_t> const& _clusters, float _threshold)
+{
+	size_t numTris = _idx.size() / 3;
+	if (numTris == 0 || _clusters.empty()) { return _idx; }
+
+	// splits each cluster where the misses so far are within the threshold of the whole cluster's
+	FifoCache cache(_vtx.size(), MESH_VERTEX_CACHE_SIZE);
+	auto countMisses = [&](size_t _begin, size_t _end)
+	{
+		uint32_t misses = 0;
+		for (size_t i = _begin * 3; i < _end * 3; ++i) { misses += cache.Touch(_idx[i]); }
+		return misses;
+	};
+	std::vector<uint32_t> bounds;
+	for (size_t c = 0; c < _clusters.size(); ++c)
+	{
+		size_t begin = _clusters[c], end = c + 1 < _clusters.size() ? _clusters[c + 1] : numTris;
+		cache.Flush();
+		float threshold = _threshold * static_cast<float>(countMisses(begin, end)) / static_cast<float>(end - begin);
+
+		cache.Flush();
+		bounds.push_back(static_cast<uint32_t>(begin));
+		uint32_t misses = 0, tris = 0;
+		for (size_t t = begin; t < end; ++t)
+		{
+			misses += countMisses(t, t + 1); ++tris;
+			if (t + 1 < end && static_cast<float>(misses) <= threshold * static_cast<float>(tris))
+			{
+				bounds.push_back(static_cast<uint32_t>(t + 1));
+				cache.Flush(); misses = 0; tris = 0;
+			}
+		}
+	}
+
+	// area weighted centroid and normal of each cluster and of the mesh
+	std::vector<vec3> centroids(bounds.size(), vec3(0.f)), normals(bounds.size(), vec3(0.f));
+	std::vector<float> areas(bounds.size(), 0.f);
+	vec3 meshCentroid(0.f);
+	float meshArea = 0.f;
+	for (size_t c = 0; c < bounds.size(); ++c)
+	{
+		size_t end = c + 1 < bounds.size() ? bounds[c + 1] : numTris;
+		for (size_t t = bounds[c]; t < end; ++t)
+		{
+			vec3 const& p0 = _vtx[_idx[t * 3]].position, & p1 = _vtx[_idx[t * 3 + 1]].position, & p2 = _vtx[_idx[t * 3 + 2]].position;
+			vec3 n = cross(p1 - p0, p2 - p0);
+			float area = length(n);
+			centroids[c] += (p0 + p1 + p2) * (area / 3.f);
+			normals[c] += n;
+			areas[c] += area;
+		}
+		meshCentroid += centroids[c];
+		meshArea += areas[c];
+	}
+	if (meshArea > 0.f) { meshCentroid = meshCentroid / meshArea; }
+
+	// clusters facing away from the centre are in front of the rest from most views
+	std::vector<float> keys(bounds.size(), 0.f);
+	for (size_t c = 0; c < bounds.size(); ++c)
+	{
+		if (areas[c] <= 0.f || length2(normals[c]) <= 0.f) { continue; }
+		keys[c] = dot(centroids[c] / areas[c] - meshCentroid, normalize(normals[c]));
+	}
+	std::vector<uint32_t> order(bounds.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&keys](uint32_t _a, uint32_t _b) { return keys[_a] > keys[_b]; });
+
+	std::vector<uint32_t> ret; ret.reserve(_idx.size());
+	for (uint32_t c : order)
+	{
+		size_t end = c + 1 < bounds.size() ? bounds[c + 1] : numTris;
+		ret.insert(ret.end(), _idx.begin() + bounds[c] * 3, _idx.begin() + end * 3);
+	}
+	return ret;
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& _vtx, std::vector<uint32_t>& _idx)
+{
+	std::vector<uint32_t> remap(_vtx.size(), UINT32_MAX);
+	std::vector<Vertex> vtx; vtx.reserve(_vtx.size());
+	for (uint32_t& i : _idx)
+	{
+		if (remap[i] == UINT32_MAX) { remap[i] = static_cast<uint32_t>(vtx.size()); vtx.push_back(_vtx[i]); }
+		i = remap[i];
+	}
+	_vtx.swap(vtx);
+}
+
+MeshOptimizeStats OptimizeMesh(std::vector<Vertex>& _vtx, std::vector<uint32_t>& _idx)
+{
+	MeshOptimizeStats stats;
+	stats.acmrBefore = ComputeAcmr(_idx, _vtx.size());
+	if (_idx.size() % 3 != 0 || _idx.empty()) { stats.acmrAfter = stats.acmrBefore; return stats; }
+
+	std::vector<uint32_t> clusters;
+	std::vector<uint32_t> idx = OptimizeVertexCache(_idx, _vtx.size(), &clusters);
+	_idx = OptimizeOverdraw(_vtx, idx, clusters);
+	OptimizeVertexFetch(_vtx, _idx);
+	stats.acmrAfter = ComputeAcmr(_idx, _vtx.size());
+	return stats;
+}
@@ -0,0 +1,236 @@
+/**
+@file    occlusionbuffer.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the OcclusionBuffer class.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/occlusionbuffer.hpp>
+#include <parallel.hpp>
+#include <cfloat>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static unsigned constexpr OCCLUSION_TILES_X = OCCLUSION_WIDTH / cRasterTileSize;
+static unsigned constexpr OCCLUSION_TILES_Y = OCCLUSION_HEIGHT / cRasterTileSize;
+static unsigned constexpr OCCLUSION_MIN_CHUNK = 1; // occluders per thread, one mesh is already a lot of triangles
+static unsigned constexpr OCCLUSION_MIN_TILE_CHUNK = 16; // tiles per thread
+
+OcclusionBuffer::OcclusionBuffer()
+	: m_Tiles(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, 1.f), m_Bins(OCCLUSION_TILES_X * OCCLUSION_TILES_Y)
+{
+	for (unsigned w = OCCLUSION_WIDTH / 2, h = OCCLUSION_HEIGHT / 2; w > 0 && h > 0; w /= 2, h /= 2)
+	{
+		m_MaxDepth.emplace_back(w * h, 1.f);
+		m_MinDepth.emplace_back(w * h, 1.f);
+	}
+}
+
+/**
+ * @brief sets up edge functions and depth plane of a screen space triangle,
+ * either winding is kept since occluders may be open meshes
+ */
+static void AddScreenTriangle(vec3 const& _a, vec3 const& _b, vec3 const& _c, std::vector<BatchRasterTriangle>& _out)
+{
+	// pixels whose centers may be covered, clamped before casting as vertices can be far off screen
+	float minX = min(_a.x, min(_b.x, _c.x)), maxX = max(_a.x, max(_b.x, _c.x));
+	float minY = min(_a.y, min(_b.y, _c.y)), maxY = max(_a.y, max(_b.y, _c.y));
+	BatchRasterTriangle tri;
+	tri.minX = static_cast<int>(floor(clamp(minX, 0.f, static_cast<float>(OCCLUSION_WIDTH))));
+	tri.maxX = static_cast<int>(floor(clamp(maxX, -1.f, static_cast<float>(OCCLUSION_WIDTH - 1))));
+	tri.minY = static_cast<int>(floor(clamp(minY, 0.f, static_cast<float>(OCCLUSION_HEIGHT))));
+	tri.maxY = static_cast<int>(floor(clamp(maxY, -1.f, static_cast<float>(OCCLUSION_HEIGHT - 1))));
+	if (tri.minX > tri.maxX || tri.minY > tri.maxY) { return; }
+
+	float area = (_b.x - _a.x) * (_c.y - _a.y) - (_b.y - _a.y) * (_c.x - _a.x);
+	if (!(abs(area) > 1e-6f)) { return; } // degenerate or nan
+	float sign = area > 0.f ? 1.f : -1.f, invArea = 1.f / area;
+
+	// edge opposite each vertex, its value over area is the barycentric weight of that vertex
+	vec3 const* v[3] = { &_a, &_b, &_c };
+	for (int i = 0; i < 3; ++i)
+	{
+		vec3 const& p = *v[(i + 1) % 3]; vec3 const& q = *v[(i + 2) % 3];
+		float e[3] = { p.y - q.y, q.x - p.x, p.x * q.y - p.y * q.x };
+		for (int j = 0; j < 3; ++j) { tri.edge[i][j] = e[j] * sign; }
+	}
+	for (int j = 0; j < 3; ++j)
+	{ tri.depth[j] = (tri.edge[0][j] * _a.z + tri.edge[1][j] * _b.z + tri.edge[2][j] * _c.z) * sign * invArea; }
+	_out.push_back(tri);
+}
+
+void OcclusionBuffer::SetupTriangle(vec4 const& _v0, vec4 const& _v1, vec4 const& _v2, std::vector<BatchRasterTriangle>& _out) const
+{
+	// outside the same side or far plane
+	if (_v0.x > _v0.w && _v1.x > _v1.w && _v2.x > _v2.w) { return; }
+	if (_v0.x < -_v0.w && _v1.x < -_v1.w && _v2.x < -_v2.w) { return; }
+	if (_v0.y > _v0.w && _v1.y > _v1.w && _v2.y > _v2.w) { return; }
+	if (_v0.y < -_v0.w && _v1.y < -_v1.w && _v2.y < -_v2.w) { return; }
+	if (_v0.z > _v0.w && _v1.z > _v1.w && _v2.z > _v2.w) { return; }
+
+	// clip to near plane z >= -w, a triangle becomes at most a quad
+	vec4 const in[3] = { _v0, _v1, _v2 };
+	vec4 poly[4]; int count = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		vec4 const& a = in[i]; vec4 const& b = in[(i + 1) % 3];
+		float da = a.z + a.w, db = b.z + b.w;
+		if (da >= 0.f) { poly[count++] = a; }
+		if ((da >= 0.f) != (db >= 0.f)) { poly[count++] = a + (b - a) * (da / (da - db)); }
+	}
+	if (count < 3) { return; }
+
+	vec3 screen[4];
+	for (int i = 0; i < count; ++i)
+	{
+		float invW = 1.f / poly[i].w;
+		screen[i] = vec3((poly[i].x * invW * 0.5f + 0.5f) * OCCLUSION_WIDTH,
+			(poly[i].y * invW * 0.5f + 0.5f) * OCCLUSION_HEIGHT, poly[i].z * invW);
+	}
+	for (int i = 1; i + 1 < count; ++i) { AddScreenTriangle(screen[0], screen[i], screen[i + 1], _out); }
+}
+
+void OcclusionBuffer::Rasterize(std::vector<OccluderMesh> const& _occluders)
+{
+	std::fill(m_Tiles.begin(), m_Tiles.end(), 1.f);
+	for (auto& bin : m_Bins) { bin.clear(); }
+
+	// transform and set up triangles, each thread keeps its own list
+	m_ThreadClip.resize(GetNumWorkerThreads());
+	m_ThreadTriangles.resize(GetNumWorkerThreads());
+	unsigned numChunks = ParallelFor(static_cast<unsigned>(_occluders.size()), [&](unsigned _begin, unsigned _end, unsigned _thread)
+	{
+		std::vector<vec4>& clip = m_ThreadClip[_thread];
+		std::vector<BatchRasterTriangle>& tris = m_ThreadTriangles[_thread];
+		tris.clear();
+		for (unsigned i = _begin; i < _end; ++i)
+		{
+			OccluderMesh const& mesh = _occluders[i];
+			clip.resize(mesh.numVertices);
+			char const* pos = reinterpret_cast<char const*>(mesh.positions);
+			for (uint32_t j = 0; j < mesh.numVertices; ++j)
+			{ clip[j] = mesh.mvp * vec4(*reinterpret_cast<vec3 const*>(pos + j * mesh.stride), 1.f); }
+
+			uint32_t count = mesh.indices ? mesh.numIndices : mesh.numVertices;
+			auto vertex = [&](uint32_t _j) -> vec4 const& { return clip[mesh.indices ? mesh.indices[_j] : _j]; };
+			if (mesh.isStrip)
+			{ for (uint32_t j = 2; j < count; ++j) { SetupTriangle(vertex(j - 2), vertex(j - 1), vertex(j), tris); } }
+			else
+			{ for (uint32_t j = 2; j < count; j += 3) { SetupTriangle(vertex(j - 2), vertex(j - 1), vertex(j), tris); } }
+		}
+	}, OCCLUSION_MIN_CHUNK);
+
+	// bin in chunk order, each tile lists the triangles whose bounds touch it
+	m_Triangles.clear();
+	for (unsigned chunk = 0; chunk < numChunks; ++chunk)
+	{ m_Triangles.insert(m_Triangles.end(), m_ThreadTriangles[chunk].begin(), m_ThreadTriangles[chunk].end()); }
+	m_NumTriangles = static_cast<uint32_t>(m_Triangles.size());
+	for (uint32_t i = 0; i < m_NumTriangles; ++i)
+	{
+		BatchRasterTriangle const& tri = m_Triangles[i];
+		for (unsigned ty = tri.minY / cRasterTileSize; ty <= tri.maxY / cRasterTileSize; ++ty)
+		{
+			for (unsigned tx = tri.minX / cRasterTileSize; tx <= tri.maxX / cRasterTileSize; ++tx)
+			{ m_Bins[ty * OCCLUSION_TILES_X + tx].push_back(i); }
+		}
+	}
+
+	// tiles do not share memory, nearest depth wins so triangle order does not matter
+	BatchKernels const& kernels = GetBatchKernels();
+	ParallelFor(OCCLUSION_TILES_X * OCCLUSION_TILES_Y, [&](unsigned _begin, unsigned _end, unsigned)
+	{
+		for (unsigned tile = _begin; tile < _end; ++tile)
+		{
+			float* depth = m_Tiles.data() + tile * cRasterTileSize * cRasterTileSize;
+			for (uint32_t i : m_Bins[tile])
+			{ kernels.rasterTile(m_Triangles[i], tile % OCCLUSION_TILES_X, tile / OCCLUSION_TILES_X, depth); }
+		}
+	}, OCCLUSION_MIN_TILE_CHUNK);
+
+	BuildHierarchy();
+}
+
+float OcclusionBuffer::GetDepth(unsigned _x, unsigned _y) const
+{
+	unsigned tile = (_y / cRasterTileSize) * OCCLUSION_TILES_X + _x / cRasterTileSize;
+	return m_Tiles[tile * cRasterTileSize * cRasterTileSize + (_y % cRasterTileSize) * cRasterTileSize + _x % cRasterTileSize];
+}
+
+float OcclusionBuffer::GetMaxDepth(uint32_t _level, unsigned _x, unsigned _y) const
+{
+	return _level == 0 ? GetDepth(_x, _y) : m_MaxDepth[_level - 1][_y * (OCCLUSION_WIDTH >> _level) + _x];
+}
+
+float OcclusionBuffer::GetMinDepth(uint32_t _level, unsigned _x, unsigned _y) const
+{
+	return _level == 0 ? GetDepth(_x, _y) : m_MinDepth[_level - 1][_y * (OCCLUSION_WIDTH >> _level) + _x];
+}
+
+void OcclusionBuffer::BuildHierarchy()
+{
+	for (uint32_t level = 1; level < GetNumLevels(); ++level)
+	{
+		unsigned w = OCCLUSION_WIDTH >> level, h = OCCLUSION_HEIGHT >> level;
+		for (unsigned y = 0; y < h; ++y)
+		{
+			for (unsigned x = 0; x < w; ++x)
+			{
+				float maxD = -FLT_MAX, minD = FLT_MAX;
+				for (unsigned i = 0; i < 4; ++i)
+				{
+					maxD = max(maxD, GetMaxDepth(level - 1, 2 * x + (i & 1), 2 * y + (i >> 1)));
+					minD = min(minD, GetMinDepth(level - 1, 2 * x + (i & 1), 2 * y + (i >> 1)));
+				}
+				m_MaxDepth[level - 1][y * w + x] = maxD;
+				m_MinDepth[level - 1][y * w + x] = minD;
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::IsRegionOccluded(uint32_t _level, ivec2 const& _min, ivec2 const& _max, float _zNear, float _zFar) const
+{
+	for (int ty = _min.y >> _level; ty <= _max.y >> _level; ++ty)
+	{
+		for (int tx = _min.x >> _level; tx <= _max.x >> _level; ++tx)
+		{
+			// behind the farthest occluder here
+			if (_zNear > GetMaxDepth(_level, tx, ty)) { continue; }
+			// in front of every occluder here, or a pixel it may show through
+			if (_level == 0 || _zFar < GetMinDepth(_level, tx, ty)) { return false; }
+
+			ivec2 childMin = max(_min, ivec2(tx << _level, ty << _level));
+			ivec2 childMax = min(_max, ivec2(((tx + 1) << _level) - 1, ((ty + 1) << _level) - 1));
+			if (!IsRegionOccluded(_level - 1, childMin, childMax, _zNear, _zFar)) { return false; }
+		}
+	}
+	return true;
+}
+
+bool OcclusionBuffer::IsOccluded(mat4 const& _vp, vec3 const& _min, vec3 const& _max) const
+{
+	vec2 screenMin(FLT_MAX), screenMax(-FLT_MAX);
+	float zNear = FLT_MAX, zFar = -FLT_MAX;
+	for (int i = 0; i < 8; ++i)
+	{
+		vec4 p = _vp * vec4(i & 1 ? _max.x : _min.x, i & 2 ? _max.y : _min.y, i & 4 ? _max.z : _min.z, 1.f);
+		// crossing near plane, its depth in front of the camera is unknown
+		if (p.z < -p.w || p.w <= 0.f) { return false; }
+		float invW = 1.f / p.w;
+		vec2 screen((p.x * invW * 0.5f + 0.5f) * OCCLUSION_WIDTH, (p.y * invW * 0.5f + 0.5f) * OCCLUSION_HEIGHT);
+		screenMin = min(screenMin, screen); screenMax = max(screenMax, screen);
+		zNear = min(zNear, p.z * invW); zFar = max(zFar, p.z * invW);
+	}
+	vec2 const size(OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+	ivec2 pixelMin = ivec2(floor(clamp(screenMin, vec2(0.f), size)));
+	ivec2 pixelMax = ivec2(floor(clamp(screenMax, vec2(-1.f), size - 1.f)));
+	if (pixelMin.x > pixelMax.x || pixelMin.y > pixelMax.y) { return false; }
+
+	// coarsest level the rectangle covers at most 2x2 texels of
+	uint32_t level = 0;
+	while (level + 1 < GetNumLevels() && ((pixelMax.x >> level) - (pixelMin.x >> level) > 1 || (pixelMax.y >> level) - (pixelMin.y >> level) > 1))
+	{ ++level; }
+	return IsRegionOccluded(level, pixelMin, pixelMax, zNear - OCCLUSION_DEPTH_BIAS, zFar);
+}
@@ -0,0 +1,222 @@
+/**
+@file    pointkdtree.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the PointKdTree class.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/pointkdtree.hpp>
+#include <components/renderable.hpp>
+#include <parallel.hpp>
+#include <algorithm>
+#include <numeric>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+std::unordered_map<std::string, PointKdTree> PointKdTree::s_MeshTrees;
+
+/**
+ * @struct PointKdRange
+ * @brief subrange of the implicit tree still to be visited
+ */
+struct PointKdRange
+{
+	unsigned lo, hi;
+	float dist2; // lower bound of squared distance from query to any point in range
+};
+
+void PointKdTree::Build(std::vector<Vertex> const& _vertices)
+{
+	std::vector<vec3> points(_vertices.size());
+	for (size_t i = 0; i < _vertices.size(); ++i) { points[i] = _vertices[i].position; }
+	Build(points);
+}
+
+void PointKdTree::Build(std::vector<vec3> const& _points)
+{
+	Clear();
+	if (_points.empty()) { return; }
+
+	unsigned n = static_cast<unsigned>(_points.size());
+	m_Indices.resize(n);
+	std::iota(m_Indices.begin(), m_Indices.end(), 0u);
+	m_Axes.assign(n, 0);
+	BuildRange(_points, 0, n);
+
+	// gather points into tree order so queries walk memory linearly
+	m_Points.resize(n);
+	for (unsigned i = 0; i < n; ++i) { m_Points[i] = _points[m_Indices[i]]; }
+}
+
+void PointKdTree::Clear()
+{
+	m_Points.clear();
+	m_Indices.clear();
+	m_Axes.clear();
+}
+
+void PointKdTree::BuildRange(std::vector<vec3> const& _points, unsigned _lo, unsigned _hi)
+{
+	while (_hi - _lo > 1)
+	{
+		// split along axis of greatest extent
+		vec3 min(FLT_MAX), max(-FLT_MAX);
+		for (unsigned i = _lo; i < _hi; ++i)
+		{
+			vec3 const& p = _points[m_Indices[i]];
+			min = glm::min(min, p); max = glm::max(max, p);
+		}
+		vec3 extent = max - min;
+		uint8_t axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+
+		unsigned mid = _lo + (_hi - _lo) / 2;
+		std::nth_element(m_Indices.begin() + _lo, m_Indices.begin() + mid, m_Indices.begin() + _hi,
+			[&_points, axis](unsigned _a, unsigned _b) { return _points[_a][axis] < _points[_b][axis]; });
+		m_Axes[mid] = axis;
+
+		// recurse on smaller half, loop on larger half, the half after mid is never larger
+		BuildRange(_points, mid + 1, _hi);
+		_hi = mid;
+	}
+}
+
+PointKdResult PointKdTree::Nearest(vec3 const& _p) const
+{
+	PointKdResult best;
+	if (m_Points.empty()) { return best; }
+
+	PointKdRange stack[s_MaxDepth * 2]; unsigned top = 0;
+	stack[top++] = { 0, Size(), 0.f };
+	while (top)
+	{
+		PointKdRange r = stack[--top];
+		if (r.lo >= r.hi || r.dist2 >= best.dist2) { continue; }
+
+		unsigned mid = r.lo + (r.hi - r.lo) / 2;
+		vec3 const& pt = m_Points[mid];
+		float d2 = glm::distance2(_p, pt);
+		if (d2 < best.dist2) { best.dist2 = d2; best.idx = m_Indices[mid]; }
+
+		float diff = _p[m_Axes[mid]] - pt[m_Axes[mid]];
+		PointKdRange lo{ r.lo, mid, r.dist2 }, hi{ mid + 1, r.hi, r.dist2 };
+		(diff < 0.f ? hi : lo).dist2 = std::max(r.dist2, diff * diff);
+		// push far side first so near side is visited first
+		stack[top++] = diff < 0.f ? hi : lo;
+		stack[top++] = diff < 0.f ? lo : hi;
+	}
+	return best;
+}
+
+unsigned PointKdTree::KNearest(vec3 const& _p, unsigned _k, PointKdResult* _out) const
+{
+	if (m_Points.empty() || _k == 0) { return 0; }
+
+	// _out is kept as a max heap of the best _k so far
+	unsigned count = 0;
+	PointKdRange stack[s_MaxDepth * 2]; unsigned top = 0;
+	stack[top++] = { 0, Size(), 0.f };
+	while (top)
+	{
+		PointKdRange r = stack[--top];
+		float bound = count < _k ? FLT_MAX : _out[0].dist2;
+		if (r.lo >= r.hi || r.dist2 >= bound) { continue; }
+
+		unsigned mid = r.lo + (r.hi - r.lo) / 2;
+		vec3 const& pt = m_Points[mid];
+		float d2 = glm::distance2(_p, pt);
+		if (count < _k)
+		{
+			_out[count++] = { m_Indices[mid], d2 };
+			std::push_heap(_out, _out + count);
+		}
+		else if (d2 < _out[0].dist2)
+		{
+			std::pop_heap(_out, _out + count);
+			_out[count - 1] = { m_Indices[mid], d2 };
+			std::push_heap(_out, _out + count);
+		}
+
+		float diff = _p[m_Axes[mid]] - pt[m_Axes[mid]];
+		PointKdRange lo{ r.lo, mid, r.dist2 }, hi{ mid + 1, r.hi, r.dist2 };
+		(diff < 0.f ? hi : lo).dist2 = std::max(r.dist2, diff * diff);
+		stack[top++] = diff < 0.f ? hi : lo;
+		stack[top++] = diff < 0.f ? lo : hi;
+	}
+	std::sort_heap(_out, _out + count);
+	return count;
+}
+
+unsigned PointKdTree::RadiusSearch(vec3 const& _p, float _radius, PointKdResult* _out, unsigned _maxResults) const
+{
+	if (m_Points.empty() || _maxResults == 0) { return 0; }
+
+	float r2 = _radius * _radius;
+	unsigned count = 0;
+	PointKdRange stack[s_MaxDepth * 2]; unsigned top = 0;
+	stack[top++] = { 0, Size(), 0.f };
+	while (top && count < _maxResults)
+	{
+		PointKdRange r = stack[--top];
+		if (r.lo >= r.hi || r.dist2 > r2) { continue; }
+
+		unsigned mid = r.lo + (r.hi - r.lo) / 2;
+		vec3 const& pt = m_Points[mid];
+		float d2 = glm::distance2(_p, pt);
+		if (d2 <= r2) { _out[count++] = { m_Indices[mid], d2 }; }
+
+		float diff = _p[m_Axes[mid]] - pt[m_Axes[mid]];
+		PointKdRange lo{ r.lo, mid, r.dist2 }, hi{ mid + 1, r.hi, r.dist2 };
+		(diff < 0.f ? hi : lo).dist2 = std::max(r.dist2, diff * diff);
+		stack[top++] = diff < 0.f ? hi : lo;
+		stack[top++] = diff < 0.f ? lo : hi;
+	}
+	return count;
+}
+
+void PointKdTree::NearestBatch(vec3 const* _queries, unsigned _count, PointKdResult* _out) const
+{
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned)
+		{
+			for (unsigned i = _begin; i < _end; ++i) { _out[i] = Nearest(_queries[i]); }
+		});
+}
+
+void PointKdTree::KNearestBatch(vec3 const* _queries, unsigned _count, unsigned _k, PointKdResult* _out, unsigned* _outCounts) const
+{
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned)
+		{
+			for (unsigned i = _begin; i < _end; ++i) { _outCounts[i] = KNearest(_queries[i], _k, _out + static_cast<size_t>(i) * _k); }
+		}, 64);
+}
+
+void PointKdTree::RadiusSearchBatch(vec3 const* _queries, unsigned _count, float _radius, PointKdResult* _out, unsigned _maxResults, unsigned* _outCounts) const
+{
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned)
+		{
+			for (unsigned i = _begin; i < _end; ++i) { _outCounts[i] = RadiusSearch(_queries[i], _radius, _out + static_cast<size_t>(i) * _maxResults, _maxResults); }
+		}, 64);
+}
+
+PointKdTree const& PointKdTree::GetMeshTree(std::string const& _mesh)
+{
+	auto it = s_MeshTrees.find(_mesh);
+	if (it != s_MeshTrees.end()) { return it->second; }
+
+	PointKdTree& tree = s_MeshTrees[_mesh];
+	auto buffers = Renderable::GetBuffers().find(_mesh);
+	if (buffers == Renderable::GetBuffers().end())
+	{
+		std::cout << "PointKdTree::GetMeshTree(): mesh " << _mesh << " not loaded." << std::endl;
+		return tree;
+	}
+
+	std::vector<vec3> points;
+	for (auto const& buf : buffers->second)
+	{
+		for (Vertex const& vtx : buf->GetVertices()) { points.push_back(vtx.position); }
+	}
+	tree.Build(points);
+	return tree;
+}
@@ -0,0 +1,281 @@
+/**
+@file    simplify.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of mesh simplification by quadric error
+metric edge collapse and level of detail generation.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/simplify.hpp>
+#include <cs350/meshoptimize.hpp>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <cfloat>
+#include <cmath>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static double constexpr SIMPLIFY_BORDER_WEIGHT = 10.0; // keeps open borders from shrinking
+static double constexpr SIMPLIFY_MIN_NORMAL_DOT = 0.25; // cos of max turn of a triangle in one collapse
+static float constexpr MESH_LOD_MAX_KEPT = 0.8f; // a lod keeping more of the lod before is not worth drawing
+
+/**
+ * @struct Quadric
+ * @brief This struct holds a sum of squared distances to planes,
+ * p^T A p + 2 b.p + c with A symmetric
+ */
+struct Quadric
+{
+	double a00{ 0 }, a01{ 0 }, a02{ 0 }, a11{ 0 }, a12{ 0 }, a22{ 0 };
+	double b0{ 0 }, b1{ 0 }, b2{ 0 };
+	double c{ 0 };
+
+	/**
+	  * @brief adds plane n.p + d = 0, n is unit length
+	  */
+	void AddPlane(dvec3 const& _n, double _d, double _weight)
+	{
+		a00 += _weight * _n.x * _n.x; a01 += _weight * _n.x * _n.y; a02 += _weight * _n.x * _n.z;
+		a11 += _weight * _n.y * _n.y; a12 += _weight * _n.y * _n.z; a22 += _weight * _n.z * _n.z;
+		b0 += _weight * _n.x * _d; b1 += _weight * _n.y * _d; b2 += _weight * _n.z * _d;
+		c += _weight * _d * _d;
+	}
+	void operator+=(Quadric const& _q)
+	{
+		a00 += _q.a00; a01 += _q.a01; a02 += _q.a02; a11 += _q.a11; a12 += _q.a12; a22 += _q.a22;
+		b0 += _q.b0; b1 += _q.b1; b2 += _q.b2; c += _q.c;
+	}
+	double Eval(dvec3 const& _p) const
+	{
+		double x = _p.x, y = _p.y, z = _p.z;
+		double err = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+			+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		return std::max(err, 0.0); // rounding can take it just below
+	}
+};
+
+/**
+ * @struct EdgeCollapse
+ * @brief This struct holds a candidate collapse of vertex from onto vertex to,
+ * it is stale once either vertex changed since it was queued
+ */
+struct EdgeCollapse
+{
+	double cost;
+	uint32_t from, to;
+	uint32_t fromVersion, toVersion;
+
+	bool operator>(EdgeCollapse const& _rhs) const { return cost > _rhs.cost; }
+};
+
+std::vector<uint32_t> SimplifyMesh(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	size_t _targetIndexCount, float _maxError, float& _error)
+{
+	_error = 0.f;
+	uint32_t numVtx = static_cast<uint32_t>(_vtx.size());
+	if (_idx.size() <= _targetIndexCount || numVtx == 0) { return _idx; }
+
+	// weld vertices with the same position, each weld keeps its vertices contiguous in order
+	std::vector<uint32_t> order(numVtx);
+	std::iota(order.begin(), order.end(), 0u);
+	auto isLess = [&_vtx](uint32_t _a, uint32_t _b)
+	{
+		vec3 const& a = _vtx[_a].position; vec3 const& b = _vtx[_b].position;
+		return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+	};
+	std::sort(order.begin(), order.end(), isLess);
+	std::vector<uint32_t> weld(numVtx), weldStart;
+	std::vector<dvec3> positions;
+	for (uint32_t i = 0; i < numVtx; ++i)
+	{
+		if (i == 0 || _vtx[order[i]].position != _vtx[order[i - 1]].position)
+		{
+			weldStart.push_back(i);
+			positions.push_back(dvec3(_vtx[order[i]].position));
+		}
+		weld[order[i]] = static_cast<uint32_t>(positions.size()) - 1;
+	}
+	uint32_t numWeld = static_cast<uint32_t>(positions.size());
+	weldStart.push_back(numVtx);
+
+	// triangles by welded vertex, ones already degenerate are dropped
+	std::vector<uint32_t> tris, corners;
+	for (size_t i = 0; i + 2 < _idx.size(); i += 3)
+	{
+		uint32_t a = weld[_idx[i]], b = weld[_idx[i + 1]], c = weld[_idx[i + 2]];
+		if (a == b || b == c || c == a) { continue; }
+		tris.insert(tris.end(), { a, b, c });
+		corners.insert(corners.end(), { _idx[i], _idx[i + 1], _idx[i + 2] });
+	}
+	uint32_t numTris = static_cast<uint32_t>(tris.size() / 3);
+	std::vector<uint8_t> isTriAlive(numTris, 1);
+	std::vector<std::vector<uint32_t>> vtxTris(numWeld);
+	for (uint32_t t = 0; t < numTris; ++t) { for (int k = 0; k < 3; ++k) { vtxTris[tris[t * 3 + k]].push_back(t); } }
+
+	// each vertex starts with the planes of its triangles
+	std::vector<Quadric> quadrics(numWeld);
+	std::vector<dvec3> triNormals(numTris, dvec3(0.0));
+	for (uint32_t t = 0; t < numTris; ++t)
+	{
+		dvec3 const& p0 = positions[tris[t * 3]];
+		dvec3 n = cross(positions[tris[t * 3 + 1]] - p0, positions[tris[t * 3 + 2]] - p0);
+		double len = length(n);
+		if (len == 0.0) { continue; }
+		n /= len; triNormals[t] = n;
+		for (int k = 0; k < 3; ++k) { quadrics[tris[t * 3 + k]].AddPlane(n, -dot(n, p0), 1.0); }
+	}
+
+	// edges used by one triangle are borders, a plane along them keeps them in place
+	std::vector<std::pair<uint64_t, uint32_t>> edges; edges.reserve(tris.size());
+	for (uint32_t t = 0; t < numTris; ++t)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			uint32_t a = tris[t * 3 + k], b = tris[t * 3 + (k + 1) % 3];
+			edges.push_back({ (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b), t });
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+
+	std::vector<uint32_t> version(numWeld, 0);
+	std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> heap;
+	auto queueEdge = [&](uint32_t _a, uint32_t _b)
+	{
+		Quadric q = quadrics[_a]; q += quadrics[_b];
+		double costAB = q.Eval(positions[_b]), costBA = q.Eval(positions[_a]);
+		if (costAB <= costBA) { heap.push({ costAB, _a, _b, version[_a], version[_b] }); }
+		else { heap.push({ costBA, _b, _a, version[_b], version[_a] }); }
+	};
+	for (size_t i = 0; i < edges.size();)
+	{
+		size_t j = i + 1;
+		while (j < edges.size() && edges[j].first == edges[i].first) { ++j; }
+		uint32_t a = static_cast<uint32_t>(edges[i].first >> 32), b = static_cast<uint32_t>(edges[i].first);
+		uint32_t t = edges[i].second;
+		if (j - i == 1 && triNormals[t] != dvec3(0.0))
+		{
+			dvec3 n = cross(positions[b] - positions[a], triNormals[t]);
+			double len = length(n);
+			if (len > 0.0)
+			{
+				n /= len;
+				quadrics[a].AddPlane(n, -dot(n, positions[a]), SIMPLIFY_BORDER_WEIGHT);
+				quadrics[b].AddPlane(n, -dot(n, positions[a]), SIMPLIFY_BORDER_WEIGHT);
+			}
+		}
+		i = j;
+	}
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		if (i > 0 && edges[i].first == edges[i - 1].first) { continue; }
+		queueEdge(static_cast<uint32_t>(edges[i].first >> 32), static_cast<uint32_t>(edges[i].first));
+	}
+
+	// a collapse is skipped if a triangle moved by it would flip or turn too far
+	auto isValid = [&](uint32_t _from, uint32_t _to)
+	{
+		for (uint32_t t : vtxTris[_from])
+		{
+			if (!isTriAlive[t]) { continue; }
+			uint32_t const* tri = &tris[t * 3];
+			if (tri[0] == _to || tri[1] == _to || tri[2] == _to) { continue; }
+			dvec3 p[3], q[3];
+			for (int k = 0; k < 3; ++k) { p[k] = positions[tri[k]]; q[k] = tri[k] == _from ? positions[_to] : p[k]; }
+			dvec3 n0 = cross(p[1] - p[0], p[2] - p[0]), n1 = cross(q[1] - q[0], q[2] - q[0]);
+			if (dot(n0, n1) <= SIMPLIFY_MIN_NORMAL_DOT * length(n0) * length(n1)) { return false; }
+		}
+		return true;
+	};
+
+	size_t numAlive = numTris;
+	double maxCost = static_cast<double>(_maxError) * _maxError, worstCost = 0.0;
+	std::vector<uint32_t> neighbours;
+	while (numAlive * 3 > _targetIndexCount && !heap.empty())
+	{
+		EdgeCollapse collapse = heap.top(); heap.pop();
+		uint32_t from = collapse.from, to = collapse.to;
+		if (version[from] != collapse.fromVersion || version[to] != collapse.toVersion) { continue; }
+		if (collapse.cost > maxCost) { break; }
+		if (!isValid(from, to)) { continue; }
+
+		++version[from]; ++version[to];
+		quadrics[to] += quadrics[from];
+		worstCost = std::max(worstCost, collapse.cost);
+		for (uint32_t t : vtxTris[from])
+		{
+			if (!isTriAlive[t]) { continue; }
+			uint32_t* tri = &tris[t * 3];
+			if (tri[0] == to || tri[1] == to || tri[2] == to) { isTriAlive[t] = 0; --numAlive; continue; }
+			for (int k = 0; k < 3; ++k) { if (tri[k] == from) { tri[k] = to; } }
+			vtxTris[to].push_back(t);
+		}
+		std::vector<uint32_t>().swap(vtxTris[from]);
+
+		// requeue edges around the vertex that stayed
+		std::vector<uint32_t>& around = vtxTris[to];
+		around.erase(std::remove_if(around.begin(), around.end(), [&isTriAlive](uint32_t _t) { return !isTriAlive[_t]; }), around.end());
+		neighbours.clear();
+		for (uint32_t t : around) { for (int k = 0; k < 3; ++k) { if (tris[t * 3 + k] != to) { neighbours.push_back(tris[t * 3 + k]); } } }
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+		for (uint32_t n : neighbours) { queueEdge(to, n); }
+	}
+	_error = static_cast<float>(std::sqrt(worstCost));
+
+	// a corner that moved takes the vertex at its new position with the closest normal
+	std::vector<uint32_t> result; result.reserve(numAlive * 3);
+	for (uint32_t t = 0; t < numTris; ++t)
+	{
+		if (!isTriAlive[t]) { continue; }
+		for (int k = 0; k < 3; ++k)
+		{
+			uint32_t w = tris[t * 3 + k], corner = corners[t * 3 + k];
+			if (weld[corner] != w)
+			{
+				uint32_t best = order[weldStart[w]];
+				float bestDot = -FLT_MAX;
+				for (uint32_t i = weldStart[w]; i < weldStart[w + 1]; ++i)
+				{
+					float d = dot(_vtx[order[i]].normal, _vtx[corner].normal);
+					if (d > bestDot) { bestDot = d; best = order[i]; }
+				}
+				corner = best;
+			}
+			result.push_back(corner);
+		}
+	}
+	return result;
+}
+
+void GenerateMeshLods(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx,
+	std::vector<uint32_t>& _lodIdx, std::vector<Buffer::Lod>& _lods)
+{
+	_lodIdx = _idx;
+	_lods.assign(1, { 0, static_cast<uint32_t>(_idx.size()), 0.f });
+	if (_idx.size() / 3 < MESH_LOD_MIN_TRIANGLES) { return; }
+
+	// error budget is relative to the size of the mesh
+	vec3 lo(FLT_MAX), hi(-FLT_MAX);
+	for (uint32_t i : _idx) { lo = min(lo, _vtx[i].position); hi = max(hi, _vtx[i].position); }
+	float maxError = MESH_LOD_MAX_ERROR * length(hi - lo);
+
+	std::vector<uint32_t> prev = _idx;
+	float totalError = 0.f;
+	for (unsigned lod = 1; lod < MESH_LOD_COUNT && prev.size() / 3 >= MESH_LOD_MIN_TRIANGLES; ++lod)
+	{
+		size_t target = static_cast<size_t>(prev.size() / 3 * MESH_LOD_RATIO) * 3;
+		float stepError;
+		std::vector<uint32_t> next = SimplifyMesh(_vtx, prev, target, maxError - totalError, stepError);
+		if (next.size() > prev.size() * MESH_LOD_MAX_KEPT) { break; }
+
+		// errors of steps add up to a bound on the distance to the full mesh
+		totalError += stepError;
+		_lods.push_back({ static_cast<uint32_t>(_lodIdx.size()), static_cast<uint32_t>(next.size()), totalError });
+		std::vector<uint32_t> ordered = OptimizeVertexCache(next, _vtx.size()); // collapses leave holes in the order of lod 0
+		_lodIdx.insert(_lodIdx.end(), ordered.begin(), ordered.end());
+		prev.swap(next);
+	}
+}
@@ -0,0 +1,203 @@
+/**
+@file    spatialhashgrid.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the SpatialHashGrid broad phase class.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/spatialhashgrid.hpp>
+#include <parallel.hpp>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint64_t constexpr GRID_EMPTY_SLOT = ~0ull; // never made by CellKey, top bit is unused
+static unsigned constexpr GRID_MIN_CHUNK = 1024; // boxes per thread
+static unsigned constexpr GRID_MIN_CELL_CHUNK = 256; // cells per thread when finding pairs
+
+// half of the 26 neighbours, the other half finds the same pairs from the other cell
+static int constexpr GRID_FORWARD_NEIGHBOURS[13][3]
+{
+	{ 1,-1,-1 }, { 1,-1, 0 }, { 1,-1, 1 }, { 1, 0,-1 }, { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1,-1 }, { 1, 1, 0 }, { 1, 1, 1 },
+	{ 0, 1,-1 }, { 0, 1, 0 }, { 0, 1, 1 },
+	{ 0, 0, 1 }
+};
+
+static uint64_t GridSlotHash(uint64_t _key)
+{
+	uint64_t h = _key * 0x9E3779B97F4A7C15ull;
+	return h ^ (h >> 32);
+}
+
+uint64_t SpatialHashGrid::CellKey(ivec3 const& _coord)
+{
+	// coordinates wrap every 2^21 cells, far cells sharing a key only cost extra box tests
+	uint64_t constexpr mask = (1ull << 21) - 1;
+	return ((static_cast<uint64_t>(_coord.x) & mask) << 42) | ((static_cast<uint64_t>(_coord.y) & mask) << 21) | (static_cast<uint64_t>(_coord.z) & mask);
+}
+
+ivec3 SpatialHashGrid::CellCoord(vec3 const& _p) const
+{
+	return ivec3(floor(_p / m_BuiltCellSize));
+}
+
+int SpatialHashGrid::FindCell(uint64_t _key) const
+{
+	size_t mask = m_SlotKeys.size() - 1;
+	for (size_t slot = GridSlotHash(_key) & mask;; slot = (slot + 1) & mask)
+	{
+		if (m_SlotKeys[slot] == _key) { return static_cast<int>(m_SlotCells[slot]); }
+		if (m_SlotKeys[slot] == GRID_EMPTY_SLOT) { return -1; }
+	}
+}
+
+void SpatialHashGrid::Build(vec3 const* _mins, vec3 const* _maxs, uint32_t _count)
+{
+	m_Mins = _mins; m_Maxs = _maxs;
+	m_CellCoords.clear();
+	m_BoxKeys.resize(_count); m_BoxCells.resize(_count); m_Sorted.resize(_count);
+
+	// cells are at least as big as the largest box so overlaps never skip a cell
+	std::vector<float> chunkSizes(GetNumWorkerThreads(), 0.f);
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned _thread)
+	{
+		float size = 0.f;
+		for (unsigned i = _begin; i < _end; ++i)
+		{
+			vec3 extents = _maxs[i] - _mins[i];
+			size = max(size, max(max(extents.x, extents.y), extents.z));
+		}
+		chunkSizes[_thread] = size;
+	}, GRID_MIN_CHUNK);
+	m_BuiltCellSize = m_CellSize;
+	for (float size : chunkSizes) { m_BuiltCellSize = max(m_BuiltCellSize, size); }
+	if (!(m_BuiltCellSize > 0.f)) { m_BuiltCellSize = 1.f; }
+
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned)
+	{
+		for (unsigned i = _begin; i < _end; ++i) { m_BoxKeys[i] = CellKey(CellCoord(0.5f * (_mins[i] + _maxs[i]))); }
+	}, GRID_MIN_CHUNK);
+
+	// at most half full so probes stay short
+	size_t numSlots = 16;
+	while (numSlots < 2 * static_cast<size_t>(_count)) { numSlots <<= 1; }
+	m_SlotKeys.assign(numSlots, GRID_EMPTY_SLOT);
+	m_SlotCells.resize(numSlots);
+	size_t mask = numSlots - 1;
+	for (uint32_t i = 0; i < _count; ++i)
+	{
+		uint64_t key = m_BoxKeys[i];
+		size_t slot = GridSlotHash(key) & mask;
+		while (m_SlotKeys[slot] != key && m_SlotKeys[slot] != GRID_EMPTY_SLOT) { slot = (slot + 1) & mask; }
+		if (m_SlotKeys[slot] == GRID_EMPTY_SLOT)
+		{
+			m_SlotKeys[slot] = key;
+			m_SlotCells[slot] = static_cast<uint32_t>(m_CellCoords.size());
+			m_CellCoords.push_back(CellCoord(0.5f * (_mins[i] + _maxs[i])));
+		}
+		m_BoxCells[i] = m_SlotCells[slot];
+	}
+
+	// counting sort, each thread counts its own chunk of boxes per cell
+	uint32_t numCells = GetNumCells();
+	m_ChunkCounts.assign(static_cast<size_t>(GetNumWorkerThreads()) * numCells, 0);
+	unsigned numChunks = ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned _thread)
+	{
+		uint32_t* counts = m_ChunkCounts.data() + static_cast<size_t>(_thread) * numCells;
+		for (unsigned i = _begin; i < _end; ++i) { ++counts[m_BoxCells[i]]; }
+	}, GRID_MIN_CHUNK);
+
+	// counts become offsets, chunks of a cell follow each other so boxes stay in index order
+	m_CellStarts.resize(numCells + 1);
+	uint32_t offset = 0;
+	for (uint32_t cell = 0; cell < numCells; ++cell)
+	{
+		m_CellStarts[cell] = offset;
+		for (unsigned chunk = 0; chunk < numChunks; ++chunk)
+		{
+			uint32_t& count = m_ChunkCounts[static_cast<size_t>(chunk) * numCells + cell];
+			uint32_t n = count; count = offset; offset += n;
+		}
+	}
+	m_CellStarts[numCells] = offset;
+
+	// same chunks as counting, so each thread writes only to its own offsets
+	ParallelFor(_count, [&](unsigned _begin, unsigned _end, unsigned _thread)
+	{
+		uint32_t* offsets = m_ChunkCounts.data() + static_cast<size_t>(_thread) * numCells;
+		for (unsigned i = _begin; i < _end; ++i) { m_Sorted[offsets[m_BoxCells[i]]++] = i; }
+	}, GRID_MIN_CHUNK);
+}
+
+void SpatialHashGrid::CollectPairs(uint32_t _cell0, uint32_t _cell1, std::vector<GridPair>& _pairs) const
+{
+	bool isSame = _cell0 == _cell1;
+	for (uint32_t i = m_CellStarts[_cell0]; i < m_CellStarts[_cell0 + 1]; ++i)
+	{
+		uint32_t a = m_Sorted[i];
+		for (uint32_t j = isSame ? i + 1 : m_CellStarts[_cell1]; j < m_CellStarts[_cell1 + 1]; ++j)
+		{
+			uint32_t b = m_Sorted[j];
+			if (m_Maxs[a].x < m_Mins[b].x || m_Mins[a].x > m_Maxs[b].x) { continue; }
+			if (m_Maxs[a].y < m_Mins[b].y || m_Mins[a].y > m_Maxs[b].y) { continue; }
+			if (m_Maxs[a].z < m_Mins[b].z || m_Mins[a].z > m_Maxs[b].z) { continue; }
+			_pairs.push_back(a < b ? GridPair{ a, b } : GridPair{ b, a });
+		}
+	}
+}
+
+std::vector<GridPair> const& SpatialHashGrid::FindPairs()
+{
+	m_ThreadPairs.resize(GetNumWorkerThreads());
+	for (auto& pairs : m_ThreadPairs) { pairs.clear(); }
+	unsigned numChunks = ParallelFor(GetNumCells(), [this](unsigned _begin, unsigned _end, unsigned _thread)
+	{
+		std::vector<GridPair>& pairs = m_ThreadPairs[_thread];
+		for (uint32_t cell = _begin; cell < _end; ++cell)
+		{
+			CollectPairs(cell, cell, pairs);
+			ivec3 coord = m_CellCoords[cell];
+			for (auto const& offset : GRID_FORWARD_NEIGHBOURS)
+			{
+				int neighbour = FindCell(CellKey(coord + ivec3(offset[0], offset[1], offset[2])));
+				if (neighbour >= 0) { CollectPairs(cell, static_cast<uint32_t>(neighbour), pairs); }
+			}
+		}
+	}, GRID_MIN_CELL_CHUNK);
+
+	// chunks are contiguous ranges of cells, appending in chunk order matches a single thread
+	m_Pairs.clear();
+	for (unsigned chunk = 0; chunk < numChunks; ++chunk)
+	{
+		m_Pairs.insert(m_Pairs.end(), m_ThreadPairs[chunk].begin(), m_ThreadPairs[chunk].end());
+	}
+	return m_Pairs;
+}
+
+void SpatialHashGrid::Query(vec3 const& _min, vec3 const& _max, std::vector<uint32_t>& _result) const
+{
+	if (m_CellCoords.empty()) { return; }
+	// centers of overlapping boxes are at most half a cell outside the query
+	vec3 halfCell = vec3(0.5f * m_BuiltCellSize);
+	ivec3 first = CellCoord(_min - halfCell), last = CellCoord(_max + halfCell);
+	for (int x = first.x; x <= last.x; ++x)
+	{
+		for (int y = first.y; y <= last.y; ++y)
+		{
+			for (int z = first.z; z <= last.z; ++z)
+			{
+				int cell = FindCell(CellKey(ivec3(x, y, z)));
+				if (cell < 0) { continue; }
+				for (uint32_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; ++i)
+				{
+					uint32_t box = m_Sorted[i];
+					if (m_Maxs[box].x < _min.x || m_Mins[box].x > _max.x) { continue; }
+					if (m_Maxs[box].y < _min.y || m_Mins[box].y > _max.y) { continue; }
+					if (m_Maxs[box].z < _min.z || m_Mins[box].z > _max.z) { continue; }
+					_result.push_back(box);
+				}
+			}
+		}
+	}
+}
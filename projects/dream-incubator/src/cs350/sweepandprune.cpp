@@ -0,0 +1,158 @@
+/**
+@file    sweepandprune.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the SweepAndPrune broad phase class.
+
+*//*__________________________________________________________________________*/
+
+#include <cs350/sweepandprune.hpp>
+#include <cfloat>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief key of pair regardless of order
+ */
+static uint64_t SapPairKey(uint32_t _a, uint32_t _b)
+{ return _a < _b ? (static_cast<uint64_t>(_a) << 32) | _b : (static_cast<uint64_t>(_b) << 32) | _a; }
+
+uint32_t SweepAndPrune::CreateProxy(vec3 const& _min, vec3 const& _max, uint32_t _userId)
+{
+	uint32_t proxy;
+	if (!m_FreeProxies.empty()) { proxy = m_FreeProxies.back(); m_FreeProxies.pop_back(); }
+	else { proxy = static_cast<uint32_t>(m_Proxies.size()); m_Proxies.emplace_back(); }
+	Proxy& p = m_Proxies[proxy];
+	p.min = _min; p.max = _max; p.userId = _userId; p.isAlive = true;
+	// appended at the end of each axis, the next sort moves them into place
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		std::vector<Endpoint>& endpoints = m_Endpoints[axis];
+		p.endpoints[axis][0] = static_cast<uint32_t>(endpoints.size());
+		endpoints.push_back({ _min[axis], proxy << 1 });
+		p.endpoints[axis][1] = static_cast<uint32_t>(endpoints.size());
+		endpoints.push_back({ _max[axis], proxy << 1 | 1 });
+	}
+	return proxy;
+}
+
+void SweepAndPrune::DestroyProxy(uint32_t _proxy)
+{
+	// pushed past every other endpoint, sorting then removes all its pairs and leaves it at the end
+	UpdateProxy(_proxy, vec3(FLT_MAX), vec3(FLT_MAX));
+	m_Proxies[_proxy].isAlive = false;
+	m_DestroyedProxies.push_back(_proxy);
+}
+
+void SweepAndPrune::UpdateProxy(uint32_t _proxy, vec3 const& _min, vec3 const& _max)
+{
+	Proxy& p = m_Proxies[_proxy];
+	p.min = _min; p.max = _max;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		m_Endpoints[axis][p.endpoints[axis][0]].value = _min[axis];
+		m_Endpoints[axis][p.endpoints[axis][1]].value = _max[axis];
+	}
+}
+
+void SweepAndPrune::Update()
+{
+	m_AddedPairs.clear(); m_RemovedPairs.clear(); m_NumSwaps = 0;
+	for (int axis = 0; axis < 3; ++axis) { SortAxis(axis); }
+
+	// destroyed proxies that overlapped each other tie at the end without swapping
+	if (!m_DestroyedProxies.empty())
+	{
+		for (size_t i = m_Pairs.size(); i-- > 0;)
+		{
+			SapPair pair = m_Pairs[i];
+			if (!m_Proxies[pair.proxy0].isAlive || !m_Proxies[pair.proxy1].isAlive) { RemovePair(pair.proxy0, pair.proxy1); }
+		}
+	}
+
+	// endpoints of destroyed proxies are all at the end now
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		std::vector<Endpoint>& endpoints = m_Endpoints[axis];
+		while (!endpoints.empty() && !m_Proxies[endpoints.back().data >> 1].isAlive) { endpoints.pop_back(); }
+	}
+	m_FreeProxies.insert(m_FreeProxies.end(), m_DestroyedProxies.begin(), m_DestroyedProxies.end());
+	m_DestroyedProxies.clear();
+}
+
+void SweepAndPrune::Clear()
+{
+	for (auto& endpoints : m_Endpoints) { endpoints.clear(); }
+	m_Proxies.clear(); m_FreeProxies.clear(); m_DestroyedProxies.clear();
+	m_Pairs.clear(); m_PairIndices.clear(); m_AddedPairs.clear(); m_RemovedPairs.clear();
+}
+
+void SweepAndPrune::SortAxis(int _axis)
+{
+	std::vector<Endpoint>& endpoints = m_Endpoints[_axis];
+	// on equal values mins go first so touching boxes overlap, same as OverlapAabbAabb
+	auto isLess = [](Endpoint const& _a, Endpoint const& _b)
+	{ return _a.value < _b.value || (_a.value == _b.value && (_a.data & 1) < (_b.data & 1)); };
+
+	for (size_t i = 1; i < endpoints.size(); ++i)
+	{
+		Endpoint curr = endpoints[i];
+		uint32_t currProxy = curr.data >> 1;
+		bool isCurrMax = curr.data & 1;
+		size_t j = i;
+		while (j > 0 && isLess(curr, endpoints[j - 1]))
+		{
+			Endpoint& prev = endpoints[j - 1];
+			uint32_t prevProxy = prev.data >> 1;
+			bool isPrevMax = prev.data & 1;
+			if (isCurrMax != isPrevMax && currProxy != prevProxy)
+			{
+				// min moved below a max, boxes may have started to overlap
+				if (!isCurrMax) { if (TestOverlap(m_Proxies[currProxy], m_Proxies[prevProxy])) { AddPair(currProxy, prevProxy); } }
+				// max moved below a min, boxes are apart on this axis
+				else { RemovePair(currProxy, prevProxy); }
+			}
+			endpoints[j] = prev;
+			m_Proxies[prevProxy].endpoints[_axis][isPrevMax] = static_cast<uint32_t>(j);
+			--j; ++m_NumSwaps;
+		}
+		endpoints[j] = curr;
+		m_Proxies[currProxy].endpoints[_axis][isCurrMax] = static_cast<uint32_t>(j);
+	}
+}
+
+bool SweepAndPrune::TestOverlap(Proxy const& _a, Proxy const& _b) const
+{
+	if (!_a.isAlive || !_b.isAlive) { return false; }
+	for (int i = 0; i < 3; ++i)
+	{
+		if (_a.max[i] < _b.min[i] || _a.min[i] > _b.max[i]) { return false; }
+	}
+	return true;
+}
+
+void SweepAndPrune::AddPair(uint32_t _a, uint32_t _b)
+{
+	auto [it, isNew] = m_PairIndices.try_emplace(SapPairKey(_a, _b), static_cast<uint32_t>(m_Pairs.size()));
+	if (!isNew) { return; }
+	SapPair pair{ _a < _b ? _a : _b, _a < _b ? _b : _a };
+	m_Pairs.push_back(pair);
+	m_AddedPairs.push_back(pair);
+}
+
+void SweepAndPrune::RemovePair(uint32_t _a, uint32_t _b)
+{
+	auto it = m_PairIndices.find(SapPairKey(_a, _b));
+	if (it == m_PairIndices.end()) { return; }
+	// swap with last pair
+	uint32_t idx = it->second;
+	m_RemovedPairs.push_back(m_Pairs[idx]);
+	m_PairIndices.erase(it);
+	if (idx + 1 != m_Pairs.size())
+	{
+		m_Pairs[idx] = m_Pairs.back();
+		m_PairIndices[SapPairKey(m_Pairs[idx].proxy0, m_Pairs[idx].proxy1)] = idx;
+	}
+	m_Pairs.pop_back();
+}
@@ -14,6 +14,8 @@ This file contains definition of the ECS class that encapsulates entt logic.
 #include <components/light.hpp>
 #include <components/camera.hpp>
 #include <components/boundingvolume.hpp>
+#include <components/collider.hpp>
+#include <components/visibleset.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
@@ -40,6 +42,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
             m_Registry.get<EntityName>(ent).value = "Camera";
             m_Registry.emplace<Framebuffer>(ent);
             m_Registry.emplace<Camera>(ent);
+            m_Registry.emplace<VisibleSet>(ent);
         return ent;
     }
     entity ECSManager::CreateDirectionLightEntity()
@@ -75,6 +78,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = "Point3D";
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("Point3D"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_POINT });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -84,6 +88,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         m_Registry.get<EntityName>(ent).value = "Plane";
             m_Registry.get<Transform>(ent).rotation.x = 90.f;
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("Plane"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_PLANE });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -92,6 +97,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = "Triangle";
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("Triangle"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_TRIANGLE });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -100,6 +106,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = "Sphere";
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("Sphere"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_SPHERE });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -108,6 +115,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = "AABB";
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("AABB"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_AABB });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -116,6 +124,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = "Ray";
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable("Ray"));
+            m_Registry.emplace<Collider>(ent, Collider{ SHAPE_RAY });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
@@ -124,6 +133,7 @@ void ECSManager::DestroyEntity(entt::entity _ent)
         entity ent = CreateDefaultEntity();
             m_Registry.get<EntityName>(ent).value = _name;
             auto& mesh = m_Registry.emplace<Renderable>(ent, Renderable(_name));
+            m_Registry.emplace<Collider>(ent, Collider{ ToShapeType(_name) });
             auto& mat = m_Registry.emplace<Material>(ent);
         return ent;
     }
\ No newline at end of file
@@ -0,0 +1,341 @@
+/**
+@file    mesharena.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the MeshArena class.
+
+*//*__________________________________________________________________________*/
+
+#include <graphics/mesharena.hpp>
+#include <algorithm>
+#include <numeric>
+#include <cfloat>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+namespace
+{
+	uint32_t AlignUnits(uint32_t _units) { return (_units + ARENA_RANGE_ALIGNMENT - 1) / ARENA_RANGE_ALIGNMENT * ARENA_RANGE_ALIGNMENT; }
+
+	/**
+	 * @brief packs a unit vector into snorm 10:10:10:2, x in the low bits
+	 */
+	uint32_t PackNormal(vec3 const& _nml)
+	{
+		auto snorm10 = [](float _val) { return static_cast<uint32_t>(static_cast<int32_t>(std::round(std::clamp(_val, -1.f, 1.f) * 511.f)) & 0x3ff); };
+		return snorm10(_nml.x) | (snorm10(_nml.y) << 10) | (snorm10(_nml.z) << 20);
+	}
+
+	uint32_t PackColor(vec4 const& _clr)
+	{
+		auto unorm8 = [](float _val) { return static_cast<uint32_t>(std::round(std::clamp(_val, 0.f, 1.f) * 255.f)); };
+		return unorm8(_clr.r) | (unorm8(_clr.g) << 8) | (unorm8(_clr.b) << 16) | (unorm8(_clr.a) << 24);
+	}
+}
+
+VERTEX_FORMAT MeshArena::SelectFormat(std::vector<Vertex> const& _vtx)
+{
+	for (Vertex const& vtx : _vtx)
+	{
+		if (vtx.color != vec4(1.f) || vtx.uv != vec2(0.f)) { return VERTEX_PACKED_COLOR_UV; }
+	}
+	return VERTEX_PACKED;
+}
+
+uint32_t MeshArena::Allocate(std::vector<Vertex> const& _vtx, std::vector<uint32_t> const& _idx, VERTEX_FORMAT _format)
+{
+	if (m_VAOs[0] == 0) { Init(); }
+
+	uint32_t handle = static_cast<uint32_t>(m_Allocations.size());
+	if (!m_FreeHandles.empty()) { handle = m_FreeHandles.back(); m_FreeHandles.pop_back(); }
+	else { m_Allocations.push_back({}); }
+
+	Allocation& alloc = m_Allocations[handle];
+	alloc = {};
+	alloc.format = _format;
+	alloc.numVertices = static_cast<uint32_t>(_vtx.size());
+	alloc.isShortIndices = _vtx.size() <= 0x10000;
+	alloc.isLive = true;
+	alloc.vertexUnits = AlignUnits(alloc.numVertices * GetVertexSize(_format) / ARENA_VERTEX_UNIT);
+	alloc.vertexOffset = AllocateRange(m_Vertices, alloc.vertexUnits);
+	UploadVertices(alloc, _vtx);
+	UploadIndices(alloc, _idx);
+	return handle;
+}
+
+void MeshArena::SetIndices(uint32_t _handle, std::vector<uint32_t> const& _idx)
+{
+	Allocation& alloc = m_Allocations[_handle];
+	FreeRange(m_Indices, alloc.indexOffset, alloc.indexUnits);
+	UploadIndices(alloc, _idx);
+}
+
+void MeshArena::Free(uint32_t _handle)
+{
+	Allocation& alloc = m_Allocations[_handle];
+	if (!alloc.isLive) { return; }
+	FreeRange(m_Vertices, alloc.vertexOffset, alloc.vertexUnits);
+	FreeRange(m_Indices, alloc.indexOffset, alloc.indexUnits);
+	alloc = {};
+	m_FreeHandles.push_back(_handle);
+}
+
+bool MeshArena::IsFragmented() const
+{
+	return IsFragmented(m_Vertices) || IsFragmented(m_Indices);
+}
+
+void MeshArena::Defragment()
+{
+	if (m_VAOs[0] == 0) { return; }
+
+	// live ranges keep their order, each pool is compacted on its own
+	std::vector<uint32_t> order(m_Allocations.size());
+	auto compact = [this, &order](Pool& _pool, uint32_t Allocation::* _offset, uint32_t Allocation::* _count)
+	{
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this, _offset](uint32_t _a, uint32_t _b)
+			{ return m_Allocations[_a].*_offset < m_Allocations[_b].*_offset; });
+
+		// ranges cannot be copied within one buffer if they overlap, so into a new one
+		uint32_t handle;
+		glGenBuffers(1, &handle);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, handle);
+		glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(_pool.capacity) * _pool.unitSize, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_READ_BUFFER, _pool.handle);
+		uint32_t offset = 0;
+		for (uint32_t i : order)
+		{
+			Allocation& alloc = m_Allocations[i];
+			if (!alloc.isLive || alloc.*_count == 0) { continue; }
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(alloc.*_offset) * _pool.unitSize,
+				static_cast<GLintptr>(offset) * _pool.unitSize, static_cast<GLsizeiptr>(alloc.*_count) * _pool.unitSize);
+			alloc.*_offset = offset;
+			offset += alloc.*_count;
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		glDeleteBuffers(1, &_pool.handle);
+		_pool.handle = handle;
+		_pool.free.clear();
+		if (offset < _pool.capacity) { _pool.free.push_back({ offset, _pool.capacity - offset }); }
+	};
+	compact(m_Vertices, &Allocation::vertexOffset, &Allocation::vertexUnits);
+	compact(m_Indices, &Allocation::indexOffset, &Allocation::indexUnits);
+	SetupVAO();
+}
+
+void MeshArena::Release()
+{
+	glDeleteBuffers(1, &m_Vertices.handle);
+	glDeleteBuffers(1, &m_Indices.handle);
+	glDeleteBuffers(1, &m_InstanceVBO);
+	glDeleteVertexArrays(VERTEX_FORMAT_TOTAL, m_VAOs);
+	m_Vertices = { m_Vertices.target, m_Vertices.unitSize, m_Vertices.initialCapacity };
+	m_Indices = { m_Indices.target, m_Indices.unitSize, m_Indices.initialCapacity };
+	m_Allocations.clear(); m_FreeHandles.clear();
+	std::fill(std::begin(m_VAOs), std::end(m_VAOs), 0u);
+	m_InstanceVBO = 0;
+}
+
+MeshArena::Stats MeshArena::GetStats() const
+{
+	size_t unpackedBytes = 0;
+	for (Allocation const& alloc : m_Allocations) { unpackedBytes += sizeof(Vertex) * alloc.numVertices + sizeof(uint32_t) * alloc.numIndices; }
+	return { static_cast<uint32_t>(m_Allocations.size() - m_FreeHandles.size()),
+		size_t(m_Vertices.used) * m_Vertices.unitSize, size_t(m_Vertices.capacity) * m_Vertices.unitSize,
+		size_t(m_Indices.used) * m_Indices.unitSize, size_t(m_Indices.capacity) * m_Indices.unitSize,
+		unpackedBytes, static_cast<uint32_t>(m_Vertices.free.size() + m_Indices.free.size()) };
+}
+
+void MeshArena::BindInstances(uint32_t _buffer, size_t _offset)
+{
+	for (uint32_t vao : m_VAOs) { glVertexArrayVertexBuffer(vao, ARENA_INSTANCE_BINDING, _buffer, static_cast<GLintptr>(_offset), sizeof(InstanceData)); }
+}
+
+void MeshArena::MultiDrawIndirect(uint32_t _primitiveType, GLenum _indexType, uint32_t _buffer, size_t _offset, uint32_t _count)
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _buffer);
+	glMultiDrawElementsIndirect(_primitiveType, _indexType, reinterpret_cast<void*>(_offset), _count, sizeof(DrawElementsCommand));
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void MeshArena::Init()
+{
+	InstanceData zero{};
+	glGenVertexArrays(VERTEX_FORMAT_TOTAL, m_VAOs);
+	glGenBuffers(1, &m_InstanceVBO);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_InstanceVBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeof(InstanceData), &zero, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	Grow(m_Vertices, m_Vertices.initialCapacity);
+	Grow(m_Indices, m_Indices.initialCapacity);
+}
+
+uint32_t MeshArena::AllocateRange(Pool& _pool, uint32_t _count)
+{
+	if (_count == 0) { return 0; }
+	auto it = std::find_if(_pool.free.begin(), _pool.free.end(), [_count](Range const& _range) { return _range.count >= _count; });
+	if (it == _pool.free.end())
+	{
+		// growing adds a free range at the end, merged with any free range before it
+		Grow(_pool, _pool.capacity + _count);
+		it = _pool.free.end() - 1;
+	}
+	uint32_t offset = it->offset;
+	it->offset += _count; it->count -= _count;
+	if (it->count == 0) { _pool.free.erase(it); }
+	_pool.used += _count;
+	return offset;
+}
+
+void MeshArena::FreeRange(Pool& _pool, uint32_t _offset, uint32_t _count)
+{
+	if (_count == 0) { return; }
+	_pool.used -= _count;
+	auto next = std::lower_bound(_pool.free.begin(), _pool.free.end(), _offset, [](Range const& _range, uint32_t _off) { return _range.offset < _off; });
+	bool isMergingPrev = next != _pool.free.begin() && (next - 1)->offset + (next - 1)->count == _offset;
+	bool isMergingNext = next != _pool.free.end() && _offset + _count == next->offset;
+	if (isMergingPrev && isMergingNext) { (next - 1)->count += _count + next->count; _pool.free.erase(next); }
+	else if (isMergingPrev) { (next - 1)->count += _count; }
+	else if (isMergingNext) { next->offset = _offset; next->count += _count; }
+	else { _pool.free.insert(next, { _offset, _count }); }
+}
+
+void MeshArena::Upload(Pool& _pool, uint32_t _offset, void const* _data, size_t _bytes)
+{
+	// bound to a copy target so the element buffer of whatever VAO is bound is left alone
+	if (_bytes == 0) { return; }
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _pool.handle);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(_offset) * _pool.unitSize, static_cast<GLsizeiptr>(_bytes), _data);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void MeshArena::UploadVertices(Allocation& _alloc, std::vector<Vertex> const& _vtx)
+{
+	// quantized to a cube around the bounds, a uniform scale leaves normals for mat3 of the model mtx
+	vec3 lo(FLT_MAX), hi(-FLT_MAX);
+	for (Vertex const& vtx : _vtx) { lo = min(lo, vtx.position); hi = max(hi, vtx.position); }
+	if (_vtx.empty()) { lo = hi = vec3(0.f); }
+	vec3 extent = hi - lo;
+	float size = std::max({ extent.x, extent.y, extent.z });
+	if (size <= 0.f) { size = 1.f; }
+	_alloc.decodeMtx = translate(mat4(1.f), lo) * scale(mat4(1.f), vec3(size));
+
+	auto pack = [&lo, size](Vertex const& _vtx, uint16_t(&_pos)[4], uint32_t& _nml)
+	{
+		vec3 q = (_vtx.position - lo) / size * 65535.f;
+		for (int i = 0; i < 3; ++i) { _pos[i] = static_cast<uint16_t>(std::clamp(std::round(q[i]), 0.f, 65535.f)); }
+		_pos[3] = 0;
+		_nml = PackNormal(_vtx.normal);
+	};
+	std::vector<char> data(static_cast<size_t>(_alloc.vertexUnits) * ARENA_VERTEX_UNIT);
+	if (_alloc.format == VERTEX_PACKED)
+	{
+		PackedVertex* pVtx = reinterpret_cast<PackedVertex*>(data.data());
+		for (Vertex const& vtx : _vtx) { pack(vtx, pVtx->position, pVtx->normal); ++pVtx; }
+	}
+	else
+	{
+		PackedVertexColorUv* pVtx = reinterpret_cast<PackedVertexColorUv*>(data.data());
+		for (Vertex const& vtx : _vtx) { pack(vtx, pVtx->position, pVtx->normal); pVtx->color = PackColor(vtx.color); pVtx->uv = vtx.uv; ++pVtx; }
+	}
+	Upload(m_Vertices, _alloc.vertexOffset, data.data(), data.size());
+}
+
+void MeshArena::UploadIndices(Allocation& _alloc, std::vector<uint32_t> const& _idx)
+{
+	_alloc.numIndices = static_cast<uint32_t>(_idx.size());
+	_alloc.indexUnits = AlignUnits(_alloc.numIndices * _alloc.GetIndexSize() / ARENA_INDEX_UNIT);
+	_alloc.indexOffset = AllocateRange(m_Indices, _alloc.indexUnits);
+	if (!_alloc.isShortIndices) { Upload(m_Indices, _alloc.indexOffset, _idx.data(), sizeof(uint32_t) * _idx.size()); return; }
+	std::vector<uint16_t> idx(_idx.begin(), _idx.end());
+	Upload(m_Indices, _alloc.indexOffset, idx.data(), sizeof(uint16_t) * idx.size());
+}
+
+void MeshArena::Grow(Pool& _pool, uint32_t _minCapacity)
+{
+	uint32_t capacity = std::max(_pool.capacity * 2, _minCapacity);
+	uint32_t handle;
+	glGenBuffers(1, &handle);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, handle);
+	glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity) * _pool.unitSize, nullptr, GL_STATIC_DRAW);
+	if (_pool.handle != 0)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, _pool.handle);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(_pool.capacity) * _pool.unitSize);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &_pool.handle);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	_pool.handle = handle;
+
+	uint32_t oldCapacity = _pool.capacity;
+	_pool.capacity = capacity;
+	_pool.used += capacity - oldCapacity; // freeing the new space takes it back off
+	FreeRange(_pool, oldCapacity, capacity - oldCapacity);
+	SetupVAO();
+}
+
+void MeshArena::SetupVAO()
+{
+	for (uint32_t format = 0; format < VERTEX_FORMAT_TOTAL; ++format)
+	{
+		glBindVertexArray(m_VAOs[format]);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Indices.handle);
+		glBindVertexBuffer(ARENA_VERTEX_BINDING, m_Vertices.handle, 0, GetVertexSize(static_cast<VERTEX_FORMAT>(format)));
+
+		// attribute layout, colour and uv are left at their default if the format has none
+
+			// pos, unorm of bounds
+			glEnableVertexAttribArray(0);
+			glVertexAttribFormat(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedVertex, position));
+			glVertexAttribBinding(0, ARENA_VERTEX_BINDING);
+
+			// nml
+			glEnableVertexAttribArray(1);
+			glVertexAttribFormat(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(PackedVertex, normal));
+			glVertexAttribBinding(1, ARENA_VERTEX_BINDING);
+
+			if (format == VERTEX_PACKED_COLOR_UV)
+			{
+				// clr
+				glEnableVertexAttribArray(2);
+				glVertexAttribFormat(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(PackedVertexColorUv, color));
+				glVertexAttribBinding(2, ARENA_VERTEX_BINDING);
+
+				// tex coord
+				glEnableVertexAttribArray(3);
+				glVertexAttribFormat(3, 2, GL_FLOAT, GL_FALSE, offsetof(PackedVertexColorUv, uv));
+				glVertexAttribBinding(3, ARENA_VERTEX_BINDING);
+			}
+
+		// per instance layout, on its own binding so each submit can point it at where it streamed instances
+		glBindVertexBuffer(ARENA_INSTANCE_BINDING, m_InstanceVBO, 0, sizeof(InstanceData));
+		glVertexBindingDivisor(ARENA_INSTANCE_BINDING, 1);
+
+			// model mtx, one column per location
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				glEnableVertexAttribArray(4 + i);
+				glVertexAttribFormat(4 + i, 4, GL_FLOAT, GL_FALSE, sizeof(vec4) * i);
+				glVertexAttribBinding(4 + i, ARENA_INSTANCE_BINDING);
+			}
+
+			// material index
+			glEnableVertexAttribArray(8);
+			glVertexAttribIFormat(8, 1, GL_UNSIGNED_INT, sizeof(mat4));
+			glVertexAttribBinding(8, ARENA_INSTANCE_BINDING);
+	}
+	glBindVertexArray(0);
+}
+
+bool MeshArena::IsFragmented(Pool const& _pool) const
+{
+	uint32_t numFree = _pool.capacity - _pool.used;
+	if (_pool.free.size() < 2 || numFree < ARENA_MIN_FREE_FRACTION * _pool.capacity) { return false; }
+	uint32_t largest = 0;
+	for (Range const& range : _pool.free) { largest = std::max(largest, range.count); }
+	return largest < ARENA_MIN_LARGEST_FREE_FRACTION * numFree;
+}
@@ -0,0 +1,151 @@
+/**
+@file    renderqueue.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the RenderQueue class.
+
+*//*__________________________________________________________________________*/
+
+#include <graphics/renderqueue.hpp>
+#include <graphics/shader.hpp>
+#include <algorithm>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+uint64_t RenderQueue::MakeKey(RENDER_PASS _pass, uint32_t _shader, Buffer const& _mesh, uint32_t _lod, uint32_t _material, float _depth)
+{
+	auto field = [](uint64_t _val, uint32_t _bits) { return _val & ((1ull << _bits) - 1); };
+	uint32_t depth = static_cast<uint32_t>(std::clamp(_depth, 0.f, 1.f) * ((1u << KEY_DEPTH_BITS) - 1));
+	MeshArena::Allocation const& range = _mesh.GetAllocation();
+	uint32_t format = _mesh.GetPrimitiveType() | (_mesh.GetIsIndexedDrawing() ? 0u : 1u << 3) | (range.format << 4) | (range.isShortIndices ? 1u << 5 : 0u);
+	uint64_t key = field(_pass, KEY_PASS_BITS);
+	key = (key << KEY_SHADER_BITS) | field(_shader, KEY_SHADER_BITS);
+	key = (key << KEY_FORMAT_BITS) | field(format, KEY_FORMAT_BITS);
+	key = (key << KEY_MESH_BITS) | field(_mesh.GetMeshId(), KEY_MESH_BITS);
+	key = (key << KEY_LOD_BITS) | field(_lod, KEY_LOD_BITS);
+	key = (key << KEY_DEPTH_BITS) | depth;
+	return (key << KEY_MATERIAL_BITS) | field(_material, KEY_MATERIAL_BITS);
+}
+
+void RenderQueue::Sort()
+{
+	// least significant byte first, bytes every key shares are skipped
+	uint64_t diff = 0;
+	for (SortEntry const& entry : m_Keys) { diff |= entry.key ^ m_Keys[0].key; }
+	m_SortScratch.resize(m_Keys.size());
+	for (uint32_t shift = 0; shift < 64; shift += 8)
+	{
+		if (((diff >> shift) & 0xff) == 0) { continue; }
+		uint32_t offsets[256]{};
+		for (SortEntry const& entry : m_Keys) { ++offsets[(entry.key >> shift) & 0xff]; }
+		for (uint32_t i = 0, sum = 0; i < 256; ++i) { uint32_t count = offsets[i]; offsets[i] = sum; sum += count; }
+		for (SortEntry const& entry : m_Keys) { m_SortScratch[offsets[(entry.key >> shift) & 0xff]++] = entry; }
+		m_Keys.swap(m_SortScratch);
+	}
+}
+
+RenderQueue::Stats RenderQueue::Submit(bool _isBatching, int32_t _vertexTransformLoc, int32_t _materialIdxLoc, int32_t _isInstancedLoc, StreamBuffer& _stream)
+{
+	Stats stats;
+	size_t numDraws = m_Keys.size();
+	if (numDraws == 0) { return stats; }
+
+	// a run is draws in one pass with one shader and primitive type, a group is draws of one lod of one mesh in a run
+	auto getRunEnd = [this, numDraws](size_t _begin)
+	{
+		size_t end = _begin + 1;
+		while (end < numDraws && GetRun(m_Keys[end].key) == GetRun(m_Keys[_begin].key)
+			&& m_Items[m_Keys[end].item].shader == m_Items[m_Keys[_begin].item].shader) { ++end; }
+		return end;
+	};
+	auto getGroupEnd = [this](size_t _begin, size_t _runEnd)
+	{
+		DrawItem const& item = m_Items[m_Keys[_begin].item];
+		size_t end = _begin + 1;
+		while (end < _runEnd && m_Items[m_Keys[end].item].buffer == item.buffer && m_Items[m_Keys[end].item].lod == item.lod) { ++end; }
+		return end;
+	};
+	StreamBuffer::Allocation instances{}, cmds{};
+	if (_isBatching)
+	{
+		// instances are written in sorted order straight into the mapping, each indexed group gets a command
+		instances = _stream.Allocate(sizeof(MeshArena::InstanceData) * numDraws, alignof(MeshArena::InstanceData));
+		MeshArena::InstanceData* pInstance = static_cast<MeshArena::InstanceData*>(instances.data);
+		for (SortEntry const& entry : m_Keys) { *pInstance++ = m_Items[entry.item].instance; }
+		m_Commands.clear();
+		for (size_t begin = 0, runEnd = 0, end; begin < numDraws; begin = end)
+		{
+			if (begin == runEnd) { runEnd = getRunEnd(begin); }
+			end = getGroupEnd(begin, runEnd);
+			DrawItem const& item = m_Items[m_Keys[begin].item];
+			if (item.buffer->GetIsIndexedDrawing())
+			{ m_Commands.push_back(item.buffer->GetDrawCommand(item.lod, static_cast<uint32_t>(end - begin), static_cast<uint32_t>(begin))); }
+		}
+		cmds = _stream.Upload(m_Commands.data(), sizeof(MeshArena::DrawElementsCommand) * m_Commands.size(), alignof(MeshArena::DrawElementsCommand));
+	}
+
+	// meshes of a vertex format share a vao
+	if (_isBatching) { MESH_ARENA.BindInstances(instances.handle, instances.offset); }
+	VERTEX_FORMAT format = VERTEX_FORMAT_TOTAL;
+	RENDER_PASS pass = PASS_OPAQUE;
+	Buffer::SetPolygonMode(Buffer::POLYGON_MODE::FILL);
+	uint32_t shader = 0, cmd = 0;
+	uint32_t materialIdx = UINT32_MAX;
+	for (size_t begin = 0, end; begin < numDraws; begin = end)
+	{
+		DrawItem const& item = m_Items[m_Keys[begin].item];
+		end = getRunEnd(begin);
+
+		// state is only set where it changes
+		if (GetPass(m_Keys[begin].key) != pass)
+		{
+			pass = GetPass(m_Keys[begin].key);
+			Buffer::SetPolygonMode(pass == PASS_WIREFRAME ? Buffer::POLYGON_MODE::LINE : Buffer::POLYGON_MODE::FILL);
+			++stats.numStateChanges;
+		}
+		if (item.shader != shader)
+		{
+			shader = item.shader; UseShader(shader);
+			SetUniform(_isInstancedLoc, _isBatching ? 1 : 0);
+			materialIdx = UINT32_MAX;
+			++stats.numStateChanges;
+		}
+		if (item.buffer->GetAllocation().format != format) { format = item.buffer->GetAllocation().format; MESH_ARENA.BindVAO(format); ++stats.numStateChanges; }
+
+		if (_isBatching && item.buffer->GetIsIndexedDrawing())
+		{
+			// every group of the run in one call, commands are in run order
+			uint32_t numCmds = 0;
+			for (size_t i = begin; i < end; i = getGroupEnd(i, end)) { ++numCmds; }
+			MESH_ARENA.MultiDrawIndirect(item.buffer->GetPrimitiveType(), item.buffer->GetAllocation().GetIndexType(), cmds.handle, cmds.offset + sizeof(MeshArena::DrawElementsCommand) * cmd, numCmds);
+			cmd += numCmds;
+			++stats.numDrawCalls;
+		}
+		else if (_isBatching)
+		{
+			for (size_t i = begin, j; i < end; i = j)
+			{
+				j = getGroupEnd(i, end);
+				DrawItem const& draw = m_Items[m_Keys[i].item];
+				draw.buffer->DrawInstanced(draw.lod, static_cast<uint32_t>(j - i), static_cast<uint32_t>(i));
+				++stats.numDrawCalls;
+			}
+		}
+		else
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				DrawItem const& draw = m_Items[m_Keys[i].item];
+				if (draw.instance.materialIdx != materialIdx) { materialIdx = draw.instance.materialIdx; SetUniform(_materialIdxLoc, materialIdx); }
+				SetUniform(_vertexTransformLoc, draw.instance.modelMtx);
+				draw.buffer->Draw(draw.lod);
+				++stats.numDrawCalls;
+			}
+		}
+	}
+	Buffer::SetPolygonMode(Buffer::POLYGON_MODE::FILL);
+	MESH_ARENA.UnBindVAO();
+	UnUseShader();
+	return stats;
+}
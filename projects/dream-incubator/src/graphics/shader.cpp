@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <unordered_map>
 
 #include <GL/glew.h>
 #include <graphics/shader.hpp>
@@ -27,6 +28,35 @@ std::string const assignment_fs = {
 };
 #endif
 
+// uniform locations of each linked program, so setting a uniform by name never asks the driver
+static std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> s_UniformLocations;
+
+/**
+ * @brief Caches the location of every active uniform of a linked program, uniforms in blocks have none.
+ *
+ * @param _shaderPgm Shader program ID.
+ */
+static void CacheUniformLocations(GLuint _shaderPgm)
+{
+    std::unordered_map<std::string, GLint>& locations = s_UniformLocations[_shaderPgm];
+    locations.clear();
+    GLint numUniforms = 0, maxLength = 0;
+    glGetProgramiv(_shaderPgm, GL_ACTIVE_UNIFORMS, &numUniforms);
+    glGetProgramiv(_shaderPgm, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(maxLength + 1);
+    for (GLint i = 0; i < numUniforms; ++i)
+    {
+        GLint size; GLenum type;
+        glGetActiveUniform(_shaderPgm, i, maxLength + 1, nullptr, &size, &type, name.data());
+        GLint loc = glGetUniformLocation(_shaderPgm, name.data());
+        if (loc < 0) { continue; }
+        std::string uniform(name.data());
+        locations[uniform] = loc;
+        // arrays are reported as "name[0]", also found by "name"
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0) { locations[uniform.substr(0, uniform.size() - 3)] = loc; }
+    }
+}
+
  //////////////////////////////////////////////////////////////////////////
 
  /**
@@ -126,6 +156,7 @@ GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path)
     glDetachShader(ProgramID, FragmentShaderID);
     glDeleteShader(VertexShaderID);
     glDeleteShader(FragmentShaderID);
+    CacheUniformLocations(ProgramID);
 
     return ProgramID;
 }
@@ -225,6 +256,8 @@ GLuint LoadPipeline(const char* vertex_file_path, const char* fragment_file_path
     glAttachShader(programIDs[1], FragmentShaderID);
     glProgramParameteri(programIDs[1], GL_PROGRAM_SEPARABLE, GL_TRUE);
     glLinkProgram(programIDs[1]);
+    CacheUniformLocations(programIDs[0]);
+    CacheUniformLocations(programIDs[1]);
 
     GLuint pipeLineID;
     glGenProgramPipelines(1, &pipeLineID);
@@ -237,35 +270,43 @@ GLuint LoadPipeline(const char* vertex_file_path, const char* fragment_file_path
 
 void UseShader(GLuint _shaderPgm) { if (_shaderPgm > 0) { glUseProgram(_shaderPgm); } }
 void UnUseShader()  { glUseProgram(0); }
-void DeleteShader(GLuint _shaderPgm) { if (_shaderPgm > 0) { glDeleteProgram(_shaderPgm); } }
+void DeleteShader(GLuint _shaderPgm) { if (_shaderPgm > 0) { glDeleteProgram(_shaderPgm); s_UniformLocations.erase(_shaderPgm); } }
+
+GLint GetUniformLocation(GLuint _shaderPgm, std::string const& _name)
+{
+    auto pgm = s_UniformLocations.find(_shaderPgm);
+    if (pgm == s_UniformLocations.end()) { return -1; }
+    auto loc = pgm->second.find(_name);
+    return loc == pgm->second.end() ? -1 : loc->second;
+}
 
 void SetUniform(GLuint _shaderPgm, std::string const& _name, int const _val)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniform1i(loc, _val); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _val)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniform1f(loc, _val); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _x, float const _y)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniform2f(loc, _x, _y); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _x, float const _y, float const _z)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniform3f(loc, _x, _y, _z); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, float const _x, float const _y, float const _z, float const _w)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniform4f(loc, _x, _y, _z, _w); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
@@ -277,13 +318,19 @@ void SetUniform(GLuint _shaderPgm, std::string const& _name, vec4 const& _val)
 { SetUniform(_shaderPgm, _name, _val.x, _val.y, _val.z, _val.w); }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, mat3 const& _val)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniformMatrix3fv(loc, 1, GL_FALSE, &_val[0][0]); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
 }
 void SetUniform(GLuint _shaderPgm, std::string const& _name, mat4 const& _val)
 {
-    GLint loc = glGetUniformLocation(_shaderPgm, _name.c_str());
+    GLint loc = GetUniformLocation(_shaderPgm, _name);
     if (loc >= 0) { glUniformMatrix4fv(loc, 1, GL_FALSE, &_val[0][0]); }
     else { std::cout << "Uniform variable " << _name << " does not exist.\n"; }
-}
\ No newline at end of file
+}
+
+void SetUniform(GLint _loc, int const _val)       { glUniform1i(_loc, _val); }
+void SetUniform(GLint _loc, unsigned const _val)  { glUniform1ui(_loc, _val); }
+void SetUniform(GLint _loc, float const _val)     { glUniform1f(_loc, _val); }
+void SetUniform(GLint _loc, vec3 const& _val)     { glUniform3f(_loc, _val.x, _val.y, _val.z); }
+void SetUniform(GLint _loc, mat4 const& _val)     { glUniformMatrix4fv(_loc, 1, GL_FALSE, &_val[0][0]); }
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+@file    streambuffer.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the StreamBuffer class.
+
+*//*__________________________________________________________________________*/
+
+#include <graphics/streambuffer.hpp>
+#include <algorithm>
+#include <cstring>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+void StreamBuffer::BeginFrame()
+{
+	if (m_Handle == 0) { Create(m_RegionSize); }
+
+	// buffers outgrown in earlier frames are deleted once the draws reading them are done
+	for (size_t i = 0; i < m_Retired.size();)
+	{
+		Retired& retired = m_Retired[i];
+		if (retired.fence == nullptr || glClientWaitSync(retired.fence, 0, 0) == GL_TIMEOUT_EXPIRED) { ++i; continue; }
+		glDeleteSync(retired.fence);
+		Delete(retired.handle);
+		retired = m_Retired.back(); m_Retired.pop_back();
+	}
+
+	m_Region = (m_Region + 1) % STREAM_FRAMES;
+	m_Offset = 0;
+	GLsync& fence = m_Fences[m_Region];
+	if (fence == nullptr) { return; }
+	GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	if (status == GL_TIMEOUT_EXPIRED)
+	{
+		++m_NumStalls;
+		do { status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); } // 1 ms
+		while (status == GL_TIMEOUT_EXPIRED);
+	}
+	glDeleteSync(fence);
+	fence = nullptr;
+}
+
+void StreamBuffer::EndFrame()
+{
+	if (m_Handle == 0) { return; }
+	if (m_Fences[m_Region] != nullptr) { glDeleteSync(m_Fences[m_Region]); }
+	m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	for (Retired& retired : m_Retired) { if (retired.fence == nullptr) { retired.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); } }
+	m_FrameSize = m_Offset;
+}
+
+StreamBuffer::Allocation StreamBuffer::Allocate(size_t _size, size_t _alignment)
+{
+	if (m_Handle == 0) { Create(m_RegionSize); }
+
+	// aligned from the start of the buffer, regions need not be a multiple of the alignment
+	auto align = [_alignment](size_t _offset) { return (_offset + _alignment - 1) / _alignment * _alignment; };
+	size_t start = align(m_Region * m_RegionSize + m_Offset);
+	if (start + _size > (m_Region + 1) * m_RegionSize)
+	{
+		// allocations made this frame stay bound to the old buffer, it is only deleted once this frame is done
+		m_Retired.push_back({ m_Handle, nullptr });
+		for (GLsync& fence : m_Fences) { if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; } } // fenced the old buffer
+		Create(std::max(m_RegionSize * 2, (_size + _alignment) * 2));
+		start = align(m_Region * m_RegionSize);
+	}
+	m_Offset = start + _size - m_Region * m_RegionSize;
+	return { m_Handle, start, m_Data + start };
+}
+
+StreamBuffer::Allocation StreamBuffer::Upload(void const* _data, size_t _size, size_t _alignment)
+{
+	Allocation alloc = Allocate(_size, _alignment);
+	if (_size) { std::memcpy(alloc.data, _data, _size); }
+	return alloc;
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	Release();
+}
+
+void StreamBuffer::Create(size_t _regionSize)
+{
+	m_RegionSize = _regionSize;
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glGenBuffers(1, &m_Handle);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_Handle);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_RegionSize * STREAM_FRAMES), nullptr, flags);
+	m_Data = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(m_RegionSize * STREAM_FRAMES), flags));
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamBuffer::Delete(uint32_t _handle)
+{
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _handle);
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	glDeleteBuffers(1, &_handle);
+}
+
+void StreamBuffer::Release()
+{
+	// deleting is deferred by the driver until draws reading it are done, so fences are not waited on
+	for (GLsync& fence : m_Fences) { if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; } }
+	for (Retired& retired : m_Retired)
+	{
+		if (retired.fence != nullptr) { glDeleteSync(retired.fence); }
+		Delete(retired.handle);
+	}
+	m_Retired.clear();
+	if (m_Handle == 0) { return; }
+	Delete(m_Handle);
+	m_Handle = 0; m_Data = nullptr;
+}
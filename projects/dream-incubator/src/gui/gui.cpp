@@ -25,6 +25,7 @@ encapsulates all Dear ImGui logic.
 #include <components/transform.hpp>
 #include <components/renderable.hpp>
 #include <components/material.hpp>
+#include <systems/culling.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
@@ -557,4 +558,5 @@ void GUI::CreateOctreeKdtreeScene()
 
         }
     }
+    Culling::SelectOccluders(32); // largest sections hide most of the plant
 }
\ No newline at end of file
@@ -16,6 +16,10 @@ This file contains the definitions of the InspectorGUI class.
 #include <components/material.hpp>
 #include <components/light.hpp>
 #include <components/boundingvolume.hpp>
+#include <components/collider.hpp>
+#include <components/visibleset.hpp>
+#include <systems/culling.hpp>
+#include <systems/render.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
@@ -64,6 +68,8 @@ void InspectorGUI::DisplayComponents() // TODO: optimization?
 
     DisplayMeshComp();
 
+    DisplayColliderComp();
+
     DisplayBVComp();
 }
 
@@ -85,6 +91,7 @@ void InspectorGUI::CreateComponentMenu()
             if (ImGui::Selectable("Mesh ##Add Component"))
             {
                 ECS.registry().emplace<Renderable>(ECS.selectedEnt());
+                ECS.registry().emplace<Collider>(ECS.selectedEnt());
                 ECS.registry().emplace<Material>(ECS.selectedEnt());
             }
         }
@@ -145,6 +152,32 @@ void InspectorGUI::DisplayCameraComp()
                 ImGui::Checkbox("##Show Frustum", &cam.showFrustum);
                 ImGui::TreePop();
             }*/
+            if (ECS.registry().view<VisibleSet>().contains(ECS.selectedEnt()))
+            {
+                auto& visible = ECS.registry().get<VisibleSet>(ECS.selectedEnt());
+                DisplayBool("Occlusion Culling", Culling::GetIsOcclusionCulling());
+                DisplayFloat("Contribution Threshold (px)", Culling::GetContributionThreshold());
+                DisplayFloat("Detail Threshold (px)", Culling::GetDetailThreshold());
+                DisplayBool("Mesh LODs", Render::GetIsUsingLods());
+                DisplayFloat("LOD Error (px)", Render::GetLodPixelError());
+                DisplayBool("Batched Drawing", Render::GetIsBatching());
+                DisplayBool("HLOD Proxies", Culling::GetIsUsingHlod());
+                DisplayFloat("HLOD Error (px)", Culling::GetHlodPixelError());
+                ImGui::Text("Visible meshes: %zu", visible.meshes.size());
+                ImGui::Text("Too small: %u, drawn as bounds: %u", visible.numTooSmall, visible.numDemoted);
+                ImGui::Text("Triangles: %u of %u at full detail", visible.numTriangles, visible.numFullTriangles);
+                ImGui::Text("Draw calls: %u, state changes: %u", visible.numDrawCalls, visible.numStateChanges);
+                MeshArena::Stats arena = MESH_ARENA.GetStats();
+                float toMB = 1.f / (1 << 20);
+                ImGui::Text("Mesh arena: %u meshes, %u free ranges", arena.numMeshes, arena.numFreeRanges);
+                ImGui::Text("Vertices: %.1f / %.1f MB, indices: %.1f / %.1f MB, %.1f MB unpacked", arena.vertexBytes * toMB, arena.vertexCapacity * toMB,
+                    arena.indexBytes * toMB, arena.indexCapacity * toMB, arena.unpackedBytes * toMB);
+                ImGui::Text("Streamed: %.1f KB per frame, %u fence stalls", Render::GetStream().GetFrameSize() / 1024.f, Render::GetStream().GetNumStalls());
+                ImGui::Text("Proxies: %zu, covering %u meshes, %u triangles", visible.proxies.size(), visible.numInProxies, visible.numProxyTriangles);
+                ImGui::Text("Frustum tests: %u, plane cache hits: %u", visible.numFrustumTests, visible.numPlaneCacheHits);
+                ImGui::Text("Occluded: %u / %u (%.1f%%)", visible.numOccluded, visible.numTested, visible.GetOccludedFraction() * 100.f);
+                ImGui::Text("Occluder triangles: %u", visible.numOccluderTriangles);
+            }
             ImGui::TreePop();
         }
     }
@@ -192,6 +225,7 @@ void InspectorGUI::DisplayMeshComp()
         {
             DisplayBool("Render Wireframe", mesh.GetIsWireframe());
             DisplayBool("Hide Mesh", mesh.GetIsHidden());
+            DisplayBool("Occluder", mesh.GetIsOccluder());
             if (ImGui::BeginCombo("##Mesh Type", mesh.GetMeshType().c_str()))
             {
                 for (auto const& [name, buf] : Renderable::GetBuffers())
@@ -211,6 +245,7 @@ void InspectorGUI::DisplayMeshComp()
                             { ECS.registry().remove<BoundingVolume>(ECS.selectedEnt()); }
                         }*/
                         mesh.SetMeshType(name); 
+                        ECS.registry().emplace_or_replace<Collider>(ECS.selectedEnt(), Collider{ ToShapeType(name) });
                    } 
                 }
                 ImGui::EndCombo();
@@ -228,6 +263,24 @@ void InspectorGUI::DisplayMeshComp()
     }
 }
 
+void InspectorGUI::DisplayColliderComp()
+{
+    auto viewCollider = ECS.registry().view<Collider>();
+    if (viewCollider.contains(ECS.selectedEnt()))
+    {
+        ImGui::Separator();
+        auto& col = ECS.registry().get<Collider>(ECS.selectedEnt());
+        ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+        if (ImGui::TreeNode("Collider"))
+        {
+            ImGui::Text("Shape: %s", to_string(col.type).c_str());
+            DisplayBool("Continuous", col.isContinuous);
+            if (col.isContinuous) { ImGui::Text("Time of impact: %.3f", col.toi); }
+            ImGui::TreePop();
+        }
+    }
+}
+
 void InspectorGUI::DisplayBVComp()
 {
     auto viewBV = ECS.registry().view<BVList>();
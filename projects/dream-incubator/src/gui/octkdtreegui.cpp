@@ -14,8 +14,12 @@ This file contains the definitions of the OctKDTreeGUI GUIWindow class.
 #include <components/renderable.hpp>
 #include <components/boundingvolume.hpp>
 #include <components/material.hpp>
+#include <components/camera.hpp>
 #include <cs350/octree.hpp>
 #include <cs350/kdtree.hpp>
+#include <cs350/hlod.hpp>
+#include <systems/culling.hpp>
+#include <random>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
@@ -24,7 +28,8 @@ void OctKDTreeGUI::InitWindow()
     std::vector<entity> entList;
     ECS.registry().view<Renderable, BVList>().each([&entList](auto _ent, Renderable _r, BVList _bvL) { entList.push_back(_ent); });
     OCTREE.BuildOctree(entList);
-    ECS.registry().get<Transform>(OCTREE.GetOctreeEnt()).isDirty = true;
+    Culling::InvalidateBVs(OCTREE.GetOctreeEnt());
+    Hlod::Build(OCTREE.GetRoot(), true);
 }
 
 static void OnSceneUpdate(bool _isOctree)
@@ -33,7 +38,7 @@ static void OnSceneUpdate(bool _isOctree)
     ECS.registry().get<BVList>(KDTREE.GetKdTreeEnt()).clear();
     KDTREE.ClearTree();
     OCTREE.ClearTree();
-    for (auto lv : KDTREE.GetVisibilityFlags()) { lv.clear(); } KDTREE.GetVisibilityFlags().clear();
+    KDTREE.GetVisibilityFlags().clear();
 
     ECS.registry().view<Material>().each([](Material& _mat) 
         {_mat.kAmbient = _mat.kDiffuse = { 0.9f, 0.5f, 0.3f }; });
@@ -41,13 +46,54 @@ static void OnSceneUpdate(bool _isOctree)
     // rebuild tree
     std::vector<entity> entList;
     ECS.registry().view<Renderable, BVList>().each([&entList](auto _ent, Renderable _r, BVList _bvL) { entList.push_back(_ent); });
+    // proxies of cells that did not change come from the cache, the rest wait for a rebuild
     if (_isOctree) 
-    {  OCTREE.BuildOctree(entList); ECS.registry().get<Transform>(OCTREE.GetOctreeEnt()).isDirty = true; }
-    else { KDTREE.BuildKDTree(0, KDTREE.GetRoot(), entList);
-    ECS.registry().get<Transform>(KDTREE.GetKdTreeEnt()).isDirty = true;
+    {  OCTREE.BuildOctree(entList); Culling::InvalidateBVs(OCTREE.GetOctreeEnt());
+    Hlod::Build(OCTREE.GetRoot(), false); }
+    else { Hlod::Clear(); KDTREE.BuildKDTree(entList); KDTREE.BuildRopes(); KDTREE.BuildDebugVolumes();
+    Culling::InvalidateBVs(KDTREE.GetKdTreeEnt());
     }
 }
 
+/**
+  * @brief rebuilds k-d tree from the object AABBs it already has, for when only
+  * the split strategy or number of objects per node changed
+  */
+static void OnKdTreeSettingsUpdate()
+{
+    KDTREE.Rebuild(); KDTREE.BuildRopes(); KDTREE.BuildDebugVolumes();
+    Culling::InvalidateBVs(KDTREE.GetKdTreeEnt());
+}
+
+/**
+  * @brief casts rays through the main viewport camera frustum against the k-d tree
+  * @param _numRays - number of rays to cast
+  * @param _type - traversal used
+  * @return number of rays that hit and average nodes visited per ray
+  */
+static std::pair<unsigned, float> CastTestRays(int _numRays, KDTREE_TRAVERSAL_TYPE _type)
+{
+    unsigned numHits{ 0 }; unsigned nodesVisited{ 0 };
+    auto viewCam = ECS.registry().view<EntityName, Camera>();
+    viewCam.each([&](EntityName& _name, Camera& _cam)
+    {
+        if (_name.value.find("Main") == std::string::npos) { return; }
+        mat4 invVP = inverse(_cam.vp);
+        std::mt19937 gen(0); // same rays for every traversal type
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        for (int i = 0; i < _numRays; ++i)
+        {
+            float x = dis(gen); float y = dis(gen);
+            vec4 nearPt = invVP * vec4(x, y, -1.f, 1.f); nearPt /= nearPt.w;
+            vec4 farPt = invVP * vec4(x, y, 1.f, 1.f); farPt /= farPt.w;
+            KdRayHit hit = KDTREE.RayCast(vec3(nearPt), normalize(vec3(farPt - nearPt)), _type);
+            if (hit.t >= 0.f) { ++numHits; }
+            nodesVisited += hit.nodesVisited;
+        }
+    });
+    return { numHits, _numRays > 0 ? static_cast<float>(nodesVisited) / _numRays : 0.f };
+}
+
 void OctKDTreeGUI::Render()
 {
     ImGui::SetNextWindowPos({ m_GUIWindowPos.x, m_GUIWindowPos.y }, ImGuiCond_Once);
@@ -74,15 +120,20 @@ void OctKDTreeGUI::Render()
                 OCTREE.GetNumObjPerNode() = OCTREE.GetNumObjPerNode() < 6 ? 6 : OCTREE.GetNumObjPerNode(); 
                 OnSceneUpdate(isOctree);
             }
+
+            ImGui::SeparatorText("Hierarchical LOD");
+            if (ImGui::Button("Build HLOD proxies", { ImGui::GetWindowSize().x * 0.25f, BUTTON_HEIGHT * 2 }))
+            { Hlod::Build(OCTREE.GetRoot(), true); }
+            ImGui::SameLine(); ImGui::Text("Proxies: %zu / %zu cells", Hlod::GetProxies().size(), Hlod::GetNodes().size());
         }
         else
         {
             static int e = KDTREE.GetSplitStrategy();
             if (ImGui::RadioButton("Median BV center", &e, TOP_DOWN_BV_CENTER_MEDIAN))
-            { KDTREE.GetSplitStrategy() = TOP_DOWN_BV_CENTER_MEDIAN; OnSceneUpdate(isOctree); }
+            { KDTREE.GetSplitStrategy() = TOP_DOWN_BV_CENTER_MEDIAN; OnKdTreeSettingsUpdate(); }
             ImGui::SameLine();
             if (ImGui::RadioButton("Median BV extends", &e, TOP_DOWN_BV_EXTENT_MEDIAN))
-            { KDTREE.GetSplitStrategy() = TOP_DOWN_BV_EXTENT_MEDIAN; OnSceneUpdate(isOctree); }
+            { KDTREE.GetSplitStrategy() = TOP_DOWN_BV_EXTENT_MEDIAN; OnKdTreeSettingsUpdate(); }
 
             ImGui::SeparatorText("Show Levels");
             unsigned numLevel = KDTREE.GetVisibilityFlags().size();
@@ -96,9 +147,24 @@ void OctKDTreeGUI::Render()
                 for (auto flag : flags[i]) { *flag = *flags[i][0]; }
                 ImGui::PopStyleColor(1); ImGui::SameLine();
             } ImGui::Text("");
+
+            ImGui::SeparatorText("Ray Traversal");
+            static int traversal = KD_TRAVERSAL_ROPES;
+            static int numRays = 10000;
+            static std::pair<unsigned, float> rayStats{ 0, 0.f };
+            ImGui::RadioButton("Ropes (stackless)", &traversal, KD_TRAVERSAL_ROPES); ImGui::SameLine();
+            ImGui::RadioButton("Stack (front to back)", &traversal, KD_TRAVERSAL_STACK);
+            ImGui::DragInt("Number of rays", &numRays, 100.f, 1, 1000000);
+            if (ImGui::Button("Cast rays from main viewport", { ImGui::GetWindowSize().x * 0.25f, BUTTON_HEIGHT * 2 }))
+            { rayStats = CastTestRays(numRays, static_cast<KDTREE_TRAVERSAL_TYPE>(traversal)); }
+            ImGui::Text("Hits: %u / %d  Avg nodes visited per ray: %.2f", rayStats.first, numRays, rayStats.second);
         }
         ImGui::DragInt("Number of objects per cell/node", isOctree ? &OCTREE.GetNumObjPerNode() : &KDTREE.GetNumObjPerNode(), 1.f, 1, 82);
-        if (ImGui::IsItemDeactivatedAfterEdit()) { OnSceneUpdate(isOctree); }
+        if (ImGui::IsItemDeactivatedAfterEdit()) 
+        {
+            if (isOctree) { OnSceneUpdate(isOctree); }
+            else { OnKdTreeSettingsUpdate(); }
+        }
 
         if (ImGui::Button("Toggle Wireframe", { ImGui::GetWindowSize().x * 0.25f, BUTTON_HEIGHT * 2 }))
         {
@@ -109,9 +175,12 @@ void OctKDTreeGUI::Render()
         { OnSceneUpdate(isOctree); }
 
 
+        // rebuild once no matter how many objects moved
+        bool isSceneDirty = false;
         auto viewBV = ECS.registry().view<Transform, Renderable, BVList>();
-        viewBV.each([](Transform& _xform, Renderable _r, BVList _bvL)
-            { if (_xform.isDirty) { OnSceneUpdate(isOctree); } });
+        viewBV.each([&isSceneDirty](Transform& _xform, Renderable _r, BVList _bvL)
+            { isSceneDirty |= _xform.isDirty; });
+        if (isSceneDirty) { OnSceneUpdate(isOctree); }
     } ImGui::End();
 }
 
@@ -13,6 +13,7 @@ encapsulates all Dear ImGui logic.
 
 #include <components/transform.hpp>
 #include <components/camera.hpp>
+#include <components/visibleset.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
@@ -39,6 +40,16 @@ void ViewportGUI::Render()
         }
 
         ImGui::Image((ImTextureID)(ECS.registry().get<Framebuffer>(m_Camera).GetFramebufferTexture()), { m_GUIWindowSize.x - WINDOW_PADDING*2, m_GUIWindowSize.y - WINDOW_PADDING*2 }, ImVec2(0, 1), ImVec2(1, 0));
+
+        // culling stats over the top left of the image
+        auto& visible = ECS.registry().get<VisibleSet>(m_Camera);
+        ImGui::SetCursorPos({ WINDOW_PADDING * 2, WINDOW_PADDING * 2 });
+        ImGui::Text("Drawn: %zu (%u as bounds), %zu proxies for %u", visible.meshes.size(), visible.numDemoted,
+            visible.proxies.size(), visible.numInProxies);
+        ImGui::Text("Culled: %u frustum, %u too small, %u occluded", visible.numOutside, visible.numTooSmall, visible.numOccluded);
+        ImGui::Text("Triangles: %u of %u at full detail, %u in proxies", visible.numTriangles, visible.numFullTriangles,
+            visible.numProxyTriangles);
+        ImGui::Text("Draw calls: %u, state changes: %u", visible.numDrawCalls, visible.numStateChanges);
     }
     ImGui::End();
 }
@@ -19,6 +19,7 @@
 #include <systems/render.hpp>
 #include <systems/movement.hpp>
 #include <systems/collision.hpp>
+#include <systems/culling.hpp>
 #include <graphics/buffer.hpp>
 
 /**
@@ -42,6 +43,7 @@ int main()
     std::vector<std::unique_ptr<ISystem>> systems;
     systems.push_back(std::make_unique<Movement>());
    // systems.push_back(std::make_unique<Collision>()); 
+    systems.push_back(std::make_unique<Culling>()); // visible sets for render
     systems.push_back(std::make_unique<Render>()); // loads and initializes meshes
     for (auto const& sys : systems) { sys->Init(); }
 
@@ -9,195 +9,339 @@ This file contains the definition of the Collision system class.
 
 #include <systems/collision.hpp>
 #include <cs350/intersectiontests.hpp>
+#include <cs350/narrowphase.hpp>
 #include <ecs.hpp>
+#include <parallel.hpp>
 #include <components/transform.hpp>
 #include <components/renderable.hpp>
 #include <components/boundingvolume.hpp>
-#include <components/camera.hpp>
+#include <components/collider.hpp>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 
+static unsigned constexpr NARROW_PHASE_MIN_CHUNK = 64; // pairs per thread, GJK pairs cost far more than a box test
+
+BROAD_PHASE_TYPE Collision::s_BroadPhaseType = BROAD_PHASE_SAP;
+float Collision::s_GridCellSize = 0.f;
+
 void Collision::Init() 
 {
 }
 
-void Collision::Update() 
+/**
+ * @brief refreshes world space data of collider from transform, getMtx is
+ * evaluated once here instead of once per pair
+ */
+static void UpdateCollider(Collider& _col, Transform& _xform, std::string const& _mesh)
 {
-    
-    // view frustum culling
-    auto viewCam = ECS.registry().view<EntityName, Transform, Camera>();
-    viewCam.each([](EntityName& _name, Transform& _xformCam, Camera& _cam)
-    {
-
-    bool shouldUpdate = _cam.isFocused || _xformCam.isDirty;
-    ECS.registry().view<Transform>().each([&shouldUpdate](Transform& _xform)
-        {if (_xform.isDirty) { shouldUpdate = true; }});
-
-    if (/*shouldUpdate &&*/ _name.value.find("Main") != std::string::npos)
-    {
-    auto viewBV = ECS.registry().view<EntityName, Transform, BVList>();
-    viewBV.each([&_cam, &_xformCam](auto _ent, EntityName& _name, Transform& _xform, BVList& _bvList)
-    {
-            mat4 camMtx = _cam.projMtx;
-            vec4 r0 = vec4(camMtx[0][0], camMtx[1][0], camMtx[2][0], camMtx[3][0]);
-            vec4 r1 = vec4(camMtx[0][1], camMtx[1][1], camMtx[2][1], camMtx[3][1]);
-            vec4 r2 = vec4(camMtx[0][2], camMtx[1][2], camMtx[2][2], camMtx[3][2]);
-            vec4 r3 = vec4(camMtx[0][3], camMtx[1][3], camMtx[2][3], camMtx[3][3]);
-            vec4 frustumPlanes[6];
-            frustumPlanes[0] = -r0 - r3; frustumPlanes[1] = r0 - r3; // l r
-            frustumPlanes[2] = -r1 - r3; frustumPlanes[3] = r1 - r3; // b t
-            frustumPlanes[4] = -r2 - r3; frustumPlanes[5] = -r2 + r3; // n f
-            
-            SIDE_RESULT vfc = INSIDE;
-            for (unsigned i = 0; i < 6; ++i)
+    mat4 mtx = _xform.getMtx();
+    vec3 prevCenter = _col.center;
+    _col.center = _xform.position;
+    switch (_col.type)
+    {
+    case SHAPE_RAY: _col.dir = vec3(mtx[0]); break;
+    case SHAPE_PLANE:
+    {
+        _col.dir = normalize(vec3(mtx[2]));
+        _col.d = dot(_xform.position, _col.dir);
+    } break;
+    case SHAPE_TRIANGLE:
+    {
+        _col.tri[0] = mtx * vec4(-0.5f, -0.5f, 0.0f, 1.f);
+        _col.tri[1] = mtx * vec4(0.5f, -0.5f, 0.0f, 1.f);
+        _col.tri[2] = mtx * vec4(0.0f, 0.5f, 0.0f, 1.f);
+    } break;
+    case SHAPE_SPHERE: _col.radius = max(max(abs(_xform.scale.x), abs(_xform.scale.y)), abs(_xform.scale.z)); break;
+    case SHAPE_AABB:
+    {
+        // world aabb of unit cube, half extents are the abs of the basis vectors
+        for (int i = 0; i < 3; ++i) { _col.halfExtents[i] = 0.5f * (abs(mtx[0][i]) + abs(mtx[1][i]) + abs(mtx[2][i])); }
+        _col.center = vec3(mtx[3]);
+    } break;
+    case SHAPE_MESH:
+    {
+        if (BoundingVolume::s_BVs[_mesh].empty()) { _col.halfExtents = vec3(0); break; }
+        Aabb bounds; bounds.InitBV(_mesh); bounds.UpdateBV(_xform);
+        _col.center = bounds.center; _col.halfExtents = bounds.halfExtents;
+    } break;
+    default: break;
+    }
+    // continuous colliders remember where they were so their motion can be swept
+    _col.motion = _col.isContinuous && _col.hasHistory ? _col.center - prevCenter : vec3(0);
+    _col.hasHistory = _col.isContinuous;
+    _col.toi = -1.f;
+
+    switch (_col.type)
+    {
+    case SHAPE_POINT: _col.boundsMin = _col.boundsMax = _col.center; break;
+    case SHAPE_TRIANGLE:
+    {
+        _col.boundsMin = min(min(_col.tri[0], _col.tri[1]), _col.tri[2]);
+        _col.boundsMax = max(max(_col.tri[0], _col.tri[1]), _col.tri[2]);
+    } break;
+    case SHAPE_SPHERE:
+    {
+        _col.boundsMin = _col.center - vec3(_col.radius);
+        _col.boundsMax = _col.center + vec3(_col.radius);
+    } break;
+    case SHAPE_AABB:
+    case SHAPE_MESH: _col.boundsMin = _col.GetMin(); _col.boundsMax = _col.GetMax(); break;
+    default: break;
+    }
+    // swept back over the motion of the frame so the broad phase still pairs fast movers
+    _col.boundsMin = min(_col.boundsMin, _col.boundsMin - _col.motion);
+    _col.boundsMax = max(_col.boundsMax, _col.boundsMax - _col.motion);
+}
+
+/**
+ * @brief keeps earliest time of impact of both colliders
+ */
+static void RecordImpact(Collider& _a, Collider& _b, float _toi)
+{
+    _a.toi = _a.toi < 0.f ? _toi : min(_a.toi, _toi);
+    _b.toi = _b.toi < 0.f ? _toi : min(_b.toi, _toi);
+}
+
+/**
+ * @brief wraps collider as a convex shape
+ * @return false if shape has no support function (ray, plane, triangle)
+ */
+static bool GetConvexShape(Collider const& _col, Transform& _xform, std::string const& _mesh, ConvexShape& _shape)
+{
+    switch (_col.type)
+    {
+    case SHAPE_MESH:
+    {
+        auto hull = ConvexHull::GetHulls().find(_mesh);
+        if (hull == ConvexHull::GetHulls().end()) { return false; }
+        _shape = MakeConvexHull(hull->second, _xform.getMtx());
+    } return true;
+    case SHAPE_SPHERE: _shape = MakeConvexSphere(_col.center, _col.radius); return true;
+    case SHAPE_AABB:
+    {
+        vec3 axes[3]{ vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+        _shape = MakeConvexObb(_col.center, _col.halfExtents, axes);
+    } return true;
+    case SHAPE_POINT: _shape = MakeConvexPoint(_col.center); return true;
+    default: return false;
+    }
+}
+
+/**
+ * @brief GJK overlap of a pair with at least one .obj mesh, meshes are tested
+ * by their convex hull and primitives by their own support function. EPA gives
+ * the single deepest contact of overlapping pairs.
+ * @param _cache - simplex of last frame of this pair, only written by this test
+ * @param _toi - time of impact if only conservative advancement hit
+ * @param _manifold - contact if overlapping
+ * @return true if intersecting
+ */
+static bool ConvexPairTest(ColliderEntry const& _a, ColliderEntry const& _b, GjkCache* _cache, float& _toi, ContactManifold& _manifold)
+{
+    if (!_a.hasShape || !_b.hasShape) { return false; }
+    if (GjkOverlap(_a.shape, _b.shape, _cache))
+    {
+        // warm started by the overlap test, so EPA is most of the cost
+        GjkResult result = GjkDistance(_a.shape, _b.shape, _cache, true);
+        _manifold.normal = result.normal;
+        _manifold.AddPoint(0.5f * (result.pointA + result.pointB), result.depth);
+        return true;
+    }
+    // conservative advancement from where both were at start of the frame
+    if (_a.col->motion == vec3(0) && _b.col->motion == vec3(0)) { return false; }
+    _toi = GjkTimeOfImpact(TranslateConvex(_a.shape, -_a.col->motion), _a.col->motion,
+        TranslateConvex(_b.shape, -_b.col->motion), _b.col->motion);
+    return _toi >= 0.f;
+}
+
+/**
+ * @brief narrow phase of a pair, meshes go through GJK and everything else
+ * through the narrow phase table, then swept if either is moving. Only reads
+ * the colliders so pairs can be tested on any thread.
+ * @param _toi - time of impact if only the swept test hit
+ * @param _manifold - contacts if overlapping, no points if only the swept test hit
+ * @return true if intersecting
+ */
+static bool TestPair(ColliderEntry const& _a, ColliderEntry const& _b, GjkCache* _cache, float& _toi, ContactManifold& _manifold)
+{
+    _manifold.count = 0;
+    // meshes against anything with a support function
+    if (_a.col->type == SHAPE_MESH || _b.col->type == SHAPE_MESH) { return ConvexPairTest(_a, _b, _cache, _toi, _manifold); }
+    Collider const& col = *_a.col; Collider const& col1 = *_b.col;
+    if (NarrowPhaseTest(col, col1)) { ContactPhaseTest(col, col1, _manifold); return true; }
+    // tested at end of frame only, fast movers sweep their motion to catch what they passed through
+    if (col.motion == vec3(0) && col1.motion == vec3(0)) { return false; }
+    _toi = SweptPhaseTest(col, col1);
+    return _toi >= 0.f;
+}
+
+void Collision::AddCandidatePair(uint32_t _entry0, uint32_t _entry1)
+{
+    // lower entity first so manifolds keep their direction while the pair lives
+    if (m_Colliders[_entry1].id < m_Colliders[_entry0].id) { std::swap(_entry0, _entry1); }
+    ColliderEntry const& a = m_Colliders[_entry0]; ColliderEntry const& b = m_Colliders[_entry1];
+    // map is only touched here, on the calling thread, and its nodes never move
+    auto [it, isNew] = m_PairCaches.try_emplace((static_cast<uint64_t>(a.id) << 32) | b.id);
+    PairCache& cache = it->second;
+    // neither moved since the pair was last tested and it was not a swept hit, last result still holds
+    bool isUnchanged = !isNew && cache.frame + 1 == m_Frame && cache.toi < 0.f && !a.hasMoved && !b.hasMoved
+        && a.col->motion == vec3(0) && b.col->motion == vec3(0);
+    cache.frame = m_Frame;
+    m_CandidatePairs.push_back({ _entry0, _entry1, &cache, isUnchanged });
+}
+
+void Collision::DropPairCache(std::unordered_map<uint64_t, PairCache>::iterator _it)
+{
+    if (_it->second.isTouching)
+    {
+        m_ContactEvents.push_back({ static_cast<uint32_t>(_it->first >> 32), static_cast<uint32_t>(_it->first), CONTACT_END, ContactManifold() });
+    }
+    m_PairCaches.erase(_it);
+}
+
+void Collision::NarrowPhase()
+{
+    m_ThreadHits.resize(GetNumWorkerThreads());
+    for (auto& hits : m_ThreadHits) { hits.clear(); }
+    unsigned numChunks = ParallelFor(static_cast<unsigned>(m_CandidatePairs.size()), [this](unsigned _begin, unsigned _end, unsigned _thread)
+    {
+        std::vector<uint32_t>& hits = m_ThreadHits[_thread];
+        for (unsigned i = _begin; i < _end; ++i)
+        {
+            // each pair has its own cache, only this thread writes it
+            CandidatePair const& pair = m_CandidatePairs[i];
+            PairCache& cache = *pair.cache;
+            cache.wasTouching = cache.isTouching;
+            if (pair.isUnchanged)
             {
-                mat4 invViewMtx = inverse(_cam.viewMtx);
-                vec3 n = invViewMtx * frustumPlanes[i];
-                n = normalize(n);
-                float d = frustumPlanes[i].w / length(n) + dot(n, vec3(invViewMtx[3]));
-
-                for (auto& bv : _bvList) // test each bv against the 6 frustums
-                {
-                    if (bv == nullptr || !bv->isActive) { continue; }
-                
-                    switch (bv->type)
-                    {
-                    case AABB: 
-                    {
-                        SIDE_RESULT currPlane = ClassifyPlaneAabb(n, d,
-                                std::dynamic_pointer_cast<Aabb>(bv)->GetMin(), std::dynamic_pointer_cast<Aabb>(bv)->GetMax());
-                        if (currPlane == OUTSIDE) { vfc = OUTSIDE; break; }
-                        else if (currPlane == OVERLAPPING) { vfc = OVERLAPPING; }
-                    } break;
-                    case BSPHERE_Ritters:
-                    case BSPHERE_Larssons:
-                    case BSPHERE_PCA:
-                    {
-                        SIDE_RESULT currPlane = ClassifyPlaneSphere(n, d,
-                            std::dynamic_pointer_cast<Sphere>(bv)->center, std::dynamic_pointer_cast<Sphere>(bv)->radius);
-                        if (currPlane == OUTSIDE) { vfc = OUTSIDE; break; }
-                        else if (currPlane == OVERLAPPING) { vfc = OVERLAPPING; }
-                    } break;
-                    case OBB_PCA:
-                        SIDE_RESULT currPlane = ClassifyPlaneObb(n, d,
-                            std::dynamic_pointer_cast<Obb>(bv)->center, std::dynamic_pointer_cast<Obb>(bv)->halfExtents, std::dynamic_pointer_cast<Obb>(bv)->axes);
-                        if (currPlane == OUTSIDE) { vfc = OUTSIDE; break; }
-                        else if (currPlane == OVERLAPPING) { vfc = OVERLAPPING; }
-                    break;
-                    };
-                }
-                if (vfc == OUTSIDE)
-                {  
-                    for (auto& bv : _bvList) { bv->vfc = OUTSIDE; }
-                    break; // one of the bv is outside skip the other tests and set all to outside
-                }
-                else if (vfc == OVERLAPPING)
-                { for (auto& bv : _bvList) { bv->vfc = OVERLAPPING; } }
-                else { for (auto& bv : _bvList) { bv->vfc = vfc; } }
+                for (int p = 0; p < cache.manifold.count; ++p) { ++cache.manifold.points[p].age; }
             }
-    });
+            else
+            {
+                ContactManifold old = cache.manifold;
+                cache.toi = -1.f;
+                cache.isTouching = TestPair(m_Colliders[pair.entry0], m_Colliders[pair.entry1], &cache.gjk, cache.toi, cache.manifold);
+                if (cache.isTouching && cache.wasTouching) { MatchContacts(old, cache.manifold); }
+            }
+            if (cache.isTouching || cache.wasTouching) { hits.push_back(i); }
+        }
+    }, NARROW_PHASE_MIN_CHUNK);
+
+    // chunks are contiguous, so hits come out in pair order whatever the thread count
+    for (unsigned chunk = 0; chunk < numChunks; ++chunk)
+    {
+        for (uint32_t hit : m_ThreadHits[chunk])
+        {
+            CandidatePair const& pair = m_CandidatePairs[hit];
+            PairCache const& cache = *pair.cache;
+            ColliderEntry& a = m_Colliders[pair.entry0]; ColliderEntry& b = m_Colliders[pair.entry1];
+            if (!cache.isTouching) { m_ContactEvents.push_back({ a.id, b.id, CONTACT_END, ContactManifold() }); continue; }
+            a.xform->hasCollided = b.xform->hasCollided = true;
+            if (cache.toi >= 0.f) { RecordImpact(*a.col, *b.col, cache.toi); }
+            m_ContactEvents.push_back({ a.id, b.id, cache.wasTouching ? CONTACT_STAY : CONTACT_BEGIN, cache.manifold });
+        }
     }
+}
+
+void Collision::Update() 
+{
+    
+    // world space data once per collider
+    ++m_Frame;
+    m_Colliders.clear(); m_Bounded.clear(); m_Unbounded.clear();
+    auto viewCol = ECS.registry().view<Transform, Renderable, Collider>();
+    viewCol.each([this](auto _ent, Transform& _xform, Renderable& _mesh, Collider& _col)
+    {
+        UpdateCollider(_col, _xform, _mesh.GetMeshType());
+        _xform.hasCollided = false;
+        ColliderEntry entry{ static_cast<uint32_t>(_ent), &_col, &_xform };
+        // Transform::isDirty stays set until the inspector clears it, last frame's matrix tells what moved
+        auto idx = entt::to_entity(_ent);
+        if (idx >= m_ColliderMtxs.size()) { m_ColliderMtxs.resize(idx + 1, mat4(0.f)); }
+        mat4 mtx = _xform.getMtx();
+        entry.hasMoved = mtx != m_ColliderMtxs[idx];
+        m_ColliderMtxs[idx] = mtx;
+        entry.hasShape = GetConvexShape(_col, _xform, _mesh.GetMeshType(), entry.shape);
+        entry.isBounded = _col.type != SHAPE_RAY && _col.type != SHAPE_PLANE;
+        (entry.isBounded ? m_Bounded : m_Unbounded).push_back(static_cast<uint32_t>(m_Colliders.size()));
+        m_Colliders.push_back(entry);
     });
-    auto viewMesh = ECS.registry().view<Transform, Renderable>();
-    viewMesh.each([](auto _ent, Transform& _xform, Renderable& _mesh)
+
+    // narrow phase only on pairs whose bounds overlap
+    m_CandidatePairs.clear(); m_ContactEvents.clear();
+    if (m_ActiveBroadPhase != s_BroadPhaseType)
+    {
+        // state of the other broad phase is dropped, pairs begin again on the next test
+        m_Sap.Clear(); m_SapProxies.clear(); m_ProxyEntries.clear();
+        while (!m_PairCaches.empty()) { DropPairCache(m_PairCaches.begin()); }
+        m_ActiveBroadPhase = s_BroadPhaseType;
+    }
+    switch (m_ActiveBroadPhase)
     {
-        // check if mesh is primitive
-        std::string const& mesh = _mesh.GetMeshType();
-        if (mesh.find(".obj") == std::string::npos)
+    case BROAD_PHASE_SAP: SweepAndPruneBroadPhase(); break;
+    case BROAD_PHASE_HASH_GRID: HashGridBroadPhase(); break;
+    default: break;
+    }
+    for (uint32_t a : m_Unbounded)
+    {
+        for (uint32_t b = 0; b < m_Colliders.size(); ++b)
         {
-            ECS.registry().view<Transform, Renderable>().each([&_ent, &_xform, &mesh](auto _ent1, Transform& _xform1, Renderable& _mesh1)
-            {
-                    std::string const& mesh1 = _mesh1.GetMeshType();
-                    if (mesh1.find(".obj") == std::string::npos)
-                    {
-                        if (_ent != _ent1)
-                        {
-                            if (mesh == "Sphere")
-                            {
-                                Sphere s; s.UpdateBV(_xform);
-                                if (mesh1 == "Sphere")
-                                {
-                                    Sphere s1; s1.UpdateBV(_xform1);
-                                    _xform.hasCollided = _xform1.hasCollided = OverlapSphereSphere(s.center, s.radius, s1.center, s1.radius);
-                                }
-                                if (mesh1 == "AABB")
-                                {
-                                    Aabb aabb; aabb.UpdateBV(_xform1);
-                                    _xform.hasCollided = _xform1.hasCollided = OverlapSphereAabb(s.center, s.radius, aabb.GetMin(), aabb.GetMax());
-                                }
-                                if (mesh1 == "Point3D")
-                                {  _xform.hasCollided = _xform1.hasCollided = OverlapPointSphere(_xform1.position, s.center, s.radius); }
-                                if (mesh1 == "Ray")
-                                {
-                                    vec3 right = vec3(_xform1.getMtx()[0][0], _xform1.getMtx()[0][1], _xform1.getMtx()[0][2]);
-                                    _xform.hasCollided = _xform1.hasCollided = IntersectionTimeRaySphere(_xform1.position, right, s.center, s.radius) > 0;
-                                }
-                                if (mesh1 == "Plane")
-                                {
-                                    vec3 forward = normalize(vec3(_xform1.getMtx()[2][0], _xform1.getMtx()[2][1], _xform1.getMtx()[2][2]));
-                                    _xform.hasCollided = _xform1.hasCollided = ClassifyPlaneSphere(forward, dot(_xform1.position, forward), s.center, s.radius) == SIDE_RESULT::OVERLAPPING;
-                                }
-                            }
-                            if (mesh == "AABB")
-                            {
-                                Aabb aabb; aabb.UpdateBV(_xform);
-                                if (mesh1 == "AABB")
-                                {
-                                    Aabb aabb1; aabb1.UpdateBV(_xform1);
-                                    _xform.hasCollided = _xform1.hasCollided = OverlapAabbAabb(aabb.GetMin(), aabb.GetMax(), aabb1.GetMin(), aabb1.GetMax());
-                                }
-                                if (mesh1 == "Point3D")
-                                {
-                                    _xform.hasCollided = _xform1.hasCollided = OverlapPointAabb(_xform1.position, aabb.GetMin(), aabb.GetMax());
-                                }
-                                if (mesh1 == "Ray")
-                                {
-                                    vec3 right = vec3(_xform1.getMtx()[0][0], _xform1.getMtx()[0][1], _xform1.getMtx()[0][2]);
-                                    _xform.hasCollided = _xform1.hasCollided = IntersectionTimeRayAabb(_xform1.position, right, aabb.GetMin(), aabb.GetMax()) > 0;
-                                }
-                                if (mesh1 == "Plane")
-                                {
-                                    vec3 forward = normalize(vec3(_xform1.getMtx()[2][0], _xform1.getMtx()[2][1], _xform1.getMtx()[2][2]));
-                                    _xform.hasCollided = _xform1.hasCollided = ClassifyPlaneAabb(forward, dot(_xform1.position, forward), aabb.GetMin(), aabb.GetMax()) == SIDE_RESULT::OVERLAPPING;
-                                }
-                            }
-                            if (mesh == "Point3D")
-                            {
-                                if (mesh1 == "Plane")
-                                {
-                                    vec3 forward = vec3(_xform1.getMtx()[2][0], _xform1.getMtx()[2][1], _xform1.getMtx()[2][2]);
-                                    _xform.hasCollided = _xform1.hasCollided = ClassifyPointPlane(_xform.position, forward, dot(_xform1.position, forward)) == SIDE_RESULT::OVERLAPPING;
-                                }
-                                if (mesh1 == "Triangle")
-                                {
-                                    vec3 a = _xform1.getMtx() * vec4( -0.5f, -0.5f, 0.0f,1.f);
-                                    vec3 b = _xform1.getMtx() * vec4( 0.5f, -0.5f, 0.0f, 1.f);
-                                    vec3 c = _xform1.getMtx() * vec4( 0.0f, 0.5f, 0.0f, 1.f);
-                                    _xform.hasCollided = _xform1.hasCollided = OverlapPointTriangle(_xform.position, a, b, c);
-                                }
-                            }
-                            if (mesh == "Ray")
-                            {
-                                vec3 right = vec3(_xform.getMtx()[0][0], _xform.getMtx()[0][1], _xform.getMtx()[0][2]);
-                                if (mesh1 == "Plane")
-                                {
-                                    vec3 forward = normalize(vec3(_xform1.getMtx()[2][0], _xform1.getMtx()[2][1], _xform1.getMtx()[2][2]));
-                                    _xform.hasCollided = _xform1.hasCollided = IntersectionTimeRayPlane(_xform.position, right, forward, dot(_xform1.position, forward)) > 0;
-                                }
-                                if (mesh1 == "Triangle")
-                                {
-                                    vec3 a = _xform1.getMtx() * vec4(-0.5f, -0.5f, 0.0f, 1.f);
-                                    vec3 b = _xform1.getMtx() * vec4(0.5f, -0.5f, 0.0f, 1.f);
-                                    vec3 c = _xform1.getMtx() * vec4(0.0f, 0.5f, 0.0f, 1.f);
-                                    auto[t, barycentric] = IntersectionTimeRayTriangle(_xform.position, right, a, b, c);
-                                    _xform.hasCollided = _xform1.hasCollided = t > 0;
-                                }
-                            }
-                        }
-                    }
-            });
+            // unbounded pairs once
+            if (a == b || (!m_Colliders[b].isBounded && b < a)) { continue; }
+            AddCandidatePair(a, b);
         }
-    });
+    }
+    // every pair still overlapping was added this frame, caches of the rest are dropped,
+    // including pairs of destroyed colliders and unbounded ones
+    for (auto it = m_PairCaches.begin(); it != m_PairCaches.end();)
+    {
+        auto next = std::next(it);
+        if (it->second.frame != m_Frame) { DropPairCache(it); }
+        it = next;
+    }
+    NarrowPhase();
+}
+
+void Collision::SweepAndPruneBroadPhase()
+{
+    std::fill(m_ProxyEntries.begin(), m_ProxyEntries.end(), ~0u);
+    for (uint32_t idx : m_Bounded)
+    {
+        ColliderEntry const& entry = m_Colliders[idx];
+        auto it = m_SapProxies.find(entry.id);
+        uint32_t proxy;
+        if (it == m_SapProxies.end())
+        {
+            proxy = m_Sap.CreateProxy(entry.col->boundsMin, entry.col->boundsMax, entry.id);
+            m_SapProxies.emplace(entry.id, proxy);
+        }
+        else { proxy = it->second; m_Sap.UpdateProxy(proxy, entry.col->boundsMin, entry.col->boundsMax); }
+        if (proxy >= m_ProxyEntries.size()) { m_ProxyEntries.resize(proxy + 1, ~0u); }
+        m_ProxyEntries[proxy] = idx;
+    }
+    // entities destroyed, without a collider or now unbounded lose their proxy
+    for (auto it = m_SapProxies.begin(); it != m_SapProxies.end();)
+    {
+        if (m_ProxyEntries[it->second] != ~0u) { ++it; continue; }
+        m_Sap.DestroyProxy(it->second);
+        it = m_SapProxies.erase(it);
+    }
+
+    m_Sap.Update();
+    for (SapPair const& pair : m_Sap.GetPairs()) { AddCandidatePair(m_ProxyEntries[pair.proxy0], m_ProxyEntries[pair.proxy1]); }
+}
+
+void Collision::HashGridBroadPhase()
+{
+    m_GridMins.resize(m_Bounded.size()); m_GridMaxs.resize(m_Bounded.size());
+    for (size_t i = 0; i < m_Bounded.size(); ++i)
+    {
+        Collider const& col = *m_Colliders[m_Bounded[i]].col;
+        m_GridMins[i] = col.boundsMin; m_GridMaxs[i] = col.boundsMax;
+    }
+    m_Grid.SetCellSize(s_GridCellSize);
+    m_Grid.Build(m_GridMins.data(), m_GridMaxs.data(), static_cast<uint32_t>(m_Bounded.size()));
+    for (GridPair const& pair : m_Grid.FindPairs()) { AddCandidatePair(m_Bounded[pair.index0], m_Bounded[pair.index1]); }
 }
 
 void Collision::CleanUp() 
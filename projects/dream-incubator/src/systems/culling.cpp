@@ -0,0 +1,509 @@
+/**
+@file    culling.cpp
+@author  weizhen.tan@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the Culling system class.
+
+*//*__________________________________________________________________________*/
+
+#include <systems/culling.hpp>
+#include <ecs.hpp>
+#include <components/transform.hpp>
+#include <components/renderable.hpp>
+#include <components/material.hpp>
+#include <graphics/buffer.hpp>
+#include <cs350/hlod.hpp>
+#include <parallel.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+
+static uint32_t constexpr OCCLUDER_MAX_TRIANGLES = 20000; // per mesh, more costs more to rasterize than culling saves
+static unsigned constexpr OCCLUSION_TEST_MIN_CHUNK = 256; // meshes per thread
+
+bool Culling::s_IsOcclusionCulling = true;
+float Culling::s_ContributionThreshold = 1.f;
+float Culling::s_DetailThreshold = 3.f;
+bool Culling::s_IsUsingHlod = true;
+float Culling::s_HlodPixelError = 1.f;
+std::vector<uint8_t> Culling::s_IsBVInvalid;
+
+/**
+ * @brief mesh drawn for a mesh type, points are drawn as spheres by Render
+ */
+static std::string GetDrawnMeshType(Renderable& _model)
+{
+    return _model.GetMeshType() == "Point3D" ? "Sphere" : _model.GetMeshType();
+}
+
+std::pair<vec3, vec3> const& Culling::GetMeshBounds(std::string const& _meshType)
+{
+    static std::unordered_map<std::string, std::pair<vec3, vec3>> s_Bounds;
+    auto it = s_Bounds.find(_meshType);
+    if (it != s_Bounds.end()) { return it->second; }
+
+    vec3 lo(FLT_MAX), hi(-FLT_MAX);
+    auto bufs = Renderable::GetBuffers().find(_meshType);
+    if (bufs != Renderable::GetBuffers().end())
+    {
+        for (auto& buf : bufs->second)
+        { for (Vertex const& vtx : buf->GetVertices()) { lo = min(lo, vtx.position); hi = max(hi, vtx.position); } }
+    }
+    if (lo.x > hi.x) { lo = hi = vec3(0.f); }
+    return s_Bounds.emplace(_meshType, std::make_pair(lo, hi)).first->second;
+}
+
+/**
+ * @brief world aabb of local bounds, extents are projected onto world axes
+ */
+static void GetWorldBounds(mat4 const& _model, std::pair<vec3, vec3> const& _local, vec3& _min, vec3& _max)
+{
+    vec3 center = vec3(_model * vec4(0.5f * (_local.first + _local.second), 1.f));
+    vec3 extents = 0.5f * (_local.second - _local.first), radius;
+    for (int i = 0; i < 3; ++i)
+    { radius[i] = abs(_model[0][i]) * extents.x + abs(_model[1][i]) * extents.y + abs(_model[2][i]) * extents.z; }
+    _min = center - radius; _max = center + radius;
+}
+
+/**
+ * @brief diameter in pixels of a world sphere seen by a camera, FLT_MAX if the
+ * camera is inside it
+ */
+static float GetScreenSize(Camera const& _cam, float _fbHeight, vec3 const& _center, float _radius)
+{
+    vec4 view = _cam.viewMtx * vec4(_center, 1.f);
+    // clip w is the view depth for perspective and 1 for ortho, so one formula covers both
+    mat4 const& proj = _cam.projMtx;
+    float w = proj[0][3] * view.x + proj[1][3] * view.y + proj[2][3] * view.z + proj[3][3];
+    if (w <= _radius * abs(proj[2][3])) { return FLT_MAX; }
+    return _radius * proj[1][1] * _fbHeight / w;
+}
+
+/**
+ * @brief pixels a world distance at the nearest point of a sphere projects to,
+ * FLT_MAX if the camera is inside it
+ */
+static float GetProjectedError(Camera const& _cam, float _fbHeight, vec3 const& _center, float _radius, float _error)
+{
+    vec4 view = _cam.viewMtx * vec4(_center, 1.f);
+    mat4 const& proj = _cam.projMtx;
+    float w = proj[0][3] * view.x + proj[1][3] * view.y + proj[2][3] * view.z + proj[3][3] - _radius * abs(proj[2][3]);
+    if (w <= 0.f) { return FLT_MAX; }
+    return 0.5f * _error * proj[1][1] * _fbHeight / w;
+}
+
+/**
+ * @brief triangles of every triangle list or strip buffer of a mesh type
+ */
+static uint32_t CountMeshTriangles(std::string const& _meshType)
+{
+    uint32_t count = 0;
+    auto bufs = Renderable::GetBuffers().find(_meshType);
+    if (bufs == Renderable::GetBuffers().end()) { return 0; }
+    for (auto& buf : bufs->second)
+    {
+        uint32_t n = buf->GetLods()[0].count;
+        if (buf->GetPrimitiveType() == Buffer::TRIANGLES) { count += n / 3; }
+        else if (buf->GetPrimitiveType() == Buffer::TRIANGLE_STRIP && n > 2) { count += n - 2; }
+    }
+    return count;
+}
+
+void Culling::SelectOccluders(unsigned _count)
+{
+    std::vector<std::pair<float, entt::entity>> candidates;
+    auto viewMesh = ECS.registry().view<Transform, Renderable>();
+    viewMesh.each([&candidates](auto _ent, Transform& _xform, Renderable& _model)
+    {
+        _model.GetIsOccluder() = false;
+        uint32_t numTriangles = CountMeshTriangles(GetDrawnMeshType(_model));
+        if (numTriangles == 0 || numTriangles > OCCLUDER_MAX_TRIANGLES) { return; }
+        vec3 lo, hi;
+        GetWorldBounds(_xform.getMtx(), GetMeshBounds(GetDrawnMeshType(_model)), lo, hi);
+        vec3 size = hi - lo;
+        candidates.push_back({ size.x * size.y + size.y * size.z + size.z * size.x, _ent });
+    });
+
+    // largest surface area first
+    size_t numOccluders = std::min<size_t>(_count, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + numOccluders, candidates.end(),
+        [](auto const& _a, auto const& _b) { return _a.first > _b.first; });
+    for (size_t i = 0; i < numOccluders; ++i) { ECS.registry().get<Renderable>(candidates[i].second).GetIsOccluder() = true; }
+}
+
+void Culling::Init()
+{
+}
+
+/**
+ * @brief signed distance of a bounding volume's center to a plane and its
+ * projected radius, same operations as the frustum batch kernels
+ */
+static void GetPlaneDistRadius(BatchPlane const& _plane, BoundingVolume const& _bv, float& _dist, float& _radius)
+{
+    vec3 center;
+    switch (_bv.type)
+    {
+    case AABB:
+    {
+        Aabb const& aabb = static_cast<Aabb const&>(_bv);
+        vec3 max = aabb.GetMax();
+        center = (max + aabb.GetMin()) * 0.5f;
+        vec3 extents = max - center;
+        _radius = extents.x * _plane.absN[0] + extents.y * _plane.absN[1] + extents.z * _plane.absN[2];
+    } break;
+    case OBB_PCA:
+    {
+        Obb const& obb = static_cast<Obb const&>(_bv);
+        center = obb.center;
+        float p[3];
+        for (int i = 0; i < 3; ++i)
+        { p[i] = abs(_plane.n[0] * obb.axes[i][0] + _plane.n[1] * obb.axes[i][1] + _plane.n[2] * obb.axes[i][2]); }
+        _radius = obb.halfExtents[0] * p[0] + obb.halfExtents[1] * p[1] + obb.halfExtents[2] * p[2];
+    } break;
+    default:
+    {
+        Sphere const& sphere = static_cast<Sphere const&>(_bv);
+        center = sphere.center; _radius = sphere.radius;
+    } break;
+    }
+    _dist = _plane.n[0] * center.x + _plane.n[1] * center.y + _plane.n[2] * center.z - _plane.d;
+}
+
+/**
+ * @brief aabb is fully outside some frustum plane
+ */
+static bool IsAabbOutside(BatchFrustum const& _frustum, vec3 const& _min, vec3 const& _max)
+{
+    vec3 center = 0.5f * (_min + _max), extents = 0.5f * (_max - _min);
+    for (BatchPlane const& plane : _frustum.planes)
+    {
+        float radius = extents.x * plane.absN[0] + extents.y * plane.absN[1] + extents.z * plane.absN[2];
+        float dist = plane.n[0] * center.x + plane.n[1] * center.y + plane.n[2] * center.z - plane.d;
+        if (dist > radius) { return true; }
+    }
+    return false;
+}
+
+/**
+ * @brief first frustum plane a bounding volume is fully outside of, -1 if none
+ */
+static int8_t FindRejectingPlane(BatchFrustum const& _frustum, BoundingVolume const& _bv)
+{
+    for (int8_t i = 0; i < 6; ++i)
+    {
+        float dist, radius;
+        GetPlaneDistRadius(_frustum.planes[i], _bv, dist, radius);
+        if (dist > radius) { return i; }
+    }
+    return -1;
+}
+
+void Culling::InvalidateBVs(entt::entity _ent)
+{
+    auto idx = entt::to_entity(_ent);
+    if (idx >= s_IsBVInvalid.size()) { s_IsBVInvalid.resize(idx + 1, 0); }
+    s_IsBVInvalid[idx] = 1;
+}
+
+void Culling::GatherMoved()
+{
+    m_IsMeshMoved = false;
+    std::fill(m_HasMoved.begin(), m_HasMoved.end(), 0);
+    auto viewXform = ECS.registry().view<Transform>();
+    for (auto ent : viewXform)
+    {
+        // a zero matrix is no model matrix, anything new counts as moved
+        auto idx = entt::to_entity(ent);
+        if (idx >= m_Mtxs.size()) { m_Mtxs.resize(idx + 1, mat4(0.f)); m_HasMoved.resize(idx + 1, 0); }
+        mat4 mtx = viewXform.get<Transform>(ent).getMtx();
+        if (mtx == m_Mtxs[idx]) { continue; }
+        m_Mtxs[idx] = mtx; m_HasMoved[idx] = 1;
+        m_IsMeshMoved |= ECS.registry().all_of<Renderable>(ent);
+    }
+    for (size_t i = 0; i < s_IsBVInvalid.size() && i < m_HasMoved.size(); ++i) { m_HasMoved[i] |= s_IsBVInvalid[i]; }
+    s_IsBVInvalid.clear();
+}
+
+void Culling::GatherBVs()
+{
+    // bvs only move with their transform, see Movement::UpdateBV, or are rebuilt, see InvalidateBVs()
+    m_GatheredBVs.clear(); m_IsBVDirty.clear();
+    auto viewBV = ECS.registry().view<Transform, BVList>();
+    viewBV.each([this](auto _ent, Transform&, BVList& _bvList)
+    {
+        uint8_t hasMoved = m_HasMoved[entt::to_entity(_ent)];
+        for (auto& bv : _bvList)
+        {
+            if (bv == nullptr || !bv->isActive) { continue; }
+            switch (bv->type)
+            {
+            case AABB:
+            case BSPHERE_Ritters:
+            case BSPHERE_Larssons:
+            case BSPHERE_PCA:
+            case OBB_PCA: break;
+            default: continue;
+            }
+            m_GatheredBVs.push_back({ _ent, bv.get() });
+            m_IsBVDirty.push_back(hasMoved);
+        }
+    });
+
+    // a bv added, removed or toggled invalidates every cached result
+    bool isSame = m_GatheredBVs.size() == m_BVs.size() && std::equal(m_BVs.begin(), m_BVs.end(), m_GatheredBVs.begin(),
+        [](BVEntry const& _a, BVEntry const& _b) { return _a.ent == _b.ent && _a.bv == _b.bv; });
+    if (!isSame)
+    {
+        m_BVs.swap(m_GatheredBVs);
+        std::fill(m_IsBVDirty.begin(), m_IsBVDirty.end(), 1);
+        ++m_BVVersion;
+    }
+}
+
+void Culling::QueueFrustumTest(uint32_t _idx)
+{
+    BoundingVolume const& bv = *m_BVs[_idx].bv;
+    switch (bv.type)
+    {
+    case AABB:
+    {
+        Aabb const& aabb = static_cast<Aabb const&>(bv);
+        m_Aabbs.PushBack(aabb.GetMin(), aabb.GetMax()); m_AabbBVs.push_back(_idx);
+    } break;
+    case OBB_PCA:
+    {
+        Obb const& obb = static_cast<Obb const&>(bv);
+        m_Obbs.PushBack(obb.center, obb.halfExtents, obb.axes); m_ObbBVs.push_back(_idx);
+    } break;
+    default:
+    {
+        Sphere const& sphere = static_cast<Sphere const&>(bv);
+        m_Spheres.PushBack(sphere.center, sphere.radius); m_SphereBVs.push_back(_idx);
+    } break;
+    }
+}
+
+void Culling::CullCamera(entt::entity _camEnt, Camera const& _cam, vec2 const& _fbSize, VisibleSet& _visible, bool _isMain)
+{
+    _visible.meshes.clear(); _visible.bvs.clear();
+    _visible.numTested = _visible.numOccluded = _visible.numOccluderTriangles = 0;
+    _visible.numFrustumTests = _visible.numPlaneCacheHits = 0;
+    _visible.screenSizes.clear();
+    _visible.numOutside = _visible.numTooSmall = _visible.numDemoted = 0;
+    _visible.proxies.clear(); _visible.numInProxies = 0;
+
+    // results of last frame stay valid while neither the camera nor the bv moved
+    CameraCache& cache = m_CameraCaches[_camEnt];
+    bool isCamDirty = cache.bvVersion != m_BVVersion || std::memcmp(&cache.vp, &_cam.vp, sizeof(mat4)) != 0;
+    if (cache.bvVersion != m_BVVersion)
+    {
+        cache.results.assign(m_BVs.size(), OVERLAPPING);
+        cache.planes.assign(m_BVs.size(), -1);
+    }
+    cache.vp = _cam.vp; cache.bvVersion = m_BVVersion;
+
+    // planes are extracted and normalized once for all bvs
+    BatchFrustum frustum = MakeBatchFrustum(_cam.vp);
+    m_Aabbs.Clear(); m_Spheres.Clear(); m_Obbs.Clear();
+    m_AabbBVs.clear(); m_SphereBVs.clear(); m_ObbBVs.clear();
+    for (uint32_t i = 0; i < m_BVs.size(); ++i)
+    {
+        if (!isCamDirty && !m_IsBVDirty[i]) { continue; }
+        // usually still outside the plane that rejected it last frame
+        if (cache.planes[i] >= 0)
+        {
+            float dist, radius;
+            GetPlaneDistRadius(frustum.planes[cache.planes[i]], *m_BVs[i].bv, dist, radius);
+            if (dist > radius) { ++_visible.numPlaneCacheHits; continue; }
+        }
+        QueueFrustumTest(i);
+    }
+
+    // the rest are classified in batches
+    auto classify = [this, &cache, &frustum](std::vector<uint32_t> const& _bvs)
+    {
+        for (size_t i = 0; i < _bvs.size(); ++i)
+        {
+            uint32_t idx = _bvs[i];
+            cache.results[idx] = m_BatchResults[i];
+            cache.planes[idx] = m_BatchResults[i] == OUTSIDE ? FindRejectingPlane(frustum, *m_BVs[idx].bv) : -1;
+        }
+    };
+    m_BatchResults.resize(m_Aabbs.Size());
+    ClassifyFrustumAabbBatch(frustum, m_Aabbs, m_BatchResults.data()); classify(m_AabbBVs);
+    m_BatchResults.resize(m_Spheres.Size());
+    ClassifyFrustumSphereBatch(frustum, m_Spheres, m_BatchResults.data()); classify(m_SphereBVs);
+    m_BatchResults.resize(m_Obbs.Size());
+    ClassifyFrustumObbBatch(frustum, m_Obbs, m_BatchResults.data()); classify(m_ObbBVs);
+    _visible.numFrustumTests = m_Aabbs.Size() + m_Spheres.Size() + m_Obbs.Size();
+
+    // every bv bounds the whole mesh, so any one outside means the mesh is
+    std::fill(m_IsOutside.begin(), m_IsOutside.end(), 0);
+    for (size_t i = 0; i < m_BVs.size(); ++i)
+    {
+        SIDE_RESULT result = static_cast<SIDE_RESULT>(cache.results[i]);
+        if (_isMain) { m_BVs[i].bv->vfc = result; }
+        if (result != OUTSIDE) { _visible.bvs.push_back({ m_BVs[i].ent, m_BVs[i].bv }); continue; }
+        auto idx = entt::to_entity(m_BVs[i].ent);
+        if (idx >= m_IsOutside.size()) { m_IsOutside.resize(idx + 1, 0); }
+        m_IsOutside[idx] = 1;
+    }
+
+    std::fill(m_IsInProxy.begin(), m_IsInProxy.end(), 0);
+    if (s_IsUsingHlod) { SelectProxies(_cam, frustum, _fbSize.y, _visible); }
+
+    // meshes without bvs are never frustum culled, any mesh too small on screen is
+    unsigned numMeshes = 0;
+    auto viewMesh = ECS.registry().view<Transform, Renderable, Material>();
+    for (auto ent : viewMesh)
+    {
+        auto [xform, model] = ECS.registry().get<Transform, Renderable>(ent);
+        if (model.GetIsHidden()) { continue; }
+        auto idx = entt::to_entity(ent);
+        if (idx < m_IsInProxy.size() && m_IsInProxy[idx]) { ++_visible.numInProxies; continue; }
+        if (idx < m_IsOutside.size() && m_IsOutside[idx]) { ++_visible.numOutside; continue; }
+
+        if (m_MeshMins.size() <= numMeshes) { m_MeshMins.resize(numMeshes + 1); m_MeshMaxs.resize(numMeshes + 1); }
+        vec3& lo = m_MeshMins[numMeshes]; vec3& hi = m_MeshMaxs[numMeshes];
+        GetWorldBounds(xform.getMtx(), GetMeshBounds(GetDrawnMeshType(model)), lo, hi);
+        float size = GetScreenSize(_cam, _fbSize.y, 0.5f * (lo + hi), 0.5f * length(hi - lo));
+        if (size < s_ContributionThreshold) { ++_visible.numTooSmall; continue; }
+        _visible.meshes.push_back(ent);
+        _visible.screenSizes.push_back(size);
+        ++numMeshes;
+    }
+
+    if (s_IsOcclusionCulling) { OcclusionCull(_cam, _visible, cache, !isCamDirty && !m_IsMeshMoved); }
+    else { cache.isOcclusionValid = false; }
+
+    for (float size : _visible.screenSizes) { _visible.numDemoted += size < s_DetailThreshold; }
+}
+
+void Culling::SelectProxies(Camera const& _cam, BatchFrustum const& _frustum, float _fbHeight, VisibleSet& _visible)
+{
+    std::vector<HlodNode> const& nodes = Hlod::GetNodes();
+    std::vector<HlodProxy> const& proxies = Hlod::GetProxies();
+    if (proxies.empty()) { return; }
+
+    m_HlodStack.assign(1, 0);
+    while (!m_HlodStack.empty())
+    {
+        HlodNode const& node = nodes[m_HlodStack.back()];
+        m_HlodStack.pop_back();
+        if (IsAabbOutside(_frustum, node.min, node.max)) { continue; }
+
+        // a proxy replaces the whole cell, so its meshes are not drawn even where they stick out of it
+        if (node.proxy >= 0 && proxies[node.proxy].isValid)
+        {
+            HlodProxy const& proxy = proxies[node.proxy];
+            float error = GetProjectedError(_cam, _fbHeight, 0.5f * (node.min + node.max), 0.5f * length(node.max - node.min), proxy.error);
+            if (error < s_HlodPixelError)
+            {
+                _visible.proxies.push_back(static_cast<uint32_t>(node.proxy));
+                for (entity ent : proxy.entities)
+                {
+                    auto idx = entt::to_entity(ent);
+                    if (idx >= m_IsInProxy.size()) { m_IsInProxy.resize(idx + 1, 0); }
+                    m_IsInProxy[idx] = 1;
+                }
+                continue;
+            }
+        }
+        m_HlodStack.insert(m_HlodStack.end(), node.children.begin(), node.children.end());
+    }
+}
+
+void Culling::OcclusionCull(Camera const& _cam, VisibleSet& _visible, CameraCache& _cache, bool _isStatic)
+{
+    // same meshes and occluders seen from the same place hide the same meshes
+    unsigned numMeshes = static_cast<unsigned>(_visible.meshes.size());
+    m_OccluderEnts.clear();
+    for (auto ent : _visible.meshes)
+    { if (ECS.registry().get<Renderable>(ent).GetIsOccluder()) { m_OccluderEnts.push_back(ent); } }
+    _visible.numTested = numMeshes;
+    if (_isStatic && _cache.isOcclusionValid && _cache.frustumMeshes == _visible.meshes && _cache.occluders == m_OccluderEnts)
+    {
+        _visible.meshes = _cache.meshes;
+        _visible.screenSizes = _cache.screenSizes;
+        _visible.numOccluded = numMeshes - static_cast<unsigned>(_cache.meshes.size());
+        _visible.numOccluderTriangles = _cache.numOccluderTriangles;
+        return;
+    }
+    _cache.frustumMeshes = _visible.meshes; _cache.occluders = m_OccluderEnts;
+
+    // occluders outside the frustum cover no pixels, so only visible ones are rasterized
+    m_Occluders.clear();
+    for (auto ent : m_OccluderEnts)
+    {
+        auto [xform, model] = ECS.registry().get<Transform, Renderable>(ent);
+        std::string mdl = GetDrawnMeshType(model);
+        mat4 mvp = _cam.vp * xform.getMtx();
+        for (auto& buf : Renderable::GetBuffers()[mdl])
+        {
+            bool isStrip = buf->GetPrimitiveType() == Buffer::TRIANGLE_STRIP;
+            if (!isStrip && buf->GetPrimitiveType() != Buffer::TRIANGLES) { continue; }
+            // full mesh, a simplified lod may stick out past it and hide what is visible
+            std::vector<Vertex>& vtx = buf->GetVertices();
+            std::vector<uint32_t> const& idx = buf->GetIndices();
+            if (vtx.empty()) { continue; }
+            m_Occluders.push_back({ mvp, &vtx[0].position, sizeof(Vertex), static_cast<uint32_t>(vtx.size()),
+                idx.empty() ? nullptr : idx.data(), buf->GetLods()[0].count, isStrip });
+        }
+    }
+    if (!m_Occluders.empty())
+    {
+        m_Occlusion.Rasterize(m_Occluders);
+        _visible.numOccluderTriangles = m_Occlusion.GetNumTriangles();
+        m_IsOccluded.resize(numMeshes);
+        ParallelFor(numMeshes, [this, &_cam](unsigned _begin, unsigned _end, unsigned)
+        {
+            for (unsigned i = _begin; i < _end; ++i)
+            { m_IsOccluded[i] = m_Occlusion.IsOccluded(_cam.vp, m_MeshMins[i], m_MeshMaxs[i]); }
+        }, OCCLUSION_TEST_MIN_CHUNK);
+
+        // compact, view order is kept
+        unsigned numVisible = 0;
+        for (unsigned i = 0; i < numMeshes; ++i)
+        {
+            if (m_IsOccluded[i]) { continue; }
+            _visible.meshes[numVisible] = _visible.meshes[i];
+            _visible.screenSizes[numVisible++] = _visible.screenSizes[i];
+        }
+        _visible.meshes.resize(numVisible); _visible.screenSizes.resize(numVisible);
+        _visible.numOccluded = numMeshes - numVisible;
+    }
+    _cache.meshes = _visible.meshes;
+    _cache.screenSizes = _visible.screenSizes;
+    _cache.numOccluderTriangles = _visible.numOccluderTriangles;
+    _cache.isOcclusionValid = true;
+}
+
+void Culling::Update()
+{
+    GatherMoved();
+    GatherBVs();
+
+    // proxies are built from meshes that stay put, one that moved no longer matches them
+    if (!Hlod::GetProxies().empty())
+    {
+        auto viewMesh = ECS.registry().view<Transform, Renderable>();
+        viewMesh.each([this](auto _ent, Transform&, Renderable&)
+            { if (m_HasMoved[entt::to_entity(_ent)]) { Hlod::InvalidateProxies(_ent); } });
+    }
+
+    auto viewCamera = ECS.registry().view<EntityName, Transform, Camera, Framebuffer, VisibleSet>();
+    viewCamera.each([this](auto _ent, EntityName& _name, Transform& _xform, Camera& _cam, Framebuffer& _fb, VisibleSet& _visible)
+    {
+        // same matrices Render will use this frame
+        _cam.UpdateCamera(_xform.getMtx(), _fb.GetFramebufferSize());
+        CullCamera(_ent, _cam, _fb.GetFramebufferSize(), _visible, _name.value.find("Main") != std::string::npos);
+    });
+}
+
+void Culling::CleanUp()
+{
+}
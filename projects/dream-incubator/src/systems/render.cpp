@@ -16,14 +16,126 @@ This file contains the declaration of the Render system class.
 #include <components/renderable.hpp>
 #include <components/material.hpp>
 #include <components/boundingvolume.hpp>
+#include <components/visibleset.hpp>
+#include <systems/culling.hpp>
 #include <cs350/bvhierarchy.hpp>
+#include <cs350/convexhull.hpp>
+#include <cs350/simplify.hpp>
+#include <cs350/hlod.hpp>
+#include <cs350/meshoptimize.hpp>
+#include <parallel.hpp>
+#include <hash.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
 std::unordered_map<std::string, std::vector<std::unique_ptr<Buffer>>> Renderable::s_Buffers;
+std::unordered_map<std::string, uint64_t> Renderable::s_ContentKeys;
 uint32_t  Renderable::s_ProgramID;
 std::unordered_map<std::string,
     std::vector<std::unique_ptr<BoundingVolume>>> BoundingVolume::s_BVs;
+bool Render::s_IsUsingLods = true;
+float Render::s_LodPixelError = 1.f;
+bool Render::s_IsBatching = true;
+StreamBuffer Render::s_Stream;
+
+static uint32_t constexpr MODEL_CACHE_MAGIC = 0x4c444f4d; // "MODL"
+static uint32_t constexpr MODEL_CACHE_VERSION = 1; // bump when models are imported or optimised differently
+
+/**
+ * @brief key of a model file as it is now, 0 if it cannot be read
+ */
+static uint64_t GetModelCacheKey(std::string const& _path)
+{
+    std::error_code err;
+    uintmax_t size = std::filesystem::file_size(_path, err);
+    if (err) { return 0; }
+    auto time = std::filesystem::last_write_time(_path, err);
+    if (err) { return 0; }
+    // std::hash differs between runs and compilers, the cache must not
+    uint64_t bytes = static_cast<uint64_t>(size);
+    int64_t ticks = static_cast<int64_t>(time.time_since_epoch().count());
+    uint64_t key = HashBytes(_path.data(), _path.size());
+    key = HashBytes(&bytes, sizeof(bytes), key);
+    key = HashBytes(&ticks, sizeof(ticks), key);
+    key = HashBytes(&MODEL_CACHE_VERSION, sizeof(MODEL_CACHE_VERSION), key);
+    return key == 0 ? 1 : key;
+}
+
+static std::string GetModelCachePath(uint64_t _key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.model", static_cast<unsigned long long>(_key));
+    return std::string(MODEL_CACHE_DIR) + name;
+}
+
+/**
+ * @brief reads the optimised meshes of a model cached by an earlier run, false
+ * if there are none or they are bad
+ */
+static bool LoadCachedModel(uint64_t _key, std::string& _name, std::vector<ImportedMesh>& _meshes)
+{
+    if (_key == 0) { return false; }
+    std::ifstream ifs(GetModelCachePath(_key), std::ios::binary | std::ios::ate);
+    if (!ifs) { return false; }
+    // counts of a truncated or corrupt file are not trusted with an allocation, each must fit in what is left
+    uint64_t left = static_cast<uint64_t>(ifs.tellg());
+    ifs.seekg(0);
+    auto take = [&left](uint64_t _size) { if (_size > left) { return false; } left -= _size; return true; };
+    uint32_t header[4]{}; // magic, version, meshes, name length
+    ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!ifs || header[0] != MODEL_CACHE_MAGIC || header[1] != MODEL_CACHE_VERSION) { return false; }
+    uint64_t meshSize = sizeof(uint32_t) * 3 + sizeof(MeshOptimizeStats);
+    if (!take(sizeof(header)) || !take(header[3]) || static_cast<uint64_t>(header[2]) * meshSize > left) { return false; }
+    _name.resize(header[3]);
+    ifs.read(_name.data(), header[3]);
+    _meshes.resize(header[2]);
+    for (ImportedMesh& mesh : _meshes)
+    {
+        uint32_t counts[3]{}; // vertices, indices, is triangles
+        ifs.read(reinterpret_cast<char*>(counts), sizeof(counts));
+        ifs.read(reinterpret_cast<char*>(&mesh.stats), sizeof(MeshOptimizeStats));
+        if (!ifs || !take(meshSize)) { return false; }
+        if (!take(sizeof(Vertex) * static_cast<uint64_t>(counts[0]) + sizeof(uint32_t) * static_cast<uint64_t>(counts[1]))) { return false; }
+        mesh.vertices.resize(counts[0]); mesh.indices.resize(counts[1]); mesh.isTriangles = counts[2] != 0;
+        ifs.read(reinterpret_cast<char*>(mesh.vertices.data()), sizeof(Vertex) * counts[0]);
+        ifs.read(reinterpret_cast<char*>(mesh.indices.data()), sizeof(uint32_t) * counts[1]);
+        if (!ifs) { return false; }
+        for (uint32_t i : mesh.indices) { if (i >= counts[0]) { return false; } }
+    }
+    return true;
+}
+
+/**
+ * @brief writes the optimised meshes of a model for later runs, written to a
+ * temporary file first so a run stopped halfway never leaves a bad file under the key
+ */
+static void SaveCachedModel(uint64_t _key, std::string const& _name, std::vector<ImportedMesh> const& _meshes)
+{
+    if (_key == 0) { return; }
+    std::string path = GetModelCachePath(_key), tmpPath = path + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary);
+        if (!ofs) { return; }
+        uint32_t header[4]{ MODEL_CACHE_MAGIC, MODEL_CACHE_VERSION,
+            static_cast<uint32_t>(_meshes.size()), static_cast<uint32_t>(_name.size()) };
+        ofs.write(reinterpret_cast<char const*>(header), sizeof(header));
+        ofs.write(_name.data(), _name.size());
+        for (ImportedMesh const& mesh : _meshes)
+        {
+            uint32_t counts[3]{ static_cast<uint32_t>(mesh.vertices.size()), static_cast<uint32_t>(mesh.indices.size()), mesh.isTriangles };
+            ofs.write(reinterpret_cast<char const*>(counts), sizeof(counts));
+            ofs.write(reinterpret_cast<char const*>(&mesh.stats), sizeof(MeshOptimizeStats));
+            ofs.write(reinterpret_cast<char const*>(mesh.vertices.data()), sizeof(Vertex) * mesh.vertices.size());
+            ofs.write(reinterpret_cast<char const*>(mesh.indices.data()), sizeof(uint32_t) * mesh.indices.size());
+        }
+        if (!ofs) { return; }
+    }
+    std::error_code err;
+    std::filesystem::rename(tmpPath, path, err);
+}
 
 void Render::Init()
 {
@@ -31,8 +143,23 @@ void Render::Init()
     if (Renderable::GetShaderPgm() == NULL)
     {
         Renderable::GetShaderPgm() = LoadShaders(
-            "../projects/weizhen.tan-project-4/shaders/ColorVertexShader.vert", 
-            "../projects/weizhen.tan-project-4/shaders/ColorFragmentShader.frag");
+            "../projects/dream-incubator/shaders/ColorVertexShader.vert", 
+            "../projects/dream-incubator/shaders/ColorFragmentShader.frag");
+    }
+    // camera, light and materials are only in blocks, a program without them draws nothing
+    if (glGetProgramResourceIndex(Renderable::GetShaderPgm(), GL_UNIFORM_BLOCK, "Frame") == GL_INVALID_INDEX
+        || glGetProgramResourceIndex(Renderable::GetShaderPgm(), GL_SHADER_STORAGE_BLOCK, "Materials") == GL_INVALID_INDEX)
+    { std::cout << "shader has no Frame or Materials block.\n"; }
+    // uniforms set every draw, the rest are in blocks
+    m_VertexTransformLoc = GetUniformLocation(Renderable::GetShaderPgm(), "vertexTransform");
+    m_MaterialIdxLoc = GetUniformLocation(Renderable::GetShaderPgm(), "materialIdx");
+    m_IsInstancedLoc = GetUniformLocation(Renderable::GetShaderPgm(), "isInstanced");
+    // batched draws read model mtx and material from per instance attributes at fixed locations
+    if (m_IsInstancedLoc < 0 || glGetAttribLocation(Renderable::GetShaderPgm(), "aModelMtx") != 4
+        || glGetAttribLocation(Renderable::GetShaderPgm(), "aMaterialIdx") != 8)
+    {
+        std::cout << "shader has no per instance inputs, batching is off.\n";
+        s_IsBatching = false;
     }
     // create meshes
     auto [name, vtx, idx, primitiveType]    = GeneratePlaneGeometry(vec4(1.0f));
@@ -83,15 +210,78 @@ void Render::Init()
                 objPath.insert(objPath.end(), tmp.begin(), tmp.end());
             }
         }
-        for (std::string& path : objPath)
+        // models unchanged since an earlier run are read back optimised, the rest are imported
+        std::error_code err;
+        std::filesystem::create_directories(MODEL_CACHE_DIR, err);
+        std::vector<std::string> names(objPath.size());
+        std::vector<std::vector<ImportedMesh>> models(objPath.size());
+        std::vector<uint64_t> keys(objPath.size());
+        std::vector<char> isCached(objPath.size(), 0);
+        for (size_t m = 0; m < objPath.size(); ++m)
         {
-            const aiScene* scene = importer.ReadFile(isPowerPlant ? folderPath + path : path, aiProcessPreset_TargetRealtime_Fast);
+            std::string filePath = isPowerPlant ? folderPath + objPath[m] : objPath[m];
+            keys[m] = GetModelCacheKey(filePath);
+            if (LoadCachedModel(keys[m], names[m], models[m])) { isCached[m] = 1; continue; }
+            models[m].clear();
+            const aiScene* scene = importer.ReadFile(filePath, aiProcessPreset_TargetRealtime_Fast);
             if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
-            {  std::cout << "assimp error: " << importer.GetErrorString() << std::endl;  return; }
-            if (isPowerPlant) { scene->mRootNode->mName = path; } 
-            ProcessNode(scene->mRootNode, scene); // load meshes recursively
-            std::cout << "assimp loaded: " << scene->mRootNode->mName.C_Str() << std::endl;
+            {
+                // models already loaded are kept, this one is left empty and gets no buffers
+                std::cout << "assimp error: " << filePath << ", " << importer.GetErrorString() << std::endl;
+                names[m].clear(); models[m].clear(); continue;
+            }
+            if (isPowerPlant) { scene->mRootNode->mName = objPath[m]; } 
+            names[m] = scene->mRootNode->mName.C_Str();
+            ProcessNode(scene->mRootNode, scene, models[m]); // load meshes recursively
+        }
+
+        // reorder imported triangle meshes for the vertex cache, overdraw and fetch on every thread
+        std::vector<ImportedMesh*> imported;
+        for (size_t m = 0; m < models.size(); ++m)
+        {
+            if (isCached[m]) { continue; }
+            for (ImportedMesh& mesh : models[m]) { if (mesh.isTriangles && !mesh.indices.empty()) { imported.push_back(&mesh); } }
         }
+        ParallelFor(static_cast<unsigned>(imported.size()), [&imported](unsigned _begin, unsigned _end, unsigned)
+        {
+            for (unsigned i = _begin; i < _end; ++i) { imported[i]->stats = OptimizeMesh(imported[i]->vertices, imported[i]->indices); }
+        }, 1);
+
+        for (size_t m = 0; m < models.size(); ++m)
+        {
+            if (models[m].empty()) { continue; }
+            if (!isCached[m]) { SaveCachedModel(keys[m], names[m], models[m]); }
+            Renderable::GetContentKeys()[names[m]] = keys[m]; // proxies cached from this model go stale with it
+            // per mesh acmr stays in the cache, the model reports its average over optimised meshes
+            float acmrBefore = 0.f, acmrAfter = 0.f;
+            unsigned numOptimized = 0;
+            for (ImportedMesh& mesh : models[m])
+            {
+                if (mesh.isTriangles && !mesh.indices.empty())
+                { acmrBefore += mesh.stats.acmrBefore; acmrAfter += mesh.stats.acmrAfter; ++numOptimized; }
+                Renderable::GetBuffers()[names[m]].push_back(std::make_unique<Buffer>(mesh.vertices, Buffer::TRIANGLES, true, &mesh.indices));
+            }
+            std::cout << (isCached[m] ? "cache loaded: " : "assimp loaded: ") << names[m];
+            if (numOptimized) { std::cout << ", " << numOptimized << " meshes, acmr " << acmrBefore / numOptimized << " -> " << acmrAfter / numOptimized; }
+            std::cout << std::endl;
+        }
+
+    // simplify loaded objs into lods on every thread, buffers are only touched by gl here
+    std::vector<Buffer*> lodBufs;
+    for (auto& [name, buf] : Renderable::GetBuffers())
+    {
+        if (name.find(".obj") == std::string::npos) { continue; }
+        for (auto& mesh : buf)
+        { if (mesh->GetPrimitiveType() == Buffer::TRIANGLES && !mesh->GetIndices().empty()) { lodBufs.push_back(mesh.get()); } }
+    }
+    std::vector<std::vector<uint32_t>> lodIdx(lodBufs.size());
+    std::vector<std::vector<Buffer::Lod>> lods(lodBufs.size());
+    ParallelFor(static_cast<unsigned>(lodBufs.size()), [&lodBufs, &lodIdx, &lods](unsigned _begin, unsigned _end, unsigned)
+    {
+        for (unsigned i = _begin; i < _end; ++i)
+        { GenerateMeshLods(lodBufs[i]->GetVertices(), lodBufs[i]->GetIndices(), lodIdx[i], lods[i]); }
+    }, 1);
+    for (size_t i = 0; i < lodBufs.size(); ++i) { if (lods[i].size() > 1) { lodBufs[i]->SetLods(lodIdx[i], lods[i]); } }
 
     // calculate bv for loaded objs TODO: objs dynamically added to proj dir during runtime
     for (auto& [name, buf] : Renderable::GetBuffers())
@@ -112,6 +302,8 @@ void Render::Init()
             unsigned i = 0; for (auto& vtx : vtxOBB_8vtx) { vtx.position = v[i]; ++i; }
             Renderable::GetBuffers()[nameOBB].push_back(std::make_unique<Buffer>(vtxOBB_8vtx, primitiveTypeAABB_8vtx, true, &idxAABB_8vtx));
             BoundingVolume::s_BVs[name].push_back(std::make_unique<Obb>(obb));
+            // convex hull for GJK narrow phase
+            ConvexHull::GetHulls()[name] = CreateConvexHullQuickhull(tmp);
         }
     }
 }
@@ -120,8 +312,13 @@ void Render::Update()
 {
     Buffer::ClearBuffers();
 
-    auto viewCamera = ECS.registry().view<Transform, Camera, Framebuffer>();
-    viewCamera.each([](auto _ent, Transform& _xform, Camera& _cam, Framebuffer& _fb)
+    // meshes freed by hlod rebuilds leave holes, compacted before they scatter free space
+    if (MESH_ARENA.IsFragmented()) { MESH_ARENA.Defragment(); }
+    s_Stream.BeginFrame();
+
+    // only what the Culling system found visible for each camera is drawn
+    auto viewCamera = ECS.registry().view<Transform, Camera, Framebuffer, VisibleSet>();
+    viewCamera.each([this](auto _ent, Transform& _xform, Camera& _cam, Framebuffer& _fb, VisibleSet& _visible)
     {
         // bind fbo
         _fb.BindFBO();
@@ -133,135 +330,156 @@ void Render::Update()
         Buffer::ClearBuffers();
 
 
-        UseShader(Renderable::GetShaderPgm());
+        // light and camera are uploaded once for every draw of this viewport
+        FrameBlock frame{};
+        auto viewLight = ECS.registry().view<Transform, Light>();
+        viewLight.each([&frame](Transform& _xform, Light& _light)
+        {
+            frame.lightPosition = _xform.position;
+            frame.lightType = static_cast<int>(_light.type);
+            frame.lightColor = _light.color;
+            frame.lightDirection = vec3(_xform.getMtx()[0][0], _xform.getMtx()[0][1], _xform.getMtx()[0][2]);
+            frame.lightIntensity = _light.intensity;
+            frame.lightRange = _light.range;
+            frame.lightAngle = _light.angle;
+        });
+        _cam.UpdateCamera(_xform.getMtx(), _fb.GetFramebufferSize());
+        frame.viewMtx = _cam.viewMtx; frame.projMtx = _cam.projMtx;
+        m_FrameBlock.Upload(s_Stream, &frame, sizeof(FrameBlock));
+
+        // materials of every draw, other cameras first then bvs, meshes and proxies
+        m_Materials.assign(1, { vec3(1.f), 1.f, vec3(1.f), 0.f, vec3(1.f), 0.f });
+        uint32_t bvMaterials = static_cast<uint32_t>(m_Materials.size());
+        for (auto [ent, bv] : _visible.bvs)
+        {
+            bool hasMdl = ECS.registry().view<Renderable>().contains(ent);
+            if (hasMdl)
+            {
+                ECS.registry().get<Material>(ent).kAmbient = vfcColors.at(bv->vfc);
+                ECS.registry().get<Material>(ent).kDiffuse = vfcColors.at(bv->vfc);
+            }
+            // color bv based on type, else on bvh tree level
+            vec3 clr = hasMdl ? bvColors.at(bv->type) : GetColors()[bv->depth];
+            m_Materials.push_back({ clr, 1.f, clr, 0.f, vec3(1.f), 0.f });
+        }
+        uint32_t meshMaterials = static_cast<uint32_t>(m_Materials.size());
+        for (entt::entity ent : _visible.meshes)
+        {
+            auto [xform, mat] = ECS.registry().get<Transform, Material>(ent);
+            vec3 kAmbient = xform.hasCollided ? vec3(1.f) - mat.kAmbient : mat.kAmbient;
+            vec3 kDiffuse = xform.hasCollided ? vec3(1.f) - mat.kDiffuse : mat.kDiffuse;
+            m_Materials.push_back({ kAmbient, mat.shininess, kDiffuse, 0.f, mat.kSpecular, 0.f });
+        }
+        uint32_t proxyMaterials = static_cast<uint32_t>(m_Materials.size());
+        for (uint32_t idx : _visible.proxies)
+        {
+            HlodProxy const& proxy = Hlod::GetProxies()[idx];
+            m_Materials.push_back({ proxy.kAmbient, proxy.shininess, proxy.kDiffuse, 0.f, proxy.kSpecular, 0.f });
+        }
+        m_MaterialBlock.Upload(s_Stream, m_Materials.data(), sizeof(MaterialData) * m_Materials.size());
+
+        // every draw goes through the queue, sorted so draws sharing state are submitted together,
+        // with the mesh's decode mtx so its packed positions come out in model space
+        m_Queue.Clear();
+        uint32_t pgm = Renderable::GetShaderPgm();
+        auto push = [this, pgm](RENDER_PASS _pass, Buffer* _buffer, uint32_t _lod, mat4 const& _modelMtx, uint32_t _materialIdx, float _depth)
+        {
+            m_Queue.Push(RenderQueue::MakeKey(_pass, pgm, *_buffer, _lod, _materialIdx, _depth),
+                { pgm, _buffer, _lod, { _modelMtx * _buffer->GetDecodeMtx(), _materialIdx, {} } });
+        };
+        // fraction of the way to the far plane, for front to back order
+        auto getDepth = [&_cam](vec3 const& _pos) { return -(_cam.viewMtx * vec4(_pos, 1.f)).z / _cam.far; };
 
-            // pass light to shader
-            auto viewLight = ECS.registry().view<Transform, Light>();
-            viewLight.each([](Transform& _xform, Light& _light)
+        // wireframe frustum of other cameras
+        ECS.registry().view<Camera, Transform>().each([&push, &_ent](auto _ent1, Camera& _cam2, Transform& _xform2)
+        {
+            if (_ent != _ent1)
             {
-                SetUniform(Renderable::GetShaderPgm(), "light.position", _xform.position);
-                SetUniform(Renderable::GetShaderPgm(), "light.type", static_cast<int>(_light.type));
-                SetUniform(Renderable::GetShaderPgm(), "light.color", _light.color);
-                vec3 right = vec3(_xform.getMtx()[0][0], _xform.getMtx()[0][1], _xform.getMtx()[0][2]);
-                SetUniform(Renderable::GetShaderPgm(), "light.direction", right);
-                SetUniform(Renderable::GetShaderPgm(), "light.intensity", _light.intensity);
-               // SetUniform(Renderable::GetShaderPgm(), "light.range", _light.range); // TODO: for spot/point
-               // SetUniform(Renderable::GetShaderPgm(), "light.angle", _light.angle); // for spot
-            });
-
-            // pass view and proj mtx to shaders
-            _cam.UpdateCamera(_xform.getMtx(), _fb.GetFramebufferSize());
-            SetUniform(Renderable::GetShaderPgm(), "viewMtx", _cam.viewMtx);
-            SetUniform(Renderable::GetShaderPgm(), "projMtx", _cam.projMtx);
-
-            // draw wireframe frustum of other cameras
-            ECS.registry().view<Camera, Transform>().each([&_ent](auto _ent1, Camera& _cam2, Transform& _xform2)
+                push(PASS_WIREFRAME, Renderable::GetBuffers()["AABB_8vtx"][0].get(), 0,
+                    _xform2.getMtx() * inverse(_cam2.projMtx) * inverse(_cam2.viewMtx) * inverse(_xform2.getMtx()), 0, 0.f);
+            }
+        });
+
+        // bv
+        for (size_t i = 0; i < _visible.bvs.size(); ++i)
+        {
+            auto [ent, bv] = _visible.bvs[i];
+            std::string mdl; bool hasMdl = ECS.registry().view<Renderable>().contains(ent);
+            if (hasMdl) { mdl = ECS.registry().get<Renderable>(ent).GetMeshType(); }
+
+            std::string mesh;
+            switch (bv->type)
             {
-                    if (_ent != _ent1)
-                    {
-                        Renderable::GetBuffers()["AABB_8vtx"][0]->BindVAO();
-                        SetUniform(Renderable::GetShaderPgm(), "material.kAmbient", vec3(1.f));
-                        SetUniform(Renderable::GetShaderPgm(), "material.kDiffuse", vec3(1.f));
-                        SetUniform(Renderable::GetShaderPgm(), "material.kSpecular", vec3(1.f));
-                        SetUniform(Renderable::GetShaderPgm(), "vertexTransform", _xform2.getMtx() * inverse(_cam2.projMtx) * inverse(_cam2.viewMtx) * inverse(_xform2.getMtx()));
-                        Renderable::GetBuffers()["AABB_8vtx"][0]->Draw();
-                        Renderable::GetBuffers()["AABB_8vtx"][0]->UnBindVAO();
-                    }
-            });
-
-        UnUseShader();
-
-        // render bv
-        auto viewBV = ECS.registry().view</*RenderOrder, */Transform, BVList>();
-        viewBV.each([](auto _ent,/*RenderOrder& _renderOrder,*/ Transform& _xform, BVList& _bvArr)
+            case AABB:                  mesh = "AABB_8vtx";     break;
+            case BSPHERE_Ritters:
+            case BSPHERE_Larssons:
+            case BSPHERE_PCA:           mesh = "Sphere";        break;
+            case OBB_PCA: if (hasMdl) { mesh = "OBB " + mdl; }  break;
+            };
+            push(PASS_WIREFRAME, Renderable::GetBuffers()[mesh][0].get(), 0, bv->modelMat, bvMaterials + static_cast<uint32_t>(i), 0.f);
+        }
+
+        // mesh, hidden ones are already left out and ones too small for their detail are drawn as their bounds
+        _visible.numTriangles = _visible.numFullTriangles = 0;
+        for (size_t i = 0; i < _visible.meshes.size(); ++i)
+        {
+            auto [xform, model] = ECS.registry().get<Transform, Renderable>(_visible.meshes[i]);
+
+            //if (model.GetMeshType() == "Point3D") { Buffer::SetPointSize(length2(xform.scale)); }
+            std::string mdl = model.GetMeshType();
+            if (model.GetMeshType() == "Point3D") { xform.scale = vec3(0.1f); mdl = "Sphere"; }
+
+            mat4 modelMat = xform.getMtx();
+            auto const& [lo, hi] = Culling::GetMeshBounds(mdl);
+            float depth = getDepth(vec3(modelMat * vec4(0.5f * (lo + hi), 1.f)));
+            if (_visible.screenSizes[i] < Culling::GetDetailThreshold())
             {
-                for (auto bv : _bvArr)
-                {
-                    if (bv == nullptr || !bv->isActive) { continue; }
-
-                    std::string mdl; bool hasMdl = ECS.registry().view<Renderable>().contains(_ent);
-                    if (hasMdl) 
-                    { 
-                        mdl = ECS.registry().get<Renderable>(_ent).GetMeshType(); 
-                        ECS.registry().get<Material>(_ent).kAmbient = vfcColors.at(bv->vfc);
-                        ECS.registry().get<Material>(_ent).kDiffuse = vfcColors.at(bv->vfc);
-                    }
-
-                    std::string mesh;
-                    switch (bv->type)
-                    {
-                    case AABB:                  mesh = "AABB_8vtx";     break;
-                    case BSPHERE_Ritters:
-                    case BSPHERE_Larssons:
-                    case BSPHERE_PCA:           mesh = "Sphere";        break;
-                    case OBB_PCA: if (hasMdl) { mesh = "OBB " + mdl; }  break;
-                    };
-                    UseShader(Renderable::GetShaderPgm());
-                    Buffer::SetPolygonMode(Buffer::POLYGON_MODE::LINE);
-                    Renderable::GetBuffers()[mesh][0]->BindVAO();
-                    if (hasMdl) // color bv based on type
-                    {
-                        SetUniform(Renderable::GetShaderPgm(), "material.kAmbient", bvColors.at(bv->type));
-                        SetUniform(Renderable::GetShaderPgm(), "material.kDiffuse", bvColors.at(bv->type));
-                    }
-                    else // color bv based on bvh tree level
-                    {
-                        SetUniform(Renderable::GetShaderPgm(), "material.kAmbient", GetColors()[bv->depth]);
-                        SetUniform(Renderable::GetShaderPgm(), "material.kDiffuse", GetColors()[bv->depth]);
-                    }
-                    SetUniform(Renderable::GetShaderPgm(), "material.kSpecular", vec3(1));
-                    SetUniform(Renderable::GetShaderPgm(), "material.shininess", 1.f);
-                    SetUniform(Renderable::GetShaderPgm(), "vertexTransform", bv->modelMat);
-                    Renderable::GetBuffers()[mesh][0]->Draw();
-                    Renderable::GetBuffers()[mesh][0]->UnBindVAO();
-                    Buffer::SetPolygonMode(Buffer::POLYGON_MODE::FILL);
-                    UnUseShader();
-                }
-            });
+                modelMat = modelMat * translate(mat4(1.0f), 0.5f * (lo + hi)) * scale(mat4(1.0f), hi - lo);
+                mdl = "AABB";
+            }
+            // model space error that projects to the pixel error, screen size is the projected diagonal of the bounds
+            float maxLodError = s_IsUsingLods ? s_LodPixelError * length(hi - lo) / _visible.screenSizes[i] : 0.f;
+            RENDER_PASS pass = model.GetIsWireframe() ? PASS_WIREFRAME : PASS_OPAQUE;
 
-        // render mesh 
-        auto viewMesh = ECS.registry().view</*RenderOrder, */Transform, Renderable, Material>();
-        viewMesh.each([](auto _ent,/*RenderOrder& _renderOrder,*/ Transform& _xform, Renderable& _model, Material& _mat)
+            for (auto& mesh : Renderable::GetBuffers()[mdl])
             {
-                if (!_model.GetIsHidden()) 
+                uint32_t lod = mesh->SelectLod(maxLodError);
+                if (mesh->GetPrimitiveType() == Buffer::TRIANGLES)
                 {
-                if (_model.GetIsWireframe()) { Buffer::SetPolygonMode(Buffer::POLYGON_MODE::LINE); }
-
-                //if (_model.GetMeshType() == "Point3D") { Buffer::SetPointSize(length2(_xform.scale)); }
-                std::string mdl = _model.GetMeshType();
-                if (_model.GetMeshType() == "Point3D") { _xform.scale = vec3(0.1f); mdl = "Sphere"; }
-
-                mat4 modelMat = _xform.getMtx();
-                
-                UseShader(Renderable::GetShaderPgm());
-                    for (auto& mesh : Renderable::GetBuffers()[mdl])
-                    {
-                        mesh->BindVAO();
-                        SetUniform(Renderable::GetShaderPgm(), "material.kAmbient",
-                            _xform.hasCollided ? vec3(1.f) - _mat.kAmbient : _mat.kAmbient);
-                        SetUniform(Renderable::GetShaderPgm(), "material.kDiffuse", 
-                            _xform.hasCollided ? vec3(1.f) - _mat.kDiffuse : _mat.kDiffuse);
-                        SetUniform(Renderable::GetShaderPgm(), "material.kSpecular", _mat.kSpecular);
-                        SetUniform(Renderable::GetShaderPgm(), "material.shininess", _mat.shininess);
-                        SetUniform(Renderable::GetShaderPgm(), "vertexTransform", modelMat);
-                        mesh->Draw();
-                        mesh->UnBindVAO();
-                    }
-                UnUseShader();
-
-                if (_model.GetIsWireframe()) { Buffer::SetPolygonMode(Buffer::POLYGON_MODE::FILL); }
+                    _visible.numTriangles += mesh->GetLods()[lod].count / 3;
+                    _visible.numFullTriangles += mesh->GetLods()[0].count / 3;
                 }
-            });
-
+                push(pass, mesh.get(), lod, modelMat, meshMaterials + static_cast<uint32_t>(i), depth);
+            }
+        }
 
+        // hlod proxies, already in world space
+        _visible.numProxyTriangles = 0;
+        for (size_t i = 0; i < _visible.proxies.size(); ++i)
+        {
+            HlodProxy const& proxy = Hlod::GetProxies()[_visible.proxies[i]];
+            push(PASS_OPAQUE, proxy.buffer.get(), 0, mat4(1.f), proxyMaterials + static_cast<uint32_t>(i), getDepth(proxy.center));
+            _visible.numProxyTriangles += proxy.buffer->GetLods()[0].count / 3;
+        }
 
+        m_Queue.Sort();
+        RenderQueue::Stats stats = m_Queue.Submit(s_IsBatching, m_VertexTransformLoc, m_MaterialIdxLoc, m_IsInstancedLoc, s_Stream);
+        _visible.numDrawCalls = stats.numDrawCalls;
+        _visible.numStateChanges = stats.numStateChanges;
 
         // unbind fbo
         _fb.UnBindFBO();
     });
+    s_Stream.EndFrame();
 }
 
 void Render::CleanUp()
 {
     DeleteShader(Renderable::GetShaderPgm());
+
+    // meshes are freed while the context is alive, before the arena they are in
+    Hlod::Release();
+    Renderable::GetBuffers().clear();
+    MESH_ARENA.Release();
+    s_Stream.Release();
 }
\ No newline at end of file